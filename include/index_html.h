@@ -0,0 +1,264 @@
+// Сгенерировано tools/embed_web.py из web/index.html — не править
+// исходник 14237 Б, минифицирован 11937 Б, gzip 4075 Б
+#pragma once
+#include <Arduino.h>
+
+const char INDEX_HTML_ETAG[] = "\"b314d9e60ded05e7\"";
+const size_t INDEX_HTML_GZ_LEN = 4075;
+const uint8_t INDEX_HTML_GZ[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xad, 0x5a, 0xeb, 0x72, 0xdb, 0xc6,
+  0x15, 0xfe, 0xaf, 0xa7, 0x58, 0x33, 0x49, 0x09, 0xd4, 0x24, 0x04, 0x52, 0x96, 0x2a, 0x91, 0xa2,
+  0x3c, 0xf1, 0xad, 0x76, 0x27, 0xbe, 0x4c, 0xe5, 0x38, 0xd3, 0x71, 0x3d, 0xe3, 0x25, 0xb1, 0x20,
+  0x61, 0x83, 0x00, 0x07, 0x58, 0x4a, 0x72, 0x14, 0xcd, 0xd8, 0x4e, 0x2f, 0x3f, 0x9a, 0xa9, 0x13,
+  0xc7, 0x6e, 0x1d, 0xdb, 0xf1, 0x2d, 0x9d, 0x26, 0x33, 0x4d, 0xa7, 0x6a, 0x12, 0xd7, 0xae, 0x13,
+  0x3b, 0x33, 0x79, 0x02, 0xf0, 0x4d, 0xf2, 0x08, 0x3d, 0x67, 0x77, 0x01, 0x02, 0x24, 0x48, 0xc9,
+  0x6e, 0xc6, 0x89, 0x48, 0x2e, 0x76, 0xcf, 0xf9, 0xce, 0xfd, 0x9c, 0x25, 0x97, 0xf7, 0x1c, 0x3a,
+  0x79, 0xf0, 0xf4, 0x6f, 0x4e, 0x1d, 0x26, 0x1d, 0xde, 0x75, 0x57, 0x66, 0x96, 0xf1, 0x85, 0xb8,
+  0xd4, 0x6b, 0x37, 0x0a, 0x41, 0xbf, 0x80, 0x0b, 0x8c, 0x5a, 0xf0, 0xd2, 0x65, 0x9c, 0x92, 0x56,
+  0x87, 0x06, 0x21, 0xe3, 0x8d, 0xc2, 0xdb, 0xa7, 0x8f, 0x94, 0x17, 0x0b, 0xf1, 0xb2, 0x47, 0xbb,
+  0xac, 0x51, 0x58, 0x73, 0xd8, 0x7a, 0xcf, 0x0f, 0x78, 0x81, 0xb4, 0x7c, 0x8f, 0x33, 0x0f, 0xb6,
+  0xad, 0x3b, 0x16, 0xef, 0x34, 0x2c, 0xb6, 0xe6, 0xb4, 0x58, 0x59, 0x7c, 0x28, 0x11, 0xc7, 0x73,
+  0xb8, 0x43, 0xdd, 0x72, 0xd8, 0xa2, 0x2e, 0x6b, 0x54, 0x0c, 0x13, 0xc9, 0x70, 0x87, 0xbb, 0x6c,
+  0x65, 0xd5, 0x77, 0x69, 0x40, 0x4e, 0x07, 0xb4, 0x75, 0x91, 0x05, 0xe4, 0xe4, 0xea, 0xf2, 0xac,
+  0x5c, 0x9f, 0x59, 0x0e, 0xf9, 0x25, 0x7c, 0xad, 0x05, 0xbe, 0xcf, 0xc9, 0xe6, 0x4c, 0xb9, 0xdc,
+  0x6c, 0xd7, 0xc8, 0x6b, 0xa6, 0x5d, 0xf9, 0x45, 0x95, 0xd6, 0x49, 0xb9, 0xdc, 0xa2, 0x81, 0x05,
+  0x0b, 0x15, 0x56, 0x5d, 0x9a, 0x6b, 0xe2, 0x02, 0x67, 0x1b, 0x1c, 0x16, 0xec, 0x45, 0x9b, 0xda,
+  0xad, 0x3a, 0x1c, 0xa0, 0xad, 0x16, 0x40, 0xc2, 0x3d, 0x66, 0x73, 0x69, 0xb1, 0x82, 0x7b, 0xe4,
+  0x52, 0xb9, 0xe3, 0xaf, 0xb1, 0x00, 0xa9, 0xcd, 0x2f, 0x2d, 0x2c, 0x2c, 0xe1, 0x83, 0xa6, 0xdb,
+  0x67, 0xb0, 0x30, 0xd7, 0x5c, 0xac, 0xda, 0x0b, 0xb8, 0xe0, 0x39, 0xed, 0x0e, 0x9e, 0x5d, 0x6c,
+  0xce, 0xb7, 0xe4, 0x8a, 0xc5, 0xba, 0x3e, 0xd2, 0x9f, 0x5f, 0x62, 0x66, 0xb3, 0x3e, 0xb3, 0x35,
+  0xd3, 0xf4, 0xad, 0x4b, 0x64, 0x93, 0xd8, 0x20, 0x7a, 0xd9, 0xa6, 0x5d, 0xc7, 0xbd, 0x54, 0x23,
+  0xc5, 0x55, 0xd6, 0xf6, 0x19, 0x79, 0xfb, 0x58, 0xb1, 0x44, 0xc2, 0x4b, 0x21, 0x67, 0xdd, 0x72,
+  0xdf, 0x81, 0xb7, 0xd4, 0x0b, 0xcb, 0x21, 0x0b, 0x1c, 0xbb, 0x4e, 0x9a, 0x20, 0x6b, 0x3b, 0xf0,
+  0xfb, 0x1e, 0xc0, 0x5f, 0xa3, 0x81, 0x86, 0x92, 0xe9, 0x75, 0xd0, 0xa0, 0xeb, 0x07, 0xf1, 0x0a,
+  0xca, 0x02, 0x6b, 0x5d, 0x1a, 0xb4, 0x1d, 0xaf, 0x46, 0xcc, 0x3a, 0xe9, 0x51, 0xcb, 0x72, 0x3c,
+  0x50, 0x41, 0x65, 0xbe, 0xb7, 0x51, 0x27, 0x5b, 0x33, 0x9d, 0x6a, 0x89, 0x74, 0xe6, 0x80, 0xbf,
+  0xdc, 0x54, 0xe6, 0x7e, 0x4f, 0x6c, 0x54, 0x74, 0x5e, 0x5b, 0xda, 0x47, 0x41, 0x9a, 0xba, 0x84,
+  0xb7, 0xce, 0xa4, 0x38, 0xf3, 0xa6, 0xa9, 0x56, 0x42, 0xe7, 0x5d, 0x10, 0xb8, 0x12, 0xb0, 0x6e,
+  0x9d, 0x20, 0xb7, 0x32, 0x0f, 0x00, 0xa3, 0xed, 0x07, 0xdd, 0x1a, 0xe9, 0xf7, 0x7a, 0x2c, 0x68,
+  0xd1, 0x90, 0xd5, 0x89, 0xcb, 0x38, 0x67, 0x41, 0x39, 0xec, 0xd1, 0x96, 0xe4, 0x8e, 0xcc, 0x9b,
+  0x7e, 0x60, 0xc1, 0x62, 0xd3, 0xe7, 0xdc, 0xef, 0x8a, 0x35, 0x12, 0xfa, 0xae, 0x63, 0x81, 0xfe,
+  0xe6, 0xf6, 0x55, 0xe6, 0xe7, 0x13, 0xb4, 0xc9, 0x96, 0x45, 0x89, 0xd9, 0xf0, 0xe8, 0x1a, 0x20,
+  0xb6, 0x9c, 0xb0, 0xe7, 0x52, 0xd0, 0x96, 0xed, 0x32, 0x58, 0x6f, 0x53, 0x40, 0x5e, 0x31, 0x71,
+  0x8b, 0x92, 0x25, 0x3e, 0x56, 0x55, 0x8b, 0x1b, 0xd2, 0x93, 0x80, 0x8e, 0x99, 0xde, 0xe6, 0x32,
+  0x1b, 0x64, 0xa2, 0x7d, 0xee, 0x27, 0x4b, 0x81, 0x94, 0x53, 0xae, 0x29, 0x86, 0xcd, 0x3e, 0x50,
+  0xf3, 0xd0, 0x52, 0xc0, 0x0e, 0x38, 0x8d, 0x29, 0x73, 0xdc, 0x22, 0xe8, 0x5c, 0xfa, 0xb8, 0x2e,
+  0xa5, 0xe0, 0x80, 0x2b, 0x91, 0x58, 0x68, 0xad, 0x47, 0x03, 0xf0, 0xaa, 0x44, 0x2f, 0x01, 0xb5,
+  0x9c, 0x7e, 0x18, 0x8b, 0x94, 0xd1, 0x7f, 0xd3, 0x77, 0x2d, 0x20, 0xdb, 0x0f, 0x42, 0xa4, 0xdb,
+  0xf3, 0x1d, 0x88, 0x9a, 0xa0, 0x2e, 0xa9, 0x40, 0x8c, 0xf8, 0x68, 0x6b, 0x63, 0x2e, 0xcc, 0xb1,
+  0x51, 0x46, 0x16, 0x83, 0xb6, 0xb8, 0xb3, 0xc6, 0x40, 0xa4, 0x34, 0xf4, 0xd7, 0xcc, 0x85, 0x7d,
+  0x0c, 0x63, 0x21, 0xe3, 0x4a, 0xd2, 0xe5, 0xf5, 0x04, 0x5d, 0xfe, 0x43, 0x20, 0xdf, 0x0e, 0x40,
+  0x9e, 0x94, 0x71, 0xf0, 0x73, 0x5d, 0xfc, 0x05, 0x77, 0xec, 0xc2, 0x1a, 0x67, 0x78, 0xb8, 0xdf,
+  0xf5, 0x40, 0xb6, 0x80, 0xf5, 0x18, 0xe5, 0x1a, 0xea, 0xb9, 0x6c, 0x3b, 0xbc, 0x44, 0xba, 0x8e,
+  0x07, 0x76, 0xd2, 0xaa, 0x8b, 0x20, 0x74, 0x89, 0x54, 0xec, 0x40, 0xd7, 0x63, 0xcb, 0xce, 0x4f,
+  0x33, 0x22, 0x08, 0x3c, 0xb4, 0x16, 0xaa, 0x7d, 0x44, 0xa8, 0x8c, 0x3d, 0x12, 0xbb, 0x49, 0xc7,
+  0x18, 0xd5, 0x77, 0x55, 0x2e, 0x6e, 0x94, 0xc3, 0x0e, 0xb5, 0xfc, 0x75, 0x24, 0x8d, 0x36, 0x10,
+  0x08, 0x48, 0x79, 0x0e, 0xfe, 0x04, 0xed, 0x26, 0xd5, 0xcc, 0x92, 0xf8, 0x67, 0xcc, 0xeb, 0x09,
+  0xd3, 0xb2, 0xdd, 0x77, 0x5d, 0xe0, 0x2c, 0xa4, 0x95, 0x42, 0x02, 0x3d, 0x32, 0x4b, 0xca, 0x15,
+  0xb1, 0x27, 0xe4, 0x94, 0x97, 0x03, 0x7f, 0x7d, 0xdc, 0x79, 0x2f, 0xf4, 0x43, 0xee, 0xd8, 0x97,
+  0xca, 0x2a, 0x01, 0xd6, 0x08, 0x86, 0x0a, 0x2b, 0x37, 0x19, 0x5f, 0x67, 0xcc, 0x1b, 0xf3, 0x68,
+  0x89, 0x31, 0x6d, 0x5d, 0x23, 0xb1, 0xaf, 0x60, 0xb2, 0x46, 0xdd, 0x38, 0xa7, 0xc4, 0x4e, 0xb3,
+  0x60, 0x9a, 0x23, 0x36, 0xc5, 0x6c, 0x25, 0xc1, 0xaf, 0xf9, 0x2e, 0x07, 0xe2, 0x1b, 0x70, 0x46,
+  0x44, 0x31, 0x75, 0x9d, 0x36, 0x40, 0x47, 0xab, 0xa2, 0x63, 0x0d, 0x1d, 0x1d, 0xf5, 0x60, 0x0e,
+  0x8f, 0xa4, 0xd8, 0x48, 0x1c, 0xfb, 0x04, 0x8a, 0x0c, 0xdf, 0xc5, 0x31, 0xbe, 0x89, 0xbb, 0x08,
+  0x5e, 0x43, 0x2d, 0x9b, 0xc2, 0x20, 0x52, 0xbb, 0x95, 0x85, 0x52, 0x65, 0x71, 0xbe, 0x54, 0xa9,
+  0x2e, 0x81, 0x8a, 0xf7, 0xc1, 0x5e, 0xd7, 0xf1, 0x58, 0xb9, 0xa3, 0x68, 0x56, 0x86, 0x10, 0x5c,
+  0xda, 0x64, 0x23, 0x20, 0x2a, 0x46, 0x55, 0xc0, 0x18, 0x8d, 0xbb, 0x74, 0x8a, 0x53, 0xe9, 0xcf,
+  0x68, 0x72, 0xaf, 0x8c, 0x4e, 0xd2, 0x1b, 0xb7, 0x09, 0xfe, 0x2d, 0x5b, 0x4e, 0xc0, 0x5a, 0x32,
+  0xa4, 0xa4, 0x41, 0x33, 0x89, 0x06, 0xb2, 0xf7, 0x30, 0x92, 0x7c, 0xb0, 0x0f, 0xc7, 0x04, 0x31,
+  0x54, 0x57, 0x75, 0xe8, 0x5f, 0x35, 0xe2, 0xf9, 0x1e, 0x1b, 0xf3, 0xb6, 0xc5, 0xd1, 0xcc, 0x91,
+  0x24, 0x3f, 0x85, 0x7e, 0xbd, 0xe3, 0x70, 0xf6, 0x2a, 0xf1, 0x5f, 0x0d, 0x73, 0xf1, 0xe5, 0x07,
+  0xfd, 0x88, 0x43, 0xa8, 0x53, 0x21, 0x5d, 0x63, 0x4a, 0xa6, 0xf1, 0xcd, 0x89, 0x15, 0x63, 0x35,
+  0x9b, 0x68, 0x68, 0x15, 0x9c, 0x15, 0xd3, 0x7c, 0x63, 0x2c, 0x41, 0xe6, 0xf8, 0x6b, 0xda, 0x24,
+  0x23, 0x2a, 0x8d, 0x99, 0xd7, 0x44, 0x99, 0x9d, 0x02, 0x41, 0xd6, 0x61, 0x81, 0x3b, 0x76, 0x86,
+  0xc4, 0x92, 0x4d, 0xd7, 0x6f, 0x5d, 0x1c, 0x0b, 0x1f, 0x81, 0x26, 0x86, 0xdd, 0x6a, 0x5a, 0xf3,
+  0xac, 0x92, 0x41, 0x67, 0x1a, 0x4b, 0x2a, 0x9a, 0x1c, 0xaf, 0xd7, 0x87, 0xb4, 0x14, 0x32, 0x17,
+  0xbc, 0x00, 0x08, 0x4f, 0x10, 0xaf, 0x9a, 0x53, 0x75, 0xc6, 0x8b, 0x42, 0xd2, 0x76, 0xc4, 0x1e,
+  0x91, 0x53, 0xf2, 0xb2, 0x56, 0xcf, 0x75, 0x16, 0xcc, 0x4c, 0xce, 0xbb, 0x82, 0x71, 0x52, 0x42,
+  0x37, 0x12, 0xb0, 0x35, 0xdb, 0x6f, 0xf5, 0x43, 0x80, 0xea, 0xf7, 0x39, 0xc6, 0xcc, 0x88, 0xdf,
+  0xe5, 0x27, 0x00, 0x71, 0xf2, 0x2c, 0xbf, 0xd4, 0x63, 0x0d, 0xf0, 0xa1, 0x36, 0x3b, 0x07, 0xe7,
+  0xc1, 0xdb, 0x9a, 0x17, 0x1d, 0xc8, 0x05, 0x50, 0xc6, 0x29, 0xac, 0xb6, 0x86, 0xa4, 0xf2, 0x64,
+  0x4a, 0x42, 0x33, 0x2f, 0xa7, 0x0a, 0x55, 0xe4, 0x02, 0xca, 0x55, 0x42, 0x0e, 0xa0, 0x5a, 0x2d,
+  0xc6, 0x13, 0xc2, 0x56, 0x20, 0xcd, 0x3b, 0xfd, 0x6e, 0x73, 0x2a, 0x4c, 0x65, 0xab, 0xea, 0x3e,
+  0x64, 0x1e, 0xc3, 0x93, 0x9f, 0x46, 0xe1, 0xa1, 0x35, 0x27, 0x86, 0xc3, 0x58, 0x9c, 0x41, 0xda,
+  0x10, 0xb9, 0x21, 0x37, 0x93, 0x67, 0xb2, 0xc3, 0x70, 0xdf, 0x0a, 0xec, 0x5b, 0x4b, 0x37, 0x0f,
+  0xe9, 0x87, 0x49, 0x6b, 0x91, 0xeb, 0x42, 0x5b, 0x33, 0xcb, 0xb3, 0xaa, 0x8d, 0x5d, 0x9e, 0x55,
+  0x4d, 0x35, 0x36, 0x8d, 0xf0, 0x82, 0x34, 0x5b, 0x2e, 0x0d, 0xc3, 0x46, 0x01, 0xca, 0x3a, 0xf6,
+  0xc3, 0x8a, 0x94, 0x63, 0x35, 0x0a, 0x9c, 0x36, 0xcb, 0x16, 0x0d, 0x3b, 0x85, 0x78, 0x8b, 0x8c,
+  0xfc, 0x02, 0xf1, 0xbd, 0x96, 0xeb, 0xb4, 0x2e, 0x36, 0x0a, 0xe1, 0xba, 0xc3, 0x5b, 0x9d, 0xd3,
+  0xb4, 0xa9, 0x15, 0x71, 0x63, 0x51, 0x2f, 0xac, 0x44, 0x37, 0xa2, 0x0f, 0xa3, 0x2f, 0xa2, 0x8f,
+  0xa2, 0x7b, 0xd1, 0x83, 0xe8, 0xc6, 0xf2, 0xac, 0xa4, 0x37, 0x4e, 0x18, 0x9a, 0xf9, 0x7e, 0x2f,
+  0x9f, 0x94, 0x78, 0x24, 0x68, 0x7d, 0x0a, 0xb4, 0x1e, 0x46, 0x8f, 0x80, 0xd2, 0xbd, 0xe8, 0x93,
+  0xe8, 0x76, 0x74, 0x2b, 0x45, 0x6f, 0x16, 0xb0, 0x2b, 0x09, 0x90, 0x26, 0xce, 0x00, 0x59, 0xb4,
+  0x58, 0x44, 0x0b, 0x59, 0x19, 0x45, 0x61, 0x1f, 0x16, 0xda, 0xb8, 0x6a, 0x89, 0x61, 0xa3, 0xba,
+  0x12, 0x7d, 0x1c, 0xdd, 0x04, 0x96, 0x37, 0x81, 0xdd, 0x87, 0xd1, 0xdf, 0xa3, 0x5b, 0xd1, 0xbf,
+  0x48, 0x74, 0x1f, 0xde, 0xe2, 0xd2, 0x1d, 0xe4, 0x0d, 0x7b, 0x32, 0xe4, 0xe2, 0x12, 0x56, 0x58,
+  0x59, 0x86, 0x72, 0x2b, 0x65, 0xc3, 0xb5, 0xb0, 0xb0, 0x62, 0x1a, 0xa6, 0x09, 0x5a, 0x87, 0xd5,
+  0x95, 0x34, 0xd2, 0xf4, 0x41, 0x91, 0x6b, 0x40, 0xc8, 0xeb, 0x20, 0xdc, 0x9d, 0xe8, 0xcb, 0xe8,
+  0x11, 0xd1, 0xce, 0xe8, 0xf1, 0xe6, 0xf1, 0x33, 0x08, 0x3b, 0x06, 0x7a, 0x0b, 0x30, 0xfd, 0x4d,
+  0x68, 0xf8, 0x6e, 0x0c, 0x75, 0x1c, 0x5d, 0xdc, 0x2c, 0x28, 0x74, 0xc0, 0x68, 0x70, 0x39, 0x7a,
+  0x1c, 0x7d, 0x37, 0xb8, 0x56, 0x53, 0xc8, 0x88, 0x84, 0x9d, 0xde, 0x8f, 0xd2, 0x48, 0x1b, 0x39,
+  0x5d, 0x56, 0x58, 0x29, 0x97, 0x6b, 0xe2, 0xbf, 0xc9, 0xa2, 0x8c, 0x71, 0x79, 0x18, 0xbd, 0x88,
+  0xbe, 0x8d, 0x9e, 0x0f, 0xfe, 0x10, 0x3d, 0x26, 0x00, 0xee, 0x49, 0xf4, 0x14, 0x58, 0xbe, 0x3f,
+  0xb8, 0xba, 0x1b, 0xa6, 0x61, 0xdf, 0x7b, 0xf3, 0x5d, 0xe4, 0xfa, 0xc3, 0xf6, 0xab, 0x72, 0xbc,
+  0x3e, 0xf8, 0xd3, 0xe0, 0x4a, 0xf4, 0x62, 0x70, 0x35, 0xda, 0xde, 0x2d, 0x47, 0x97, 0xbf, 0x34,
+  0xcb, 0xbb, 0xd1, 0xe3, 0xc1, 0xef, 0xa3, 0xed, 0xe8, 0x39, 0x48, 0xf7, 0x2c, 0xda, 0x26, 0xe0,
+  0x3a, 0x2f, 0x06, 0x97, 0x77, 0xc3, 0x10, 0x92, 0xc1, 0x51, 0x3f, 0xf8, 0xff, 0x19, 0x5e, 0x87,
+  0x85, 0xdd, 0x32, 0x3c, 0xc3, 0xf2, 0x19, 0x4e, 0x77, 0xb2, 0x07, 0xe0, 0xf6, 0x7f, 0x01, 0xd7,
+  0xba, 0x4b, 0x44, 0x40, 0x60, 0x44, 0x3f, 0x8a, 0xfe, 0x31, 0xee, 0x67, 0x49, 0x07, 0x34, 0x92,
+  0x3e, 0x60, 0xdd, 0xcc, 0xa4, 0x0e, 0xd9, 0x3f, 0xa4, 0x63, 0x9e, 0xf1, 0xe3, 0xbe, 0xc5, 0x34,
+  0x13, 0x63, 0xfd, 0x43, 0x10, 0xe9, 0x51, 0x74, 0x8f, 0x68, 0x60, 0xcf, 0x3b, 0x82, 0x35, 0x06,
+  0xe3, 0xad, 0xe8, 0xa6, 0x9e, 0x9f, 0x44, 0x80, 0xd4, 0xdc, 0xee, 0xc8, 0xcf, 0x01, 0xf9, 0x1f,
+  0xef, 0xdf, 0xbe, 0x4c, 0x20, 0x37, 0xdd, 0x04, 0x4d, 0xde, 0xc3, 0x37, 0x77, 0x64, 0x74, 0xa3,
+  0x90, 0x7f, 0x15, 0x9c, 0x1e, 0xa9, 0x48, 0xba, 0x35, 0x91, 0x5d, 0x65, 0x77, 0xec, 0x2a, 0x28,
+  0xcd, 0x83, 0xe8, 0xb3, 0xe8, 0x73, 0xa0, 0x0a, 0x79, 0x8b, 0x0c, 0x35, 0x39, 0x91, 0x74, 0x75,
+  0x77, 0xa4, 0xab, 0x48, 0xfa, 0x36, 0x00, 0x85, 0x74, 0x04, 0x06, 0xc1, 0xb4, 0x78, 0x1d, 0x3f,
+  0x13, 0x6d, 0xc9, 0xfc, 0x61, 0x5b, 0x9f, 0x9c, 0x1d, 0xbb, 0xd4, 0xeb, 0x53, 0xf7, 0x14, 0xf5,
+  0x20, 0xe3, 0x10, 0x51, 0x0b, 0x1a, 0x85, 0xb8, 0xee, 0xc8, 0x62, 0x97, 0x6a, 0xa4, 0xc4, 0x54,
+  0x83, 0xc6, 0x14, 0x19, 0x6a, 0x45, 0xfa, 0x36, 0xf8, 0xdd, 0x13, 0x88, 0xb3, 0xe7, 0x83, 0xab,
+  0x60, 0xa1, 0x54, 0x58, 0xeb, 0x35, 0x92, 0x4a, 0x7e, 0x47, 0x13, 0xea, 0xb2, 0x4f, 0xc8, 0x74,
+  0x7a, 0x85, 0x95, 0xa5, 0x38, 0x27, 0xa2, 0x2b, 0x4a, 0xea, 0x33, 0xcb, 0xa2, 0x54, 0x13, 0x51,
+  0xaa, 0x0b, 0xa2, 0x56, 0xab, 0xc8, 0x74, 0x81, 0x18, 0x8c, 0x73, 0x8d, 0x02, 0x78, 0x11, 0x8c,
+  0x6d, 0x8d, 0x42, 0x65, 0xd1, 0x44, 0x9d, 0x88, 0xfd, 0x00, 0x1f, 0xda, 0x94, 0x2e, 0x90, 0x35,
+  0xda, 0x8c, 0x1f, 0x76, 0x19, 0xbe, 0x3d, 0x70, 0xe9, 0x98, 0xa5, 0x15, 0xd7, 0x8e, 0x16, 0x75,
+  0xc3, 0xf1, 0x3c, 0x16, 0x9c, 0x86, 0xf1, 0xa0, 0xc1, 0x3b, 0x4e, 0x68, 0x40, 0x34, 0xf4, 0x65,
+  0xe1, 0xea, 0x20, 0x07, 0xd4, 0xa8, 0x67, 0x1d, 0x17, 0x4a, 0xd1, 0xf4, 0x94, 0xa8, 0x22, 0xaa,
+  0x20, 0x77, 0x88, 0x20, 0x8b, 0xbe, 0x1d, 0x7c, 0x00, 0xc2, 0x7e, 0x0a, 0xef, 0x9e, 0x41, 0x82,
+  0x01, 0xe1, 0xb3, 0xc2, 0x9e, 0xf9, 0x29, 0x85, 0x3d, 0x33, 0x22, 0xec, 0xd2, 0xee, 0x64, 0x3d,
+  0xf3, 0x0a, 0xb2, 0x66, 0xa3, 0x3f, 0xaf, 0x8e, 0xaa, 0xe2, 0x9c, 0x2e, 0xa4, 0xb9, 0x5e, 0x33,
+  0xb5, 0xbc, 0xc6, 0x79, 0xe4, 0x36, 0x78, 0x29, 0x96, 0xab, 0x5b, 0xe0, 0x48, 0x9f, 0xa5, 0x6b,
+  0xeb, 0x43, 0x78, 0xc1, 0xea, 0x8e, 0x31, 0x19, 0xe7, 0x15, 0xbc, 0xf9, 0x91, 0x69, 0xcb, 0x6e,
+  0x1f, 0x81, 0xf7, 0x28, 0x47, 0xd8, 0x6f, 0x76, 0x1d, 0xd0, 0x02, 0x36, 0xf4, 0x07, 0xed, 0xb6,
+  0xc6, 0xd6, 0xa4, 0x82, 0x33, 0xbc, 0xe3, 0x5e, 0x48, 0x2d, 0xaf, 0xc4, 0x16, 0xfd, 0x22, 0x7a,
+  0x0a, 0xce, 0x2b, 0xea, 0x01, 0xd1, 0xde, 0xa2, 0x5c, 0x8f, 0x6d, 0x91, 0x31, 0x05, 0x0e, 0x92,
+  0xd2, 0x12, 0x2e, 0x85, 0x6a, 0x90, 0x52, 0x4a, 0x42, 0xe8, 0x86, 0xa8, 0x32, 0x5f, 0x27, 0xa4,
+  0x7c, 0x6f, 0x47, 0x52, 0xbe, 0x97, 0x4b, 0xea, 0x97, 0xc7, 0x4f, 0x83, 0x5b, 0xdd, 0x07, 0x4a,
+  0xd7, 0x06, 0x57, 0xf2, 0x89, 0x78, 0xd0, 0x9b, 0x42, 0xd2, 0x16, 0x64, 0xda, 0xdd, 0x14, 0xa2,
+  0xf1, 0x94, 0x3d, 0x49, 0xf0, 0xbb, 0xe0, 0xc4, 0xcf, 0x0d, 0x92, 0x76, 0xdf, 0x1d, 0x59, 0xc1,
+  0x18, 0x74, 0xdc, 0xc9, 0x07, 0x0d, 0xf4, 0x80, 0xce, 0xe0, 0xca, 0x2b, 0x50, 0xa4, 0x1b, 0xaf,
+  0x82, 0xff, 0xde, 0xe0, 0x77, 0xf0, 0xef, 0x0a, 0x04, 0xe4, 0xd5, 0x4c, 0x1f, 0xb1, 0x23, 0xcb,
+  0xce, 0x49, 0xdb, 0xce, 0x17, 0x21, 0x43, 0xf2, 0xa5, 0xa4, 0xc8, 0x90, 0x54, 0x2f, 0xf2, 0xcc,
+  0x3b, 0xce, 0x11, 0x87, 0x80, 0x23, 0x43, 0x5b, 0x45, 0xb4, 0xd5, 0xd5, 0x63, 0x87, 0xf4, 0x61,
+  0xb0, 0x4f, 0x90, 0x32, 0xdf, 0x5b, 0xc2, 0x10, 0xa3, 0x0c, 0x62, 0xab, 0xc5, 0x3a, 0x30, 0x9e,
+  0xb3, 0xa0, 0x51, 0x10, 0x18, 0x9f, 0x44, 0x5f, 0xa9, 0xba, 0xff, 0x98, 0x48, 0xec, 0xd1, 0x53,
+  0xa4, 0xa2, 0x46, 0xca, 0xf8, 0xe8, 0xaa, 0xf8, 0x38, 0x21, 0x4c, 0x53, 0xc9, 0x60, 0x62, 0x2a,
+  0x41, 0x22, 0x90, 0x4c, 0x44, 0xf6, 0x48, 0x25, 0x92, 0x3a, 0xca, 0x2d, 0x79, 0x0d, 0xab, 0x96,
+  0xc4, 0x2e, 0x3f, 0xe4, 0x56, 0x2e, 0x81, 0xaa, 0x45, 0xbd, 0x03, 0xd9, 0x32, 0x06, 0x2b, 0xef,
+  0x38, 0xb6, 0x03, 0x69, 0x28, 0xc6, 0x29, 0x67, 0xac, 0x8a, 0x2a, 0x39, 0x10, 0x14, 0xf7, 0x44,
+  0x52, 0xb8, 0x3d, 0x5e, 0xca, 0xd2, 0xea, 0xbe, 0x1f, 0x6d, 0x63, 0x50, 0x63, 0x82, 0xce, 0x4f,
+  0xad, 0x43, 0xb5, 0xf6, 0x00, 0xdb, 0xa8, 0x5a, 0x3f, 0x82, 0x36, 0xf8, 0x09, 0x11, 0x15, 0xed,
+  0x3b, 0x78, 0xfb, 0x5c, 0xfc, 0xff, 0x34, 0xfa, 0x6f, 0x61, 0x54, 0x42, 0x99, 0x79, 0x72, 0x24,
+  0x24, 0xf1, 0xe5, 0x82, 0xc0, 0xfc, 0x00, 0x6b, 0xbb, 0x6a, 0x57, 0x1e, 0x45, 0x5f, 0x92, 0xe9,
+  0x73, 0x0b, 0xa6, 0xb8, 0xb1, 0xf4, 0x1b, 0xb6, 0x02, 0xa7, 0x07, 0x1a, 0xb6, 0xfb, 0x9e, 0x60,
+  0x42, 0x86, 0xf3, 0x10, 0x4c, 0x4b, 0x3a, 0xd9, 0x9c, 0x99, 0x5c, 0x03, 0xe2, 0xc9, 0x07, 0xac,
+  0x27, 0xb4, 0x6a, 0x28, 0xe3, 0x93, 0x06, 0xc1, 0xc3, 0xa4, 0xd1, 0x68, 0x10, 0x35, 0x9f, 0x91,
+  0xfd, 0xa4, 0x88, 0xe9, 0xbc, 0x48, 0x6a, 0xa4, 0x88, 0xbe, 0x51, 0xac, 0xef, 0x40, 0x58, 0x0d,
+  0x63, 0x53, 0x28, 0xab, 0x1d, 0x2f, 0x45, 0x3a, 0x1e, 0x2d, 0x81, 0xb0, 0xd0, 0xed, 0x09, 0xda,
+  0x65, 0x13, 0xe0, 0xca, 0xa1, 0x53, 0x50, 0xdd, 0x89, 0x62, 0x8c, 0x35, 0x9f, 0x64, 0x0a, 0x67,
+  0x96, 0xe6, 0xd6, 0x8c, 0xcb, 0x38, 0xc1, 0xae, 0x19, 0x0f, 0x6c, 0x6e, 0xd5, 0xc5, 0xe7, 0x16,
+  0xde, 0xfc, 0x1c, 0xa0, 0x21, 0xae, 0x79, 0x50, 0xce, 0x4a, 0x72, 0xe5, 0x4d, 0x0e, 0x9f, 0xcd,
+  0xfa, 0xd0, 0x50, 0x1c, 0x5c, 0xfb, 0x20, 0x3e, 0xd1, 0xd0, 0x4a, 0x8e, 0x4d, 0xb4, 0xd4, 0xc9,
+  0x86, 0x3c, 0xab, 0x93, 0x00, 0x98, 0x07, 0x9e, 0xa4, 0x1c, 0x22, 0xac, 0xe1, 0xa6, 0xbd, 0xe4,
+  0x38, 0xe5, 0x1d, 0x18, 0xe6, 0x7d, 0x3f, 0xd0, 0xb4, 0x43, 0x80, 0xc2, 0xf0, 0xfc, 0x75, 0xa0,
+  0x56, 0x8e, 0x39, 0xea, 0x64, 0x16, 0x6f, 0x8c, 0x4c, 0x5d, 0x27, 0x6f, 0x90, 0xc5, 0x85, 0x7d,
+  0xa6, 0x29, 0x09, 0xf5, 0x10, 0x1a, 0x69, 0xac, 0x90, 0x55, 0x1e, 0x38, 0x5e, 0x5b, 0xf3, 0x74,
+  0xa3, 0x47, 0xad, 0x55, 0x4e, 0x03, 0xae, 0x55, 0x4b, 0xa4, 0x68, 0x16, 0xf5, 0x69, 0x1a, 0x83,
+  0x09, 0x2f, 0xdd, 0x3d, 0x90, 0xc6, 0x4c, 0x4f, 0x4b, 0x41, 0x09, 0x81, 0xeb, 0xdc, 0x82, 0xe0,
+  0xba, 0x97, 0x14, 0x6b, 0x45, 0xf8, 0x3b, 0xf6, 0x7c, 0xc1, 0x44, 0x48, 0xf8, 0x77, 0xb8, 0x25,
+  0x94, 0x2b, 0xa8, 0xd7, 0x44, 0x49, 0x01, 0xb4, 0x20, 0x2c, 0xd0, 0x2c, 0x54, 0xd1, 0xc9, 0xe6,
+  0x05, 0x48, 0x26, 0x06, 0x98, 0xc8, 0x69, 0x7b, 0x9a, 0x50, 0x7b, 0x89, 0x58, 0xb0, 0x1f, 0x75,
+  0x67, 0x19, 0x08, 0x0b, 0xb7, 0xa1, 0x80, 0xa8, 0x6b, 0xb9, 0x62, 0x80, 0xdf, 0x39, 0x5c, 0x03,
+  0x1e, 0xba, 0xd1, 0xa5, 0x3d, 0xed, 0x84, 0xc8, 0xce, 0x70, 0x28, 0x6d, 0x26, 0x7e, 0xd6, 0x3c,
+  0x47, 0x7e, 0x2e, 0x40, 0x03, 0x12, 0x7e, 0xb6, 0x82, 0x9f, 0x16, 0xe4, 0xfb, 0xea, 0x39, 0xb5,
+  0x57, 0x18, 0x70, 0xa8, 0xe5, 0xfa, 0x4c, 0xca, 0x80, 0x88, 0x19, 0x51, 0x08, 0x50, 0xe2, 0x7a,
+  0x38, 0x24, 0x7b, 0xc0, 0x86, 0x7d, 0x40, 0x6f, 0x3b, 0x1e, 0x03, 0xfc, 0x93, 0xa3, 0x05, 0x77,
+  0x67, 0xf5, 0x49, 0x52, 0x74, 0x0c, 0xee, 0x1f, 0x71, 0x36, 0x98, 0x05, 0x3d, 0x7c, 0x3d, 0xc5,
+  0x43, 0x4c, 0xbc, 0xbb, 0xe6, 0x21, 0x76, 0xe7, 0xf2, 0x10, 0x4f, 0x12, 0x1e, 0x15, 0x61, 0x8f,
+  0x1f, 0xb6, 0x8b, 0xa3, 0xac, 0x5c, 0xfe, 0x52, 0xbc, 0x5c, 0x3e, 0x91, 0x99, 0xcb, 0xf3, 0xb8,
+  0x4d, 0xa4, 0x26, 0xc7, 0xde, 0x5c, 0x6a, 0xf2, 0xd1, 0xae, 0x48, 0xc0, 0x20, 0x3b, 0x89, 0x04,
+  0x3c, 0x4a, 0x48, 0xa0, 0xeb, 0xe0, 0xf4, 0x89, 0xde, 0x33, 0x89, 0x1a, 0x3e, 0x2f, 0x0a, 0x53,
+  0x28, 0xf5, 0x74, 0x61, 0xc0, 0x82, 0x80, 0x25, 0x26, 0x3a, 0x1f, 0x3e, 0xcd, 0xa4, 0x91, 0x62,
+  0x2a, 0xf7, 0xab, 0xec, 0x91, 0x3a, 0xeb, 0x84, 0x27, 0xf0, 0x76, 0x30, 0x39, 0x99, 0x46, 0x58,
+  0xfc, 0xf1, 0xfe, 0x07, 0x9f, 0x10, 0x31, 0x0a, 0x7e, 0x0e, 0xb5, 0x41, 0x8b, 0xfe, 0xa9, 0xee,
+  0x98, 0x3e, 0x86, 0x95, 0x87, 0x50, 0x8b, 0x6e, 0xaa, 0xf9, 0x30, 0x1e, 0x77, 0x81, 0xb0, 0x20,
+  0x22, 0x33, 0xee, 0xf0, 0x56, 0xf1, 0x20, 0x0e, 0x19, 0x48, 0x50, 0xce, 0x19, 0xe2, 0x9b, 0x61,
+  0xdc, 0xbc, 0x45, 0x98, 0x0b, 0xee, 0x9f, 0xc7, 0x7a, 0xca, 0x50, 0xbd, 0x4b, 0x2e, 0xe2, 0x0a,
+  0x53, 0xe4, 0xc8, 0x2c, 0x9b, 0x09, 0xba, 0x89, 0xa9, 0xfe, 0x64, 0x28, 0xd4, 0x95, 0x6e, 0x92,
+  0xa5, 0x71, 0xea, 0xdf, 0xc1, 0xac, 0x73, 0xb9, 0x66, 0x9d, 0x53, 0xc6, 0x99, 0xdb, 0xd9, 0xac,
+  0x62, 0xd7, 0x88, 0x09, 0x33, 0xb7, 0x07, 0xd7, 0xe5, 0xcd, 0xc1, 0x3d, 0x18, 0x64, 0x6e, 0x82,
+  0x48, 0x0f, 0xa3, 0x9b, 0x86, 0x61, 0xc4, 0x07, 0x77, 0x50, 0x28, 0x7e, 0x7d, 0x3f, 0x6a, 0xb5,
+  0xb9, 0xe9, 0xea, 0x9c, 0x0e, 0x66, 0xda, 0x55, 0xc6, 0x8e, 0x98, 0xd2, 0xea, 0x9d, 0xa6, 0xd3,
+  0xca, 0x48, 0x55, 0x4d, 0xeb, 0x0d, 0xb3, 0x7e, 0x4a, 0xd9, 0x8d, 0x46, 0x65, 0xb4, 0xc4, 0x4e,
+  0xab, 0x42, 0x78, 0xf9, 0xf1, 0x32, 0xc4, 0xab, 0x2f, 0x43, 0x3c, 0x75, 0xed, 0x91, 0xd3, 0xc2,
+  0x8c, 0x61, 0x16, 0x5f, 0xf6, 0xa4, 0xfb, 0x17, 0xd5, 0x19, 0x40, 0xaf, 0x67, 0xad, 0x42, 0x7b,
+  0x8c, 0xd8, 0x8a, 0xa9, 0xd2, 0xef, 0xfa, 0x14, 0x54, 0xe9, 0xd9, 0x4e, 0x5b, 0xd4, 0x7e, 0x9b,
+  0x41, 0xc7, 0xa6, 0x15, 0x67, 0x69, 0xcf, 0x99, 0x6d, 0x89, 0x65, 0x60, 0xca, 0x3b, 0xcc, 0xd3,
+  0x82, 0xc6, 0x4a, 0x60, 0x5c, 0x08, 0x7d, 0x4f, 0xd3, 0xd5, 0x8a, 0xd5, 0x58, 0x99, 0xd2, 0xd2,
+  0xc1, 0x10, 0x1a, 0xb7, 0xe2, 0xa2, 0x02, 0xc2, 0xe7, 0xfa, 0x64, 0x9f, 0x87, 0x39, 0x33, 0xbb,
+  0xdb, 0xf7, 0xa6, 0xe8, 0x04, 0xc6, 0xc9, 0xcc, 0x6e, 0xf8, 0x3c, 0x85, 0xb6, 0x9c, 0x08, 0x33,
+  0x07, 0xe4, 0xd2, 0xb4, 0xbe, 0x51, 0xcc, 0x7c, 0x63, 0x67, 0xe8, 0xc6, 0x14, 0x3e, 0x38, 0xb4,
+  0x65, 0x4e, 0xe0, 0xc2, 0x34, 0x1e, 0xa3, 0xfb, 0x71, 0x61, 0x0a, 0xfd, 0xf4, 0x74, 0x23, 0xf6,
+  0xe3, 0x42, 0x7d, 0x26, 0x6d, 0xda, 0x78, 0x4d, 0xb6, 0x21, 0x4e, 0xf8, 0xe6, 0x29, 0x9d, 0x8c,
+  0x7f, 0x2b, 0x01, 0x4e, 0xa1, 0xc7, 0x8e, 0xd1, 0xf3, 0x5d, 0xf7, 0x34, 0x34, 0x27, 0x81, 0x6a,
+  0x11, 0x53, 0xae, 0xd1, 0xef, 0x59, 0xe0, 0x5c, 0xe8, 0x16, 0x24, 0xed, 0x16, 0xe8, 0x72, 0xfd,
+  0x70, 0xb2, 0x5b, 0xc8, 0x3e, 0x49, 0x7c, 0xa5, 0x36, 0x9c, 0x04, 0xb0, 0x9f, 0x3b, 0x05, 0xac,
+  0xb0, 0xc5, 0x8b, 0x7b, 0xcc, 0x84, 0xf5, 0xb0, 0xb5, 0x4c, 0xa3, 0x01, 0xb0, 0xc7, 0xf0, 0xbb,
+  0x26, 0x90, 0x57, 0x93, 0x50, 0x4a, 0xa4, 0x8a, 0x1d, 0x64, 0x7d, 0x26, 0x46, 0x96, 0xe9, 0xcf,
+  0x42, 0xee, 0xf7, 0xa6, 0xb0, 0xd8, 0x84, 0x4e, 0x94, 0xd1, 0x20, 0x21, 0x39, 0x7c, 0x54, 0x1f,
+  0x57, 0x02, 0x60, 0x4f, 0x51, 0x86, 0x40, 0xf0, 0xa0, 0xdd, 0x4b, 0xa8, 0xee, 0x59, 0x77, 0x3c,
+  0xcb, 0x5f, 0x37, 0x0e, 0xe3, 0x25, 0xce, 0xaa, 0xdf, 0x0f, 0x5a, 0xd8, 0xed, 0x8d, 0x08, 0x59,
+  0x8f, 0x85, 0x22, 0x52, 0xd1, 0x0c, 0x5b, 0x66, 0x8f, 0xad, 0x93, 0xd4, 0x29, 0xa5, 0x51, 0x71,
+  0x19, 0x14, 0xa2, 0x5d, 0x58, 0x68, 0xf8, 0x9e, 0xdf, 0x63, 0x9e, 0x08, 0xed, 0x44, 0x1e, 0xf5,
+  0xa0, 0xcb, 0xc2, 0x90, 0xb6, 0xd1, 0xf6, 0x0c, 0x3b, 0x66, 0xd5, 0x90, 0xfe, 0x6a, 0xf5, 0xe4,
+  0x09, 0xe8, 0x99, 0x83, 0x90, 0x69, 0x90, 0x19, 0x28, 0xa7, 0x7a, 0x4c, 0x88, 0x05, 0x81, 0x48,
+  0x91, 0x00, 0x1c, 0xb6, 0x6f, 0x02, 0x04, 0xc8, 0x51, 0x7e, 0x88, 0x8a, 0x1b, 0x03, 0x0b, 0xda,
+  0x46, 0x0d, 0xf8, 0x7d, 0xae, 0x29, 0x71, 0x4b, 0xa2, 0x5f, 0x37, 0xd1, 0x90, 0x59, 0x3d, 0x77,
+  0xfc, 0xf5, 0x13, 0x8c, 0xaf, 0xfb, 0xc1, 0xc5, 0x50, 0x76, 0xc3, 0xf1, 0x40, 0x30, 0xd5, 0x73,
+  0xe5, 0x70, 0x5f, 0xd4, 0x4b, 0x64, 0x0d, 0x85, 0x53, 0x93, 0xb9, 0x38, 0x6b, 0xa7, 0xcf, 0xb6,
+  0x02, 0x06, 0xb6, 0x3d, 0xa4, 0x3e, 0x1e, 0x09, 0x68, 0x1b, 0x5f, 0xd1, 0xd6, 0xb6, 0x81, 0xdf,
+  0x6f, 0x42, 0xe6, 0xef, 0x38, 0xae, 0xa5, 0xa1, 0x2a, 0x4f, 0xf6, 0x10, 0x91, 0x56, 0xc4, 0x6f,
+  0x4c, 0xa2, 0x7f, 0xe3, 0xbd, 0x67, 0xf4, 0x74, 0x70, 0x35, 0xb9, 0x64, 0x18, 0x7c, 0x50, 0x2c,
+  0x61, 0x76, 0xc5, 0xf4, 0x6a, 0x78, 0x0a, 0xb2, 0x01, 0xb3, 0xeb, 0x61, 0x0a, 0xde, 0x2c, 0xa6,
+  0x8e, 0x89, 0x34, 0xcf, 0xbf, 0xbe, 0xe9, 0x89, 0x60, 0xda, 0x22, 0x1a, 0xbe, 0x0d, 0xe0, 0xfd,
+  0x96, 0x75, 0xa0, 0xab, 0xe3, 0x07, 0x61, 0x21, 0x48, 0xb6, 0xe4, 0xc7, 0xfb, 0x37, 0x3e, 0x96,
+  0x29, 0x7c, 0xeb, 0x7c, 0x89, 0xc8, 0x03, 0x3a, 0xf2, 0x0b, 0x8d, 0x80, 0x89, 0x81, 0x5d, 0x10,
+  0x06, 0x4b, 0x69, 0xb6, 0x58, 0x8d, 0x83, 0x77, 0x6d, 0x4a, 0x5e, 0x50, 0x71, 0x3e, 0x9a, 0xea,
+  0x55, 0x42, 0x07, 0xd5, 0x8d, 0x3d, 0x91, 0x49, 0x3f, 0x6b, 0xa5, 0xf8, 0x9e, 0x02, 0x7d, 0x3b,
+  0x36, 0x52, 0x73, 0xaa, 0x91, 0xe4, 0x5d, 0x47, 0x11, 0x7f, 0xdf, 0x34, 0xd2, 0xfc, 0x24, 0x57,
+  0x1a, 0xb2, 0x47, 0xc8, 0x64, 0x03, 0x38, 0x25, 0x0a, 0x1c, 0xf2, 0x41, 0x9d, 0x08, 0x75, 0xec,
+  0x0f, 0x98, 0x1d, 0xb0, 0xb0, 0xd3, 0x80, 0xa2, 0x3b, 0xbd, 0x7e, 0xc8, 0x4c, 0x95, 0x18, 0xc7,
+  0x65, 0x5e, 0x9b, 0x77, 0xf4, 0x51, 0x27, 0x8b, 0x33, 0x9a, 0x1a, 0x70, 0x01, 0x53, 0xd0, 0xf7,
+  0x3c, 0x70, 0x5d, 0x98, 0x85, 0x53, 0x9e, 0x2b, 0x1d, 0x3d, 0x11, 0x9d, 0x07, 0xd0, 0xf8, 0x49,
+  0x37, 0xc6, 0x90, 0xc0, 0x5e, 0x25, 0x2b, 0x59, 0x9a, 0xa0, 0x4d, 0x1d, 0x97, 0xc1, 0xe4, 0xbf,
+  0x5f, 0xc9, 0x2b, 0xda, 0x3d, 0x71, 0x2d, 0xf2, 0x28, 0xfa, 0x52, 0x08, 0x05, 0x1f, 0x3f, 0x12,
+  0x3d, 0xf0, 0x75, 0xb5, 0x18, 0xe7, 0xd1, 0xa1, 0xd2, 0xd5, 0x77, 0x1c, 0xdd, 0xb1, 0x9c, 0x29,
+  0x1f, 0xec, 0x17, 0x85, 0xba, 0xb8, 0xb7, 0xab, 0x34, 0x20, 0xf3, 0xd8, 0x48, 0xaa, 0x4c, 0xdd,
+  0x74, 0x2b, 0xb3, 0x75, 0xa6, 0x9a, 0xcd, 0x3d, 0x1a, 0x17, 0x05, 0xf1, 0x1b, 0x43, 0x11, 0x5e,
+  0x53, 0x76, 0x9f, 0x49, 0x76, 0x2b, 0x3b, 0x9e, 0x4f, 0x10, 0x0a, 0xae, 0xfb, 0x3b, 0x8d, 0xd7,
+  0x37, 0x3b, 0x5b, 0x3f, 0x5b, 0x83, 0x97, 0xb5, 0xad, 0xf3, 0x23, 0x48, 0x33, 0xd2, 0xc6, 0x77,
+  0xd9, 0x88, 0x93, 0x19, 0xbd, 0x40, 0xe4, 0xb1, 0x43, 0xcc, 0xa6, 0x7d, 0x57, 0x04, 0x6c, 0x32,
+  0xdf, 0x43, 0x58, 0xbd, 0xfd, 0xeb, 0xb7, 0x56, 0x21, 0xfd, 0xb6, 0x3a, 0xa7, 0x68, 0x40, 0xbb,
+  0x21, 0x3e, 0x3e, 0x2b, 0x7a, 0x84, 0x92, 0xa8, 0xfd, 0x25, 0x51, 0xd3, 0x4b, 0x71, 0xad, 0x2e,
+  0xc5, 0x05, 0xb8, 0x24, 0xab, 0x6a, 0x49, 0x16, 0xcb, 0x92, 0x8c, 0x8d, 0x73, 0x49, 0x0c, 0x5f,
+  0x44, 0x7b, 0xf7, 0x0c, 0x00, 0xaf, 0x5d, 0x2c, 0x4d, 0x94, 0xfa, 0xa2, 0x92, 0x58, 0x8f, 0x31,
+  0x41, 0x9f, 0x36, 0x4d, 0x49, 0xf8, 0x7c, 0xa8, 0x25, 0x51, 0x47, 0xf0, 0xc4, 0x7b, 0xef, 0x01,
+  0x2b, 0xd8, 0x1b, 0x47, 0x28, 0x8c, 0xa1, 0xc3, 0xbe, 0x4a, 0x57, 0x30, 0xe4, 0xe1, 0x92, 0xe0,
+  0xa1, 0x8f, 0x84, 0x8a, 0xd4, 0xd7, 0xfe, 0xe2, 0xde, 0x1e, 0xcc, 0x9d, 0xea, 0xbe, 0x63, 0x87,
+  0xf0, 0x40, 0xb8, 0xdd, 0xb0, 0x2d, 0x7c, 0x55, 0x5e, 0x7f, 0x5a, 0x2a, 0x46, 0xa4, 0xa3, 0x8a,
+  0x2f, 0xb5, 0x86, 0x17, 0x80, 0x2f, 0x08, 0xa6, 0x41, 0xbc, 0x18, 0xfc, 0x5e, 0x64, 0x43, 0x78,
+  0x1b, 0x6d, 0x47, 0x5f, 0x0f, 0x2e, 0x0f, 0xde, 0x87, 0x77, 0xcf, 0xa2, 0xa7, 0x35, 0xd1, 0x8d,
+  0x0e, 0x69, 0x5d, 0xf0, 0x1d, 0xc8, 0x9f, 0x90, 0x25, 0x75, 0xe1, 0xe1, 0xb7, 0x46, 0xaf, 0x13,
+  0x09, 0xbe, 0x1d, 0x5c, 0x55, 0x43, 0xf8, 0x1e, 0x4b, 0xfc, 0x22, 0x09, 0x84, 0x45, 0x4c, 0x7b,
+  0x21, 0x6a, 0x7e, 0xeb, 0x41, 0x3c, 0x7c, 0x21, 0xbe, 0xc9, 0xc3, 0xef, 0xf0, 0x04, 0xbb, 0xef,
+  0x21, 0x09, 0x5f, 0x89, 0x9e, 0x92, 0xe8, 0x2b, 0xc0, 0x63, 0x43, 0x53, 0xdc, 0xa9, 0x21, 0x9e,
+  0x17, 0xb0, 0xf8, 0x2d, 0x7e, 0xbd, 0x3d, 0x01, 0x1a, 0xee, 0xc7, 0x07, 0xcf, 0xf1, 0x86, 0x7c,
+  0x70, 0x65, 0x70, 0x0d, 0x76, 0x8a, 0x7d, 0xff, 0x51, 0x37, 0xc7, 0xb0, 0xed, 0x79, 0xb4, 0x3d,
+  0xf8, 0xa3, 0xc4, 0x36, 0xb8, 0x56, 0x8c, 0xb3, 0x42, 0xc0, 0x54, 0xc9, 0x4a, 0xe3, 0x7a, 0xc7,
+  0x29, 0xe3, 0x35, 0x6b, 0xcc, 0x0c, 0xf8, 0x47, 0xdf, 0xe0, 0x65, 0xf9, 0xe0, 0xcf, 0x40, 0x61,
+  0x5b, 0x94, 0x07, 0xc1, 0xe3, 0x59, 0x72, 0x23, 0x2d, 0x1b, 0xf5, 0xac, 0x89, 0xc1, 0xe6, 0x45,
+  0x0d, 0x1e, 0xbe, 0x80, 0x43, 0xe2, 0x3b, 0xeb, 0x6f, 0x50, 0x0e, 0x38, 0xfb, 0x3e, 0x50, 0xdc,
+  0xd6, 0xb1, 0x66, 0x53, 0x97, 0x05, 0x5c, 0x03, 0xc6, 0xd3, 0xba, 0xf8, 0xb4, 0x4b, 0xa9, 0x16,
+  0x3c, 0xdd, 0x79, 0x27, 0x1d, 0x59, 0x66, 0x2d, 0xdd, 0x01, 0x25, 0x37, 0x3c, 0x49, 0x3e, 0x4b,
+  0xba, 0x92, 0x3a, 0xfe, 0x36, 0x46, 0xdd, 0xbd, 0x2e, 0xcf, 0xaa, 0x5f, 0xc5, 0xcc, 0x8a, 0x5f,
+  0xa4, 0xff, 0x0f, 0x91, 0x65, 0x4d, 0xcd, 0xa1, 0x2e, 0x00, 0x00,
+};
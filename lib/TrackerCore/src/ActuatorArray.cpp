@@ -0,0 +1,68 @@
+#include "ActuatorArray.h"
+
+int ActuatorArray::addHead(const HeadConfig &h) {
+  if (count + AXIS_COUNT > ACT_MAX_CHANNELS)
+    return -1;
+  int head = heads();
+  int c = count;
+  pin[c + AXIS_HOR] = h.pinHor;
+  pin[c + AXIS_VER] = h.pinVer;
+  offset[c + AXIS_HOR] = degToAngle(h.hOff);
+  offset[c + AXIS_VER] = degToAngle(h.vOff);
+  lo[c + AXIS_HOR] = degToAngle(h.horMin);
+  hi[c + AXIS_HOR] = degToAngle(h.horMax);
+  lo[c + AXIS_VER] = degToAngle(h.verMin);
+  hi[c + AXIS_VER] = degToAngle(h.verMax);
+  curve[c + AXIS_HOR] = h.curveHor ? h.curveHor : &LINEAR_SERVO_CURVE;
+  curve[c + AXIS_VER] = h.curveVer ? h.curveVer : &LINEAR_SERVO_CURVE;
+  for (int i = c; i < c + AXIS_COUNT; ++i) {
+    tgt[i] = -1;
+    us[i] = 0;
+  }
+  count += AXIS_COUNT;
+  return head;
+}
+
+void ActuatorArray::attach() {
+  bank.attach(pin, count);
+  powered = true;
+  // После attach положение серво неизвестно — следующий write() пишет всё
+  for (int i = 0; i < count; ++i)
+    us[i] = 0;
+}
+
+void ActuatorArray::detach() {
+  bank.detach();
+  powered = false;
+}
+
+void ActuatorArray::write(int hor, int ver) {
+  const int base[AXIS_COUNT] = {hor, ver};
+  // Цели всех каналов: общая траектория + поправка, в пределах головы
+  for (int i = 0; i < count; ++i) {
+    int t = base[i % AXIS_COUNT] + offset[i];
+    tgt[i] = t < lo[i] ? lo[i] : (t > hi[i] ? hi[i] : t);
+  }
+
+  uint8_t chans[ACT_MAX_CHANNELS];
+  uint16_t pulses[ACT_MAX_CHANNELS];
+  int n = 0;
+  for (int i = 0; i < count; ++i) {
+    uint16_t p = servoCurveUs(*curve[i], tgt[i]);
+    if (p != us[i]) {
+      us[i] = p;
+      chans[n] = i;
+      pulses[n++] = p;
+    }
+  }
+  if (!n || !powered)
+    return;
+  bank.write(chans, pulses, n);
+  batches++;
+  channelWrites += n;
+}
+
+int ActuatorArray::deadBand() {
+  const int span = SERVO_MAX_US - SERVO_MIN_US;
+  return (deadBandUs * 180 * ANGLE_SCALE + span - 1) / span;
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "MotionPlanner.h"
+#include "TrackerHal.h"
+
+// Несколько голов трекера на одном контроллере.
+// Траектория (Солнце -> углы -> профиль MotionPlanner) считается один раз,
+// а ActuatorArray как HalActuator раздаёт её всем головам: у каждой свои
+// пины, поправки и пределы относительно общей траектории (поправки и
+// пределы из Config действуют на неё целиком). Таблица каналов хранится
+// по полям (struct-of-arrays): write() одним проходом считает цели всех
+// каналов, вторым собирает изменившиеся и отдаёт их банку ШИМ одной
+// пачкой. Канал головы h по оси a — h * AXIS_COUNT + a.
+//
+// Углы — в долях градуса (ANGLE_SCALE), в импульс переводятся по кривой
+// калибровки канала (1 мкс ≈ 0.1°); в банк уходят только изменившиеся
+// импульсы. Зона нечувствительности deadBandUs отдаётся планировщику как
+// deadBand(): в движении он пишет не чаще, чем на зону, остановку — точно.
+
+const int ACT_MAX_HEADS = 8;
+const int ACT_MAX_CHANNELS = ACT_MAX_HEADS * AXIS_COUNT; // 16 — один PCA9685
+
+// Импульс серво для 0..180° (как servo.attach(pin, 500, 2400))
+const uint16_t SERVO_MIN_US = 500;
+const uint16_t SERVO_MAX_US = 2400;
+// Зона нечувствительности в движении по умолчанию: 11 мкс — чуть больше
+// градуса на линейной кривой, так что шаг слежения в 1° уходит одной
+// записью (сразу точной целью), а поворот — записью на градус пути
+const uint16_t ACT_DEAD_BAND_US = 11;
+
+// Кривая калибровки серво: импульс в точках 0, 45, 90, 135 и 180°, между
+// ними — линейно. Снимается по транспортиру: writeMicroseconds() до
+// нужного угла на собранной голове. Импульсы — в SERVO_MIN_US..SERVO_MAX_US
+// (за ними LEDC-серво обрезает)
+const int SERVO_CURVE_POINTS = 5;
+const int SERVO_CURVE_STEP = 180 * ANGLE_SCALE / (SERVO_CURVE_POINTS - 1);
+
+struct ServoCurve {
+  uint16_t us[SERVO_CURVE_POINTS];
+};
+
+const ServoCurve LINEAR_SERVO_CURVE = {{500, 975, 1450, 1925, 2400}};
+
+// Угол (1/ANGLE_SCALE градуса) -> импульс, мкс с округлением
+inline uint16_t servoCurveUs(const ServoCurve &c, int angle) {
+  if (angle <= 0)
+    return c.us[0];
+  if (angle >= 180 * ANGLE_SCALE)
+    return c.us[SERVO_CURVE_POINTS - 1];
+  int i = angle / SERVO_CURVE_STEP;
+  int d = (c.us[i + 1] - c.us[i]) * (angle - i * SERVO_CURVE_STEP);
+  d = (d >= 0 ? d + SERVO_CURVE_STEP / 2 : d - SERVO_CURVE_STEP / 2) /
+      SERVO_CURVE_STEP;
+  return c.us[i] + d;
+}
+
+inline uint16_t servoAngleToUs(int deg) {
+  return servoCurveUs(LINEAR_SERVO_CURVE, degToAngle(deg));
+}
+
+struct HeadConfig {
+  uint8_t pinHor; // GPIO (LEDC) или канал расширителя
+  uint8_t pinVer;
+  int8_t hOff; // поправка к общей траектории, град
+  int8_t vOff;
+  uint8_t horMin; // механические пределы головы, град
+  uint8_t horMax;
+  uint8_t verMin;
+  uint8_t verMax;
+  const ServoCurve *curveHor = &LINEAR_SERVO_CURVE;
+  const ServoCurve *curveVer = &LINEAR_SERVO_CURVE;
+};
+
+class ActuatorArray : public HalActuator {
+public:
+  explicit ActuatorArray(HalPwmBank &bank) : bank(bank) {}
+
+  // Индекс головы; -1 — таблица заполнена. До первого attach()
+  int addHead(const HeadConfig &h);
+  int heads() const { return count / AXIS_COUNT; }
+
+  void attach() override;
+  void detach() override;
+  bool attached() override { return powered; }
+  void write(int hor, int ver) override; // 1/ANGLE_SCALE градуса
+  int deadBand() override; // deadBandUs на линейной кривой, с запасом вверх
+
+  // Цель канала, 1/ANGLE_SCALE градуса, и импульс в банке (0 — неизвестен)
+  int target(int head, int axis) const { return tgt[ch(head, axis)]; }
+  int pulse(int head, int axis) const { return us[ch(head, axis)]; }
+
+  uint16_t deadBandUs = ACT_DEAD_BAND_US; // 0 — каждый шаг профиля
+  long batches = 0; // вызовов bank.write()
+  long channelWrites = 0;
+
+private:
+  static int ch(int head, int axis) { return head * AXIS_COUNT + axis; }
+
+  HalPwmBank &bank;
+  int count = 0; // каналов
+  bool powered = false;
+
+  // Таблица каналов; углы — 1/ANGLE_SCALE градуса
+  uint8_t pin[ACT_MAX_CHANNELS];
+  int16_t offset[ACT_MAX_CHANNELS];
+  int16_t lo[ACT_MAX_CHANNELS];
+  int16_t hi[ACT_MAX_CHANNELS];
+  const ServoCurve *curve[ACT_MAX_CHANNELS];
+  int16_t tgt[ACT_MAX_CHANNELS]; // последняя цель
+  uint16_t us[ACT_MAX_CHANNELS]; // отправлено в банк; 0 — неизвестно
+};
+
+// PCA9685: 16 каналов ШИМ по I2C, 12 бит на период
+const uint8_t PCA9685_ADDR = 0x40;
+const uint8_t PCA9685_MODE1 = 0x00;
+const uint8_t PCA9685_LED0 = 0x06; // ON_L, ON_H, OFF_L, OFF_H на канал
+const uint8_t PCA9685_ALL_OFF_H = 0xFD;
+const uint8_t PCA9685_PRESCALE = 0xFE;
+const uint8_t PCA9685_MODE1_AI = 0x20; // автоинкремент адреса регистра
+const uint8_t PCA9685_MODE1_SLEEP = 0x10;
+const uint8_t PCA9685_MODE1_RESTART = 0x80;
+const uint32_t PCA9685_OSC_HZ = 25000000;
+const uint32_t SERVO_PWM_HZ = 50;
+
+inline uint8_t pca9685Prescale(uint32_t pwmHz) {
+  return (PCA9685_OSC_HZ + 2048 * pwmHz) / (4096 * pwmHz) - 1;
+}
+
+// Длительность импульса -> отсчёт OFF (ON = 0)
+inline uint16_t pca9685Ticks(uint16_t us, uint32_t pwmHz) {
+  return ((uint32_t)us * pwmHz * 4096 + 500000) / 1000000;
+}
@@ -0,0 +1,106 @@
+#include "AdcPipeline.h"
+
+#include <math.h>
+
+AdcPipeline::AdcPipeline(const AdcPipelineConfig &cfg,
+                         const AdcCalibration &cal) {
+  configure(cfg, cal);
+}
+
+void AdcPipeline::configure(const AdcPipelineConfig &c,
+                            const AdcCalibration &k) {
+  cfg = c;
+  if (cfg.oversample == 0)
+    cfg.oversample = 1;
+  cal = k;
+  acc = 0;
+  accCount = 0;
+  medianCount = 0;
+  medianPos = 0;
+  iirReady = false;
+  seq = 0;
+  sum = 0;
+  minHead = minTail = maxHead = maxTail = 0;
+  stats.store(VoltageWindow());
+}
+
+void AdcPipeline::push(const uint16_t *raw, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    acc += raw[i];
+    if (++accCount < cfg.oversample)
+      continue;
+
+    // Среднее группы в отсчётах с дробной частью (x65536 под калибровку)
+    uint64_t avg = ((uint64_t)acc << 16) / accCount;
+    float mv = (float)((avg * cal.coeffA) >> 32) + cal.coeffB;
+    acc = 0;
+    accCount = 0;
+    addValue(filter(mv));
+  }
+}
+
+float AdcPipeline::filter(float mv) {
+  if (cfg.filter == ADC_FILTER_IIR) {
+    iir = iirReady ? iir + cfg.iirAlpha * (mv - iir) : mv;
+    iirReady = true;
+    return iir;
+  }
+  if (cfg.filter == ADC_FILTER_MEDIAN) {
+    median[medianPos] = mv;
+    medianPos = (medianPos + 1) % ADC_MEDIAN;
+    if (medianCount < ADC_MEDIAN)
+      medianCount++;
+
+    // Вставками — массив из 5 элементов
+    float sorted[ADC_MEDIAN];
+    for (int i = 0; i < medianCount; i++) {
+      float v = median[i];
+      int j = i;
+      while (j > 0 && sorted[j - 1] > v) {
+        sorted[j] = sorted[j - 1];
+        j--;
+      }
+      sorted[j] = v;
+    }
+    return sorted[medianCount / 2];
+  }
+  return mv;
+}
+
+void AdcPipeline::addValue(float mv) {
+  uint64_t idx = seq++;
+  uint32_t pos = idx % ADC_WINDOW;
+  // Сумма в целых мкВ: вычитается ровно то, что было прибавлено,
+  // и за месяцы работы среднее не уплывает
+  if (idx >= (uint64_t)ADC_WINDOW)
+    sum -= lroundf(ring[pos] * 1000.0f);
+  ring[pos] = mv;
+  sum += lroundf(mv * 1000.0f);
+
+  // Выбрасываем из очередей значения, вышедшие из окна. В очередях —
+  // младшие 32 бита номера, возраст считается разностью (без переполнения)
+  uint32_t now = (uint32_t)idx;
+  auto expired = [&](uint32_t q) { return now - q >= (uint32_t)ADC_WINDOW; };
+  if (minHead != minTail && expired(minQ[minHead % ADC_WINDOW]))
+    minHead++;
+  if (maxHead != maxTail && expired(maxQ[maxHead % ADC_WINDOW]))
+    maxHead++;
+
+  while (minHead != minTail &&
+         ring[minQ[(minTail - 1) % ADC_WINDOW] % ADC_WINDOW] >= mv)
+    minTail--;
+  minQ[minTail++ % ADC_WINDOW] = now;
+  while (maxHead != maxTail &&
+         ring[maxQ[(maxTail - 1) % ADC_WINDOW] % ADC_WINDOW] <= mv)
+    maxTail--;
+  maxQ[maxTail++ % ADC_WINDOW] = now;
+
+  VoltageWindow w;
+  w.count = seq < (uint64_t)ADC_WINDOW ? (uint32_t)seq : ADC_WINDOW;
+  w.total = seq;
+  w.latest = mv;
+  w.mean = sum / 1000.0 / w.count;
+  w.min = ring[minQ[minHead % ADC_WINDOW] % ADC_WINDOW];
+  w.max = ring[maxQ[maxHead % ADC_WINDOW] % ADC_WINDOW];
+  stats.store(w);
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "SeqLock.h"
+#include "TrackerHal.h"
+
+// Фоновый конвейер вольтметра.
+// Сырые отсчёты (из DMA непрерывного режима АЦП) усредняются группами по
+// oversample, переводятся в милливольты по калибровке eFuse, проходят
+// медианный или IIR-фильтр и попадают в кольцевой буфер на ADC_WINDOW
+// значений. Последнее значение и min/max/mean по окну публикуются через
+// seqlock: трекер и веб читают их за O(1), не трогая АЦП.
+// push() вызывается из одной задачи (задачи АЦП).
+
+const int ADC_WINDOW = 128; // отфильтрованных значений в окне
+const int ADC_MEDIAN = 5;   // длина медианного фильтра
+static_assert((ADC_WINDOW & (ADC_WINDOW - 1)) == 0,
+              "ADC_WINDOW must be a power of two");
+
+enum AdcFilter {
+  ADC_FILTER_NONE = 0,
+  ADC_FILTER_MEDIAN = 1,
+  ADC_FILTER_IIR = 2,
+};
+
+struct AdcPipelineConfig {
+  uint16_t oversample; // сырых отсчётов на одно значение
+  uint8_t filter;      // AdcFilter
+  float iirAlpha;      // вес нового значения для IIR (0..1]
+};
+
+const AdcPipelineConfig DEFAULT_ADC_PIPELINE = {200, ADC_FILTER_MEDIAN, 0.2};
+
+// Линейная калибровка в формате esp_adc_cal: мВ = raw * a / 65536 + b
+struct AdcCalibration {
+  uint32_t coeffA;
+  uint32_t coeffB;
+};
+
+// Без eFuse: 12 бит на V_REF = 3.3 В
+const AdcCalibration DEFAULT_ADC_CAL = {52813, 0};
+
+// Статистика окна, мВ на пине АЦП
+struct VoltageWindow {
+  float latest;
+  float min;
+  float max;
+  float mean;
+  uint32_t count; // значений в окне
+  uint64_t total; // всего значений с запуска
+};
+
+class AdcPipeline : public HalAdc {
+public:
+  explicit AdcPipeline(const AdcPipelineConfig &cfg = DEFAULT_ADC_PIPELINE,
+                       const AdcCalibration &cal = DEFAULT_ADC_CAL);
+
+  void configure(const AdcPipelineConfig &cfg, const AdcCalibration &cal);
+  void push(const uint16_t *raw, size_t n);
+
+  float pinMilliVolts() override { return stats.load().latest; }
+  VoltageWindow window() const { return stats.load(); }
+
+private:
+  void addValue(float mv);
+  float filter(float mv);
+
+  AdcPipelineConfig cfg;
+  AdcCalibration cal;
+
+  // Накопление группы передискретизации
+  uint32_t acc = 0;
+  uint16_t accCount = 0;
+
+  // Фильтры
+  float median[ADC_MEDIAN];
+  int medianCount = 0;
+  int medianPos = 0;
+  float iir = 0;
+  bool iirReady = false;
+
+  // Окно: кольцо значений, бегущая сумма и монотонные очереди индексов
+  // для min/max (амортизированно O(1) на значение)
+  float ring[ADC_WINDOW];
+  uint64_t seq = 0; // номер следующего значения
+  int64_t sum = 0;  // мкВ, по значениям, округлённым до 1 мкВ
+  uint32_t minQ[ADC_WINDOW];
+  uint32_t maxQ[ADC_WINDOW];
+  uint32_t minHead = 0, minTail = 0;
+  uint32_t maxHead = 0, maxTail = 0;
+
+  SeqLock<VoltageWindow> stats;
+};
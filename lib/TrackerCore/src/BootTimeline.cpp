@@ -0,0 +1,23 @@
+#include "BootTimeline.h"
+
+static const char *const PHASE_NAMES[BOOT_PHASES] = {
+    "setup", "config",   "storage", "restored", "tasks",
+    "cycle", "firstMove", "http",   "network",  "time"};
+
+BootTimeline::BootTimeline() {
+  for (std::atomic<uint32_t> &a : at)
+    a.store(UNSET);
+}
+
+void BootTimeline::mark(BootPhase p, uint32_t ms) {
+  uint32_t expected = UNSET;
+  at[p].compare_exchange_strong(expected, ms);
+}
+
+void BootTimeline::write(JsonWriter &w) const {
+  w.beginObject();
+  for (int i = 0; i < BOOT_PHASES; ++i)
+    if (done((BootPhase)i))
+      w.field(PHASE_NAMES[i], (unsigned long)ms((BootPhase)i));
+  w.endObject();
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+#include "JsonWriter.h"
+
+// Время этапов загрузки (мс от старта прошивки), каждый этап
+// отмечается один раз. mark() можно звать из любой задачи.
+
+enum BootPhase {
+  BOOT_SETUP = 0,    // вход в setup()
+  BOOT_CONFIG,       // настройки прочитаны
+  BOOT_STORAGE,      // LittleFS и история
+  BOOT_RESTORED,     // положение и время из RTC/flash
+  BOOT_TASKS,        // задачи FreeRTOS запущены
+  BOOT_FIRST_CYCLE,  // первый цикл трекера
+  BOOT_FIRST_MOVE,   // первая запись в серво
+  BOOT_HTTP,         // веб-сервер слушает порт
+  BOOT_NETWORK,      // подключение к Wi-Fi (или точка доступа)
+  BOOT_TIME,         // время синхронизировано
+  BOOT_PHASES
+};
+
+class BootTimeline {
+public:
+  BootTimeline();
+  void mark(BootPhase p, uint32_t ms); // повторные отметки игнорируются
+  bool done(BootPhase p) const { return at[p].load() != UNSET; }
+  uint32_t ms(BootPhase p) const { return at[p].load(); }
+
+  // {"setup":12,"config":15,..} — пройденные этапы
+  void write(JsonWriter &w) const;
+
+private:
+  static const uint32_t UNSET = 0xFFFFFFFF;
+  std::atomic<uint32_t> at[BOOT_PHASES];
+};
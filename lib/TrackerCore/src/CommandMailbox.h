@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+// Команды веба для TaskTracker без мьютекса: по ячейке на режим и на
+// каждую ось, новое значение затирает ещё не забранное ("последнее
+// побеждает"). post() — один атомарный exchange, обработчик HTTP не ждёт
+// трекер; промежуточные положения ползунка, не дождавшиеся цикла трекера,
+// просто теряются. Писателей сколько угодно, читатель (take) — один.
+
+enum CommandSlot {
+  CMD_MODE = 0,
+  CMD_HOR = 1, // углы — 1/ANGLE_SCALE градуса
+  CMD_VER = 2,
+  CMD_SLOTS = 3,
+};
+
+class CommandMailbox {
+public:
+  CommandMailbox() {
+    for (std::atomic<uint32_t> &s : slots)
+      s.store(0, std::memory_order_relaxed);
+  }
+
+  void post(CommandSlot slot, int value) {
+    if (value < INT16_MIN)
+      value = INT16_MIN;
+    if (value > INT16_MAX)
+      value = INT16_MAX;
+    uint32_t v = PENDING | (uint16_t)value;
+    if (slots[slot].exchange(v, std::memory_order_acq_rel) & PENDING)
+      superseded.fetch_add(1, std::memory_order_relaxed);
+    posted.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Забрать последнее значение; false — ячейка пуста
+  bool take(CommandSlot slot, int &value) {
+    uint32_t v = slots[slot].exchange(0, std::memory_order_acq_rel);
+    if (!(v & PENDING))
+      return false;
+    value = (int16_t)(v & 0xFFFF);
+    return true;
+  }
+
+  std::atomic<uint32_t> posted{0};
+  std::atomic<uint32_t> superseded{0}; // затёрто до обработки
+
+private:
+  static const uint32_t PENDING = 0x80000000u;
+  std::atomic<uint32_t> slots[CMD_SLOTS];
+};
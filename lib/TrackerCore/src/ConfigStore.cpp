@@ -0,0 +1,137 @@
+#include "ConfigStore.h"
+
+#include <stddef.h>
+#include <string.h>
+
+struct FieldInfo {
+  const char *name;
+  size_t offset;
+  size_t size;
+  bool text; // строка с нулём в пределах size
+};
+
+static const FieldInfo FIELDS[CFG_FIELDS] = {
+    {"ssid", offsetof(Config, ssid), sizeof(Config::ssid), true},
+    {"pass", offsetof(Config, pass), sizeof(Config::pass), true},
+    {"gmt", offsetof(Config, gmt), sizeof(Config::gmt), false},
+    {"lat", offsetof(Config, lat), sizeof(Config::lat), false},
+    {"lon", offsetof(Config, lon), sizeof(Config::lon), false},
+    {"verMin", offsetof(Config, verMin), sizeof(Config::verMin), false},
+    {"verMax", offsetof(Config, verMax), sizeof(Config::verMax), false},
+    {"hOff", offsetof(Config, hOff), sizeof(Config::hOff), false},
+    {"vOff", offsetof(Config, vOff), sizeof(Config::vOff), false},
+};
+
+// Заголовок записи (версия, длина) + данные + CRC
+const size_t RECORD_MAX = 2 + 32 + 2;
+
+// CRC-16/CCITT-FALSE
+static uint16_t crc16(const uint8_t *p, size_t n) {
+  uint16_t crc = 0xFFFF;
+  while (n--) {
+    crc ^= (uint16_t)*p++ << 8;
+    for (int i = 0; i < 8; ++i)
+      crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+  }
+  return crc;
+}
+
+void configDefaults(Config &cfg) {
+  memset(&cfg, 0, sizeof(cfg));
+  cfg.magic = CONFIG_LEGACY_MAGIC;
+  cfg.gmt = 5;
+  cfg.lat = 51.1333;
+  cfg.lon = 71.4333;
+  cfg.verMin = 15;
+  cfg.verMax = 90;
+}
+
+const char *configFieldName(ConfigField f) { return FIELDS[f].name; }
+
+uint32_t ConfigStore::diff(const Config &a, const Config &b) {
+  uint32_t mask = 0;
+  for (int i = 0; i < CFG_FIELDS; ++i) {
+    const FieldInfo &f = FIELDS[i];
+    const char *pa = (const char *)&a + f.offset;
+    const char *pb = (const char *)&b + f.offset;
+    if (f.text ? strncmp(pa, pb, f.size) != 0 : memcmp(pa, pb, f.size) != 0)
+      mask |= 1u << i;
+  }
+  return mask;
+}
+
+bool ConfigStore::readField(ConfigField i, Config &cfg) {
+  const FieldInfo &f = FIELDS[i];
+  uint8_t rec[RECORD_MAX];
+  size_t n = kv.get(f.name, rec, sizeof(rec));
+  if (!n)
+    return false;
+  size_t len = rec[1];
+  if (n != len + 4 || rec[0] != CONFIG_SCHEMA || len > f.size ||
+      (f.text ? len == f.size : len != f.size) ||
+      crc16(rec, len + 2) != (rec[len + 2] | rec[len + 3] << 8)) {
+    ++corrupted;
+    return false;
+  }
+  char *dst = (char *)&cfg + f.offset;
+  memset(dst, 0, f.size);
+  memcpy(dst, rec + 2, len);
+  return true;
+}
+
+bool ConfigStore::writeField(ConfigField i, const Config &cfg) {
+  const FieldInfo &f = FIELDS[i];
+  const char *src = (const char *)&cfg + f.offset;
+  size_t len = f.text ? strnlen(src, f.size - 1) : f.size;
+  uint8_t rec[RECORD_MAX];
+  rec[0] = CONFIG_SCHEMA;
+  rec[1] = len;
+  memcpy(rec + 2, src, len);
+  uint16_t crc = crc16(rec, len + 2);
+  rec[len + 2] = crc;
+  rec[len + 3] = crc >> 8;
+  if (!kv.put(f.name, rec, len + 4))
+    return false;
+  ++writes;
+  return true;
+}
+
+bool ConfigStore::load(Config &cfg) {
+  configDefaults(cfg);
+  bool any = false;
+  dirty = 0;
+  for (int i = 0; i < CFG_FIELDS; ++i) {
+    uint32_t bad = corrupted;
+    any |= readField((ConfigField)i, cfg);
+    // Отброшенное поле перезапишется значением по умолчанию при save()
+    if (corrupted != bad)
+      dirty |= 1u << i;
+  }
+  stored = cfg;
+  return any;
+}
+
+void ConfigStore::migrate(Config &cfg, const Config &legacy) {
+  Config old = legacy; // legacy может быть самим cfg
+  configDefaults(cfg);
+  if (old.magic == CONFIG_LEGACY_MAGIC) {
+    cfg = old;
+    cfg.ssid[sizeof(cfg.ssid) - 1] = 0;
+    cfg.pass[sizeof(cfg.pass) - 1] = 0;
+  }
+  dirty = CFG_ALL; // записать всё
+  save(cfg);
+}
+
+uint32_t ConfigStore::save(const Config &cfg) {
+  uint32_t changed = diff(stored, cfg) | dirty, written = 0;
+  for (int i = 0; i < CFG_FIELDS; ++i)
+    if (changed & (1u << i) && writeField((ConfigField)i, cfg)) {
+      const FieldInfo &f = FIELDS[i];
+      memcpy((char *)&stored + f.offset, (const char *)&cfg + f.offset,
+             f.size);
+      written |= 1u << i;
+    }
+  dirty &= ~written;
+  return written;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "TrackerConfig.h"
+#include "TrackerHal.h"
+
+// Настройки в энергонезависимом хранилище ключ-значение (NVS).
+// Каждое поле Config — отдельная запись: [версия схемы][длина][данные]
+// [CRC-16]. save() пишет только изменившиеся поля, поэтому правка
+// смещений не трогает SSID и пароль и не изнашивает flash. Повреждённая
+// запись (CRC, длина, неизвестная версия) заменяется значением
+// по умолчанию, и следующий save() перезаписывает только её. Если
+// записей ещё нет, migrate() переносит настройки из прежнего
+// EEPROM-образа Config.
+
+const uint8_t CONFIG_SCHEMA = 1;
+const uint8_t CONFIG_LEGACY_MAGIC = 123; // Config.magic в EEPROM-образе
+
+enum ConfigField {
+  CFG_SSID = 0,
+  CFG_PASS,
+  CFG_GMT,
+  CFG_LAT,
+  CFG_LON,
+  CFG_VER_MIN,
+  CFG_VER_MAX,
+  CFG_H_OFF,
+  CFG_V_OFF,
+  CFG_FIELDS
+};
+
+inline uint32_t cfgBit(ConfigField f) { return 1u << f; }
+const uint32_t CFG_CREDENTIALS = (1u << CFG_SSID) | (1u << CFG_PASS);
+const uint32_t CFG_ALL = (1u << CFG_FIELDS) - 1;
+
+// Значения по умолчанию (Астана, наклон 15..90)
+void configDefaults(Config &cfg);
+
+// Имя поля (ключ записи и параметр /api/saveCfg)
+const char *configFieldName(ConfigField f);
+
+class ConfigStore {
+public:
+  explicit ConfigStore(HalKeyValue &kv) : kv(kv) {}
+
+  // false — записей нет (первый запуск или прошивка с EEPROM)
+  bool load(Config &cfg);
+  // Первый запуск с NVS: взять прежний образ, если он действителен
+  void migrate(Config &cfg, const Config &legacy);
+  // Записать изменившиеся поля; маска записанных полей
+  uint32_t save(const Config &cfg);
+
+  // Маска полей, которыми a и b различаются
+  static uint32_t diff(const Config &a, const Config &b);
+
+  uint32_t writes = 0;    // записей в хранилище
+  uint32_t corrupted = 0; // записей, отброшенных при загрузке
+
+private:
+  bool readField(ConfigField f, Config &cfg);
+  bool writeField(ConfigField f, const Config &cfg);
+
+  HalKeyValue &kv;
+  Config stored = {}; // то, что лежит в хранилище
+  uint32_t dirty = 0; // поля, которые надо записать, даже если равны stored
+};
@@ -0,0 +1,133 @@
+#include "EnergyStats.h"
+
+#include <math.h>
+#include <string.h>
+
+static const char *const PERIOD_NAMES[] = {"minute", "hour", "day"};
+static const float DEG = M_PI / 180.0f;
+
+static void resetBucket(EnergyBucket &b, uint32_t start) {
+  memset(&b, 0, sizeof(b));
+  b.start = start;
+}
+
+EnergyStats::EnergyStats(const EnergyModel &model) : model(model) {
+  levels[ENERGY_MINUTE].period = 60;
+  levels[ENERGY_MINUTE].ring = minutes;
+  levels[ENERGY_MINUTE].size = ENERGY_MINUTES;
+  levels[ENERGY_HOUR].period = 3600;
+  levels[ENERGY_HOUR].ring = hours;
+  levels[ENERGY_HOUR].size = ENERGY_HOURS;
+  levels[ENERGY_DAY].period = 86400;
+  levels[ENERGY_DAY].ring = days;
+  levels[ENERGY_DAY].size = ENERGY_DAYS;
+  for (Level &l : levels)
+    resetBucket(l.ring[0], 0);
+}
+
+float EnergyStats::fixedFactor(float sunAz, float sunAlt) const {
+  if (sunAlt <= 0)
+    return 0;
+  float tilt = model.fixedTiltDeg * DEG, alt = sunAlt * DEG;
+  float c = sinf(alt) * cosf(tilt) +
+            cosf(alt) * sinf(tilt) * cosf((sunAz - model.fixedAzDeg) * DEG);
+  return c > 0 ? c : 0;
+}
+
+// Перейти к корзине, в которую попадает t (по местному времени)
+void EnergyStats::roll(Level &l, uint32_t t) {
+  int64_t local = (int64_t)t + model.tzOffsetSec;
+  uint32_t start = local - local % l.period - model.tzOffsetSec;
+  if (!l.count) {
+    l.head = 0;
+    l.count = 1;
+    resetBucket(l.ring[0], start);
+  } else if (start > l.ring[l.head].start) {
+    l.head = (l.head + 1) % l.size;
+    if (l.count < l.size)
+      ++l.count;
+    resetBucket(l.ring[l.head], start);
+  } // время назад (коррекция NTP) — остаёмся в текущей корзине
+}
+
+void EnergyStats::add(uint32_t t, float volts, bool tracking, float sunAz,
+                      float sunAlt) {
+  if (volts < 0)
+    volts = 0;
+  float p = model.loadOhms > 0 ? volts * volts / model.loadOhms : 0;
+  // Вне слежения сравнивать не с чем: неподвижная панель "равна" трекеру
+  float fixedP = tracking ? p * fixedFactor(sunAz, sunAlt) : p;
+
+  uint32_t dt = 0;
+  if (lastT && t > lastT && t - lastT <= ENERGY_MAX_GAP_S)
+    dt = t - lastT;
+  float wh = (lastP + p) * 0.5f * dt / 3600.0f;
+  float fixedWh = (lastFixedP + fixedP) * 0.5f * dt / 3600.0f;
+  if (t >= lastT) {
+    lastT = t;
+    lastP = p;
+    lastFixedP = fixedP;
+  }
+
+  for (Level &l : levels) {
+    roll(l, t);
+    EnergyBucket &b = l.ring[l.head];
+    if (!b.samples || volts < b.vMin)
+      b.vMin = volts;
+    if (!b.samples || volts > b.vMax)
+      b.vMax = volts;
+    ++b.samples;
+    b.vSum += volts;
+    b.wh += wh;
+    b.fixedWh += fixedWh;
+    (tracking ? b.trackedSec : b.idleSec) += dt;
+  }
+}
+
+const EnergyBucket &EnergyStats::bucket(EnergyPeriod p, int ago) const {
+  static const EnergyBucket empty = {};
+  const Level &l = levels[p];
+  if (ago < 0 || ago >= l.count)
+    return empty;
+  return l.ring[(l.head - ago + l.size) % l.size];
+}
+
+void EnergyStats::write(JsonWriter &w, EnergyPeriod p, int n) const {
+  if (n > count(p))
+    n = count(p);
+  w.beginObject().field("period", PERIOD_NAMES[p]);
+  w.key("fields").beginArray();
+  static const char *const FIELDS[] = {"t",     "n",       "vMin",
+                                       "vMax",  "vMean",   "wh",
+                                       "fixedWh", "tracked", "idle"};
+  for (const char *f : FIELDS)
+    w.value(f);
+  w.endArray();
+
+  w.key("data").beginArray();
+  for (int ago = n - 1; ago >= 0; --ago) {
+    const EnergyBucket &b = bucket(p, ago);
+    w.beginArray()
+        .value(b.start)
+        .value(b.samples)
+        .value(b.vMin, 2)
+        .value(b.vMax, 2)
+        .value(b.vMean(), 2)
+        .value(b.wh, 3)
+        .value(b.fixedWh, 3)
+        .value(b.trackedSec)
+        .value(b.idleSec)
+        .endArray();
+  }
+  w.endArray();
+
+  // Итог текущих суток: выигрыш слежения относительно неподвижной панели
+  const EnergyBucket &today = bucket(ENERGY_DAY);
+  w.key("today")
+      .beginObject()
+      .field("wh", today.wh, 3)
+      .field("fixedWh", today.fixedWh, 3)
+      .field("gain", today.fixedWh > 0 ? today.wh / today.fixedWh : 0.0f, 3)
+      .endObject();
+  w.endObject();
+}
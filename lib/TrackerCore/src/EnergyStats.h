@@ -0,0 +1,86 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "JsonWriter.h"
+
+// Накопительная статистика выработки.
+// Каждое измерение за O(1) добавляется сразу в текущие корзины минуты,
+// часа и суток (локальные сутки — по tzOffsetSec): min/max/среднее
+// напряжение, энергия (мощность V²/R на нагрузке, трапеции между
+// измерениями), время слежения и простоя и оценка для неподвижной панели.
+// Закрытые корзины хранятся в кольцах, ответ API собирается из них без
+// пересчёта сырых данных. Вызывается из одной задачи (веб).
+
+enum EnergyPeriod {
+  ENERGY_MINUTE = 0,
+  ENERGY_HOUR = 1,
+  ENERGY_DAY = 2,
+};
+
+const int ENERGY_MINUTES = 60; // корзин в кольце каждого уровня
+const int ENERGY_HOURS = 48;
+const int ENERGY_DAYS = 31;
+const uint32_t ENERGY_MAX_GAP_S = 60; // больший разрыв не интегрируется
+
+struct EnergyModel {
+  float loadOhms;     // сопротивление нагрузки панели
+  float fixedTiltDeg; // неподвижная панель для сравнения: наклон
+  float fixedAzDeg;   // и азимут (180 — на юг)
+  int32_t tzOffsetSec; // начало суток — местная полночь
+};
+
+const EnergyModel DEFAULT_ENERGY_MODEL = {10.0f, 51.0f, 180.0f, 0};
+
+struct EnergyBucket {
+  uint32_t start;   // начало интервала, unix-время
+  uint32_t samples;
+  float vMin, vMax, vSum;
+  float wh;         // выработка, Вт·ч
+  float fixedWh;    // оценка для неподвижной панели, Вт·ч
+  uint32_t trackedSec; // авто-слежение днём
+  uint32_t idleSec;    // ночь, ручной режим, калибровка, демо
+
+  float vMean() const { return samples ? vSum / samples : 0.0f; }
+};
+
+class EnergyStats {
+public:
+  explicit EnergyStats(const EnergyModel &model = DEFAULT_ENERGY_MODEL);
+  void configure(const EnergyModel &m) { model = m; }
+  const EnergyModel &config() const { return model; }
+
+  // Измерение: время, напряжение панели, идёт ли слежение, Солнце
+  void add(uint32_t t, float volts, bool tracking, float sunAz,
+           float sunAlt);
+
+  // ago = 0 — текущая корзина, 1 — предыдущая и т.д.
+  int count(EnergyPeriod p) const { return levels[p].count; }
+  const EnergyBucket &bucket(EnergyPeriod p, int ago = 0) const;
+
+  // {"period":"hour","fields":[..],"data":[[start,..],..]} — от старых
+  // к новым, не больше n корзин
+  void write(JsonWriter &w, EnergyPeriod p, int n) const;
+
+  // Доля мощности неподвижной панели: косинус угла падения лучей
+  float fixedFactor(float sunAz, float sunAlt) const;
+
+private:
+  struct Level {
+    uint32_t period;
+    EnergyBucket *ring;
+    int size;
+    int head = 0;  // текущая корзина
+    int count = 0; // заполненных корзин
+  };
+  void roll(Level &l, uint32_t t);
+
+  EnergyModel model;
+  EnergyBucket minutes[ENERGY_MINUTES];
+  EnergyBucket hours[ENERGY_HOURS];
+  EnergyBucket days[ENERGY_DAYS];
+  Level levels[3];
+  uint32_t lastT = 0;
+  float lastP = 0, lastFixedP = 0;
+};
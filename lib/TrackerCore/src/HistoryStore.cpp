@@ -0,0 +1,348 @@
+#include "HistoryStore.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+// Блок на flash:
+//   [0] 0xB5, [1] число точек, [2..3] длина данных, [4..7] t первой точки,
+//   [8..11] t последней; далее первая точка (8 байт без t) и для каждой
+//   следующей: маска изменившихся полей (биты 0..4: volts, az, alt, hor,
+//   ver), varint(dt), zigzag-varint дельт
+const uint8_t BLOCK_MAGIC = 0xB5;
+const size_t BLOCK_HEADER = 12;
+const size_t BLOCK_MAX = 8 + (HISTORY_BATCH - 1) * (1 + 5 + 3 * 3 + 2 * 2);
+
+static uint8_t blockBuf[BLOCK_HEADER + BLOCK_MAX];
+
+static void put16(uint8_t *p, uint16_t v) {
+  p[0] = v;
+  p[1] = v >> 8;
+}
+
+static void put32(uint8_t *p, uint32_t v) {
+  put16(p, v);
+  put16(p + 2, v >> 16);
+}
+
+static uint16_t get16(const uint8_t *p) { return p[0] | (p[1] << 8); }
+
+static uint32_t get32(const uint8_t *p) {
+  return get16(p) | ((uint32_t)get16(p + 2) << 16);
+}
+
+static uint8_t *putVarint(uint8_t *p, uint32_t v) {
+  while (v >= 0x80) {
+    *p++ = (v & 0x7F) | 0x80;
+    v >>= 7;
+  }
+  *p++ = v;
+  return p;
+}
+
+static const uint8_t *getVarint(const uint8_t *p, const uint8_t *end,
+                                uint32_t &v) {
+  v = 0;
+  for (int shift = 0; p < end && shift < 35; shift += 7) {
+    uint8_t b = *p++;
+    v |= (uint32_t)(b & 0x7F) << shift;
+    if (!(b & 0x80))
+      return p;
+  }
+  return nullptr;
+}
+
+static uint32_t zigzag(int32_t v) { return ((uint32_t)v << 1) ^ (v >> 31); }
+
+static int32_t unzigzag(uint32_t v) {
+  return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+static size_t encodeBlock(const HistorySample *const *s, int count,
+                          uint8_t *out) {
+  uint8_t *p = out + BLOCK_HEADER;
+  const HistorySample &f = *s[0];
+  put16(p, f.voltsCenti);
+  put16(p + 2, f.sunAzDeci);
+  put16(p + 4, (uint16_t)f.sunAltDeci);
+  p[6] = f.hor;
+  p[7] = f.ver;
+  p += 8;
+  for (int i = 1; i < count; ++i) {
+    const HistorySample &a = *s[i - 1], &b = *s[i];
+    int32_t d[5] = {b.voltsCenti - a.voltsCenti, b.sunAzDeci - a.sunAzDeci,
+                    b.sunAltDeci - a.sunAltDeci, b.hor - a.hor, b.ver - a.ver};
+    uint8_t *mask = p++;
+    *mask = 0;
+    p = putVarint(p, b.t - a.t);
+    for (int k = 0; k < 5; ++k)
+      if (d[k]) {
+        *mask |= 1 << k;
+        p = putVarint(p, zigzag(d[k]));
+      }
+  }
+  size_t len = p - out - BLOCK_HEADER;
+  out[0] = BLOCK_MAGIC;
+  out[1] = count;
+  put16(out + 2, len);
+  put32(out + 4, s[0]->t);
+  put32(out + 8, s[count - 1]->t);
+  return BLOCK_HEADER + len;
+}
+
+// Раскодировать блок (заголовок + данные); false — блок повреждён
+template <typename Fn>
+static bool decodeBlock(const uint8_t *blk, Fn fn) {
+  int count = blk[1];
+  const uint8_t *p = blk + BLOCK_HEADER;
+  const uint8_t *end = p + get16(blk + 2);
+  if (count < 1 || end - p < 8)
+    return false;
+  HistorySample s;
+  s.t = get32(blk + 4);
+  s.voltsCenti = get16(p);
+  s.sunAzDeci = get16(p + 2);
+  s.sunAltDeci = (int16_t)get16(p + 4);
+  s.hor = p[6];
+  s.ver = p[7];
+  p += 8;
+  fn(s);
+  for (int i = 1; i < count; ++i) {
+    if (p >= end)
+      return false;
+    uint8_t mask = *p++;
+    uint32_t v;
+    if (!(p = getVarint(p, end, v)))
+      return false;
+    s.t += v;
+    int32_t d[5] = {0, 0, 0, 0, 0};
+    for (int k = 0; k < 5; ++k)
+      if (mask & (1 << k)) {
+        if (!(p = getVarint(p, end, v)))
+          return false;
+        d[k] = unzigzag(v);
+      }
+    s.voltsCenti += d[0];
+    s.sunAzDeci += d[1];
+    s.sunAltDeci += d[2];
+    s.hor += d[3];
+    s.ver += d[4];
+    fn(s);
+  }
+  return true;
+}
+
+static int32_t clampRound(float v, int32_t lo, int32_t hi) {
+  int32_t r = lroundf(v);
+  return r < lo ? lo : r > hi ? hi : r;
+}
+
+HistorySample makeHistorySample(uint32_t t, const TrackerSnapshot &snap,
+                                int hor, int ver) {
+  HistorySample s;
+  s.t = t;
+  s.voltsCenti = clampRound(snap.panelVolts * 100.0f, 0, 65535);
+  float az = fmodf(snap.sunAz, 360.0f);
+  s.sunAzDeci = clampRound((az < 0 ? az + 360.0f : az) * 10.0f, 0, 3599);
+  s.sunAltDeci = clampRound(snap.sunAlt * 10.0f, -900, 900);
+  s.hor = clampRound(hor, 0, 255);
+  s.ver = clampRound(ver, 0, 255);
+  return s;
+}
+
+HistoryStore::HistoryStore(HalStorage *storage) : storage(storage) {
+  memset(segFirst, 0, sizeof(segFirst));
+  memset(segLast, 0, sizeof(segLast));
+  memset(segBytes, 0, sizeof(segBytes));
+}
+
+void HistoryStore::segmentName(int seg, char *buf) const {
+  snprintf(buf, 16, "/hist%d.bin", seg);
+}
+
+// Пройти заголовки блоков сегмента: границы по времени и целостность
+void HistoryStore::scanSegment(int seg) {
+  char name[16];
+  segmentName(seg, name);
+  size_t size = storage->size(name);
+  segFirst[seg] = segLast[seg] = 0;
+  segBytes[seg] = size;
+  uint8_t hdr[BLOCK_HEADER];
+  for (size_t off = 0; off < size;) {
+    if (storage->read(name, off, hdr, sizeof(hdr)) != sizeof(hdr) ||
+        hdr[0] != BLOCK_MAGIC || off + sizeof(hdr) + get16(hdr + 2) > size) {
+      // Оборванная запись (питание пропало): дальше не дописываем
+      segBytes[seg] = HISTORY_SEGMENT_BYTES;
+      break;
+    }
+    if (!segFirst[seg])
+      segFirst[seg] = get32(hdr + 4);
+    segLast[seg] = get32(hdr + 8);
+    off += sizeof(hdr) + get16(hdr + 2);
+  }
+}
+
+void HistoryStore::begin() {
+  if (!storage)
+    return;
+  current = 0;
+  for (int seg = 0; seg < HISTORY_SEGMENTS; ++seg) {
+    scanSegment(seg);
+    if (segLast[seg] > segLast[current])
+      current = seg;
+  }
+}
+
+bool HistoryStore::spill(int count) {
+  const HistorySample *s[HISTORY_BATCH];
+  for (int i = 0; i < count; ++i)
+    s[i] = &ram[(spilled + i) & (HISTORY_RAM - 1)];
+  size_t len = encodeBlock(s, count, blockBuf);
+
+  char name[16];
+  if (segBytes[current] && segBytes[current] + len > HISTORY_SEGMENT_BYTES) {
+    current = (current + 1) % HISTORY_SEGMENTS; // стираем самый старый
+    segmentName(current, name);
+    storage->remove(name);
+    segFirst[current] = segLast[current] = 0;
+    segBytes[current] = 0;
+  }
+  segmentName(current, name);
+  if (!storage->append(name, blockBuf, len))
+    return false;
+  if (!segFirst[current])
+    segFirst[current] = s[0]->t;
+  segLast[current] = s[count - 1]->t;
+  segBytes[current] += len;
+  spilled += count;
+  ++blocks;
+  return true;
+}
+
+void HistoryStore::record(const HistorySample &s) {
+  // Время назад (коррекция NTP): дельта-код и запросы полагаются на
+  // возрастание, точки до уже записанного отбрасываются
+  if (s.t <= newest()) {
+    ++stale;
+    return;
+  }
+  if (head - spilled == HISTORY_RAM) {
+    ++spilled; // кольцо полно: вытесняем самую старую точку
+    if (storage)
+      ++dropped;
+  }
+  ram[head & (HISTORY_RAM - 1)] = s;
+  ++head;
+  ++recorded;
+  if (storage && head - spilled >= (uint32_t)HISTORY_BATCH)
+    spill(HISTORY_BATCH);
+}
+
+void HistoryStore::flush() {
+  while (storage && head > spilled) {
+    uint32_t n = head - spilled;
+    if (!spill(n < (uint32_t)HISTORY_BATCH ? n : HISTORY_BATCH))
+      return;
+  }
+}
+
+template <typename Fn>
+void HistoryStore::forEachSample(uint32_t from, uint32_t to, Fn fn) {
+  bool done = false;
+  auto inRange = [&](const HistorySample &s) {
+    if (s.t > to)
+      done = true;
+    else if (s.t >= from)
+      fn(s);
+  };
+
+  // Сегменты по кругу от самого старого, внутри — блок за блоком
+  for (int k = 1; storage && k <= HISTORY_SEGMENTS && !done; ++k) {
+    int seg = (current + k) % HISTORY_SEGMENTS;
+    if (!segFirst[seg] || segLast[seg] < from)
+      continue;
+    char name[16];
+    segmentName(seg, name);
+    size_t size = storage->size(name);
+    for (size_t off = 0; off < size && !done;) {
+      uint8_t *hdr = blockBuf;
+      if (storage->read(name, off, hdr, BLOCK_HEADER) != BLOCK_HEADER ||
+          hdr[0] != BLOCK_MAGIC || get16(hdr + 2) > BLOCK_MAX)
+        break;
+      size_t len = get16(hdr + 2);
+      if (get32(hdr + 4) > to) {
+        done = true;
+      } else if (get32(hdr + 8) >= from) {
+        if (storage->read(name, off + BLOCK_HEADER, hdr + BLOCK_HEADER,
+                          len) != len ||
+            !decodeBlock(hdr, inRange))
+          break;
+      }
+      off += BLOCK_HEADER + len;
+    }
+  }
+
+  // Ещё не сброшенные на flash точки из RAM
+  for (uint32_t i = spilled; i != head && !done; ++i)
+    inRange(ram[i & (HISTORY_RAM - 1)]);
+}
+
+uint32_t HistoryStore::query(uint32_t from, uint32_t to, uint32_t step,
+                             HistorySink sink, void *ctx) {
+  if (!step)
+    step = 1;
+  uint32_t points = 0, bucket = 0, n = 0;
+  int64_t sum[5] = {0, 0, 0, 0, 0};
+  // Азимут усредняется по кругу: отклонения от первой точки интервала
+  // в [-180°, 180°), иначе 359° и 1° дали бы 180°
+  int32_t az0 = 0;
+
+  auto emit = [&]() {
+    HistorySample a;
+    a.t = from + bucket * step;
+    a.voltsCenti = (sum[0] + n / 2) / n;
+    int32_t az = az0 + lround((double)sum[1] / n);
+    a.sunAzDeci = (az % 3600 + 3600) % 3600;
+    a.sunAltDeci = lround((double)sum[2] / n);
+    a.hor = (sum[3] + n / 2) / n;
+    a.ver = (sum[4] + n / 2) / n;
+    sink(a, ctx);
+    ++points;
+  };
+
+  forEachSample(from, to, [&](const HistorySample &s) {
+    uint32_t b = (s.t - from) / step;
+    if (n && b != bucket) {
+      emit();
+      n = 0;
+      memset(sum, 0, sizeof(sum));
+    }
+    bucket = b;
+    if (!n++)
+      az0 = s.sunAzDeci;
+    int32_t dAz = ((int32_t)s.sunAzDeci - az0 + 5400) % 3600 - 1800;
+    sum[0] += s.voltsCenti;
+    sum[1] += dAz;
+    sum[2] += s.sunAltDeci;
+    sum[3] += s.hor;
+    sum[4] += s.ver;
+  });
+  if (n)
+    emit();
+  return points;
+}
+
+uint32_t HistoryStore::oldest() const {
+  for (int k = 1; storage && k <= HISTORY_SEGMENTS; ++k) {
+    int seg = (current + k) % HISTORY_SEGMENTS;
+    if (segFirst[seg])
+      return segFirst[seg];
+  }
+  return head != spilled ? ram[spilled & (HISTORY_RAM - 1)].t : 0;
+}
+
+uint32_t HistoryStore::newest() const {
+  if (head != spilled)
+    return ram[(head - 1) & (HISTORY_RAM - 1)].t;
+  return storage ? segLast[current] : 0;
+}
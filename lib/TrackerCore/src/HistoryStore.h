@@ -0,0 +1,80 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "TrackerCore.h"
+#include "TrackerHal.h"
+
+// История телеметрии на устройстве.
+// Новые точки попадают в кольцевой буфер в RAM (упакованные 12 байт),
+// пачками по HISTORY_BATCH сбрасываются на flash блоком с дельта-кодом
+// (в среднем 3–6 байт на точку). Блоки дописываются в HISTORY_SEGMENTS
+// файлов по кругу: заполненный файл закрывается, самый старый стирается.
+// Запросы читают блок за блоком и отдают средние по интервалам через
+// callback — весь диапазон в память не загружается.
+// Все методы вызываются из одной задачи (веб).
+
+const int HISTORY_RAM = 256;      // точек в RAM
+const int HISTORY_BATCH = 64;     // точек в блоке на flash
+const int HISTORY_SEGMENTS = 16;  // файлов на flash
+const size_t HISTORY_SEGMENT_BYTES = 16384;
+const uint32_t HISTORY_PERIOD_S = 10; // период записи (main.cpp)
+static_assert((HISTORY_RAM & (HISTORY_RAM - 1)) == 0,
+              "HISTORY_RAM must be a power of two");
+static_assert(HISTORY_BATCH <= HISTORY_RAM / 2 && HISTORY_BATCH <= 255,
+              "HISTORY_BATCH must fit the ring and a block header");
+
+struct HistorySample {
+  uint32_t t;          // unix-время, с
+  uint16_t voltsCenti; // напряжение панели, 0.01 В
+  uint16_t sunAzDeci;  // азимут, 0.1°
+  int16_t sunAltDeci;  // высота, 0.1°
+  uint8_t hor;         // фактические углы серво
+  uint8_t ver;
+};
+static_assert(sizeof(HistorySample) == 12, "HistorySample must stay packed");
+
+HistorySample makeHistorySample(uint32_t t, const TrackerSnapshot &snap,
+                                int hor, int ver);
+
+typedef void (*HistorySink)(const HistorySample &s, void *ctx);
+
+class HistoryStore {
+public:
+  explicit HistoryStore(HalStorage *storage = nullptr); // nullptr — только RAM
+
+  // Найти сегменты прошлых запусков и продолжить запись за ними
+  void begin();
+  void record(const HistorySample &s); // не новее newest() — отбрасывается
+  void flush(); // сбросить неполную пачку (перед перезагрузкой)
+
+  // Средние по интервалам step секунд на [from, to], по возрастанию
+  // времени; t точки — начало интервала. Возвращает число точек
+  uint32_t query(uint32_t from, uint32_t to, uint32_t step, HistorySink sink,
+                 void *ctx);
+
+  uint32_t oldest() const; // 0 — истории нет
+  uint32_t newest() const;
+
+  uint32_t recorded = 0; // точек за время работы
+  uint32_t dropped = 0;  // потеряно (flash недоступна, RAM переполнена)
+  uint32_t blocks = 0;   // записано блоков
+  uint32_t stale = 0;    // отброшено: часы шагнули назад
+
+private:
+  bool spill(int count);
+  void segmentName(int seg, char *buf) const;
+  void scanSegment(int seg);
+  template <typename Fn> void forEachSample(uint32_t from, uint32_t to,
+                                            Fn fn);
+
+  HalStorage *storage;
+  HistorySample ram[HISTORY_RAM];
+  uint32_t head = 0;    // всего записано в кольцо
+  uint32_t spilled = 0; // из них уже на flash (или потеряно)
+  int current = 0;      // сегмент для дозаписи
+  uint32_t segFirst[HISTORY_SEGMENTS]; // время первой точки, 0 — пусто
+  uint32_t segLast[HISTORY_SEGMENTS];
+  size_t segBytes[HISTORY_SEGMENTS];
+};
@@ -0,0 +1,707 @@
+#include "HttpServer.h"
+
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0 // lwIP не шлёт SIGPIPE
+#endif
+
+enum {
+  CONN_FREE = 0,
+  CONN_READ = 1,   // ждём / принимаем запрос
+  CONN_WRITE = 2,  // отправляем ответ
+  CONN_STREAM = 3, // открытый поток (broadcast)
+  CONN_UPLOAD = 4, // тело по частям в HttpUploadHandler
+};
+
+static uint32_t msNow() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)ts.tv_sec * 1000u + (uint32_t)(ts.tv_nsec / 1000000);
+}
+
+static bool expired(uint32_t now, uint32_t deadline) {
+  return (int32_t)(now - deadline) >= 0;
+}
+
+static bool pending(const HttpConn &c) {
+  return c.txSent < c.txLen || c.bodySent < c.bodyLen;
+}
+
+static void setNonBlocking(int fd) {
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+}
+
+static const char *statusText(int code) {
+  switch (code) {
+  case 200: return "OK";
+  case 204: return "No Content";
+  case 304: return "Not Modified";
+  case 400: return "Bad Request";
+  case 401: return "Unauthorized";
+  case 404: return "Not Found";
+  case 405: return "Method Not Allowed";
+  case 409: return "Conflict";
+  case 413: return "Payload Too Large";
+  case 431: return "Request Header Fields Too Large";
+  case 500: return "Internal Server Error";
+  case 503: return "Service Unavailable";
+  default: return "";
+  }
+}
+
+static int hexDigit(char c) {
+  if (c >= '0' && c <= '9')
+    return c - '0';
+  c = tolower((unsigned char)c);
+  if (c >= 'a' && c <= 'f')
+    return c - 'a' + 10;
+  return -1;
+}
+
+// %XX и '+' в query-строке, на месте
+static void urlDecode(char *s) {
+  char *out = s;
+  for (; *s; ++s) {
+    if (*s == '+') {
+      *out++ = ' ';
+    } else if (*s == '%' && hexDigit(s[1]) >= 0 && hexDigit(s[2]) >= 0) {
+      *out++ = (char)(hexDigit(s[1]) * 16 + hexDigit(s[2]));
+      s += 2;
+    } else {
+      *out++ = *s;
+    }
+  }
+  *out = 0;
+}
+
+static long findHeaderEnd(const char *buf, size_t len) {
+  for (size_t i = 3; i < len; ++i)
+    if (buf[i] == '\n' && buf[i - 1] == '\r' && buf[i - 2] == '\n' &&
+        buf[i - 3] == '\r')
+      return (long)(i + 1);
+  return -1;
+}
+
+// Content-Length до разбора на месте: нужен, чтобы дождаться тела
+static long contentLength(const char *buf, size_t hdrLen) {
+  static const char name[] = "\ncontent-length:";
+  const size_t n = sizeof(name) - 1;
+  for (size_t i = 0; i + n <= hdrLen; ++i)
+    if (strncasecmp(buf + i, name, n) == 0)
+      return strtol(buf + i + n, nullptr, 10);
+  return 0;
+}
+
+// ================= HttpRequest =================
+bool HttpRequest::hasArg(const char *name) const {
+  for (int i = 0; i < args; ++i)
+    if (strcmp(argName[i], name) == 0)
+      return true;
+  return false;
+}
+
+const char *HttpRequest::arg(const char *name) const {
+  for (int i = 0; i < args; ++i)
+    if (strcmp(argName[i], name) == 0)
+      return argValue[i];
+  return "";
+}
+
+const char *HttpRequest::header(const char *name) const {
+  for (int i = 0; i < headers; ++i)
+    if (strcasecmp(hdrName[i], name) == 0)
+      return hdrValue[i];
+  return "";
+}
+
+// ================= HttpResponse =================
+void HttpResponse::header(const char *name, const char *value) {
+  int n = snprintf(extra + extraLen, sizeof(extra) - extraLen, "%s: %s\r\n",
+                   name, value);
+  if (n > 0 && extraLen + n < sizeof(extra))
+    extraLen += n;
+}
+
+bool HttpResponse::head(int code, const char *type, long len) {
+  if (started)
+    return false;
+  started = true;
+  bool noBody = code == 204 || code == 304;
+  if (len < 0 && !noBody)
+    conn.keepAlive = false; // тело до закрытия соединения
+
+  char *p = conn.tx;
+  size_t cap = sizeof(conn.tx);
+  int n = snprintf(p, cap, "HTTP/1.1 %d %s\r\n", code, statusText(code));
+  if (type)
+    n += snprintf(p + n, cap - n, "Content-Type: %s\r\n", type);
+  if (len >= 0 && !noBody)
+    n += snprintf(p + n, cap - n, "Content-Length: %ld\r\n", len);
+  n += snprintf(p + n, cap - n, "Connection: %s\r\n%.*s\r\n",
+                conn.keepAlive ? "keep-alive" : "close", (int)extraLen,
+                extra);
+  conn.txLen = (size_t)n < cap ? n : cap;
+  conn.txSent = 0;
+  conn.state = CONN_WRITE;
+  return true;
+}
+
+void HttpResponse::respond(int code, const char *type, const char *body) {
+  respond(code, type, body, body ? strlen(body) : 0);
+}
+
+void HttpResponse::respond(int code, const char *type, const char *body,
+                           size_t len) {
+  if (!head(code, type, (long)len))
+    return;
+  if (conn.txLen + len > sizeof(conn.tx)) {
+    started = false;
+    extraLen = 0;
+    respond(500, "text/plain", "Response too large");
+    return;
+  }
+  memcpy(conn.tx + conn.txLen, body, len);
+  conn.txLen += len;
+}
+
+void HttpResponse::respondStatic(int code, const char *type,
+                                 const uint8_t *body, size_t len) {
+  if (!head(code, type, (long)len))
+    return;
+  conn.body = body;
+  conn.bodyLen = len;
+  conn.bodySent = 0;
+}
+
+void HttpResponse::start(int code, const char *type) { head(code, type, -1); }
+
+void HttpResponse::produce(int code, const char *type, HttpProducer fill,
+                           const void *state, size_t len) {
+  if (len > sizeof(conn.producerState)) {
+    respond(500, "text/plain", "Producer state too large");
+    return;
+  }
+  if (!head(code, type, -1))
+    return;
+  memcpy(conn.producerState, state, len);
+  conn.producer = fill;
+  server.produce(conn); // первая порция — вместе с заголовками
+}
+
+size_t HttpResponse::room() const { return sizeof(conn.tx) - conn.txLen; }
+
+bool HttpResponse::append(const char *data, size_t len) {
+  if (!started || conn.fd < 0)
+    return false;
+  if (conn.producer) { // генератор не ждёт: порция целиком или ничего
+    if (len > room())
+      return false;
+    memcpy(conn.tx + conn.txLen, data, len);
+    conn.txLen += len;
+    return true;
+  }
+  while (len) {
+    if (conn.txLen == sizeof(conn.tx) &&
+        !server.flushWait(conn, HTTP_APPEND_WAIT_MS)) {
+      server.drop(conn); // клиент не забирает — дальше не ждём
+      ++server.timeouts;
+      return false;
+    }
+    size_t n = sizeof(conn.tx) - conn.txLen;
+    if (n > len)
+      n = len;
+    memcpy(conn.tx + conn.txLen, data, n);
+    conn.txLen += n;
+    data += n;
+    len -= n;
+  }
+  return true;
+}
+
+void HttpResponse::keepOpen() {
+  if (started)
+    conn.state = CONN_STREAM;
+}
+
+// ================= HttpServer =================
+HttpServer::HttpServer(const HttpServerConfig &cfg) : cfg(cfg) {}
+
+HttpServer::~HttpServer() { end(); }
+
+void HttpServer::on(HttpMethod method, const char *path,
+                    HttpHandler handler) {
+  if (routeCount >= HTTP_MAX_ROUTES)
+    return;
+  Route &r = routes[routeCount++];
+  r.method = method;
+  r.path = path;
+  r.handler = handler;
+  r.upload = nullptr;
+}
+
+void HttpServer::onUpload(const char *path, HttpUploadHandler &handler) {
+  if (routeCount >= HTTP_MAX_ROUTES)
+    return;
+  Route &r = routes[routeCount++];
+  r.method = HTTP_METHOD_POST;
+  r.path = path;
+  r.handler = nullptr;
+  r.upload = &handler;
+}
+
+// Строка запроса — POST на upload-маршрут? Тогда тело не обязано
+// помещаться в буфер приёма
+bool HttpServer::isUpload(const char *rx, size_t len) const {
+  if (len < 5 || strncmp(rx, "POST ", 5) != 0)
+    return false;
+  for (int i = 0; i < routeCount; ++i) {
+    if (!routes[i].upload)
+      continue;
+    size_t n = strlen(routes[i].path);
+    if (5 + n < len && strncmp(rx + 5, routes[i].path, n) == 0 &&
+        (rx[5 + n] == ' ' || rx[5 + n] == '?'))
+      return true;
+  }
+  return false;
+}
+
+bool HttpServer::begin() {
+  listenFd = socket(AF_INET, SOCK_STREAM, 0);
+  if (listenFd < 0)
+    return false;
+  int one = 1;
+  setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(cfg.port);
+  socklen_t addrLen = sizeof(addr);
+  if (bind(listenFd, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+      listen(listenFd, HTTP_MAX_CONNS) < 0 ||
+      getsockname(listenFd, (struct sockaddr *)&addr, &addrLen) < 0) {
+    ::close(listenFd);
+    listenFd = -1;
+    return false;
+  }
+  setNonBlocking(listenFd);
+  boundPort = ntohs(addr.sin_port);
+  return true;
+}
+
+void HttpServer::end() {
+  for (HttpConn &c : conns)
+    drop(c);
+  if (listenFd >= 0)
+    ::close(listenFd);
+  listenFd = -1;
+}
+
+int HttpServer::connectionCount() const {
+  int n = 0;
+  for (const HttpConn &c : conns)
+    n += c.fd >= 0;
+  return n;
+}
+
+int HttpServer::streamCount() const {
+  int n = 0;
+  for (const HttpConn &c : conns)
+    n += c.fd >= 0 && c.state == CONN_STREAM;
+  return n;
+}
+
+static const char *const METHOD_NAMES[] = {"GET", "POST", "OTHER"};
+
+void HttpServer::writeMetrics(PromWriter &w) const {
+  char labels[96];
+  w.family("http_request_duration_seconds", "histogram",
+           "Handler time per route");
+  for (int i = 0; i < routeCount; ++i) {
+    snprintf(labels, sizeof(labels), "method=\"%s\",path=\"%s\"",
+             METHOD_NAMES[routes[i].method], routes[i].path);
+    routes[i].latency.write(w, "http_request_duration_seconds", labels);
+  }
+  otherLatency.write(w, "http_request_duration_seconds",
+                     "method=\"OTHER\",path=\"other\"");
+  w.family("http_requests_total", "counter", "Requests handled");
+  w.sample("http_requests_total", "", requests);
+  w.family("http_timeouts_total", "counter", "Connections closed on timeout");
+  w.sample("http_timeouts_total", "", timeouts);
+  w.family("http_connections", "gauge", "Open connections and streams");
+  w.sample("http_connections", "kind=\"all\"", (uint32_t)connectionCount());
+  w.sample("http_connections", "kind=\"stream\"", (uint32_t)streamCount());
+}
+
+void HttpServer::drop(HttpConn &c) {
+  if (c.state == CONN_UPLOAD && c.upload)
+    c.upload->abort();
+  c.upload = nullptr;
+  c.remaining = 0;
+  c.uploadFailed = false;
+  c.producer = nullptr;
+  if (c.fd >= 0)
+    ::close(c.fd);
+  c.fd = -1;
+  c.state = CONN_FREE;
+  c.rxLen = c.txLen = c.txSent = 0;
+  c.body = nullptr;
+  c.bodyLen = c.bodySent = 0;
+}
+
+void HttpServer::acceptConns(uint32_t now) {
+  for (HttpConn &c : conns) {
+    if (c.fd >= 0)
+      continue;
+    int fd = ::accept(listenFd, nullptr, nullptr);
+    if (fd < 0)
+      return;
+    setNonBlocking(fd);
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    c.fd = fd;
+    c.state = CONN_READ;
+    c.keepAlive = true;
+    c.deadline = now + cfg.requestTimeoutMs;
+  }
+}
+
+void HttpServer::receive(HttpConn &c, uint32_t now) {
+  char sink[64];
+  char *dst = sink;
+  size_t space = sizeof(sink); // поток: входящие данные не нужны
+  if (c.state != CONN_STREAM) {
+    dst = c.rx + c.rxLen;
+    space = sizeof(c.rx) - 1 - c.rxLen;
+    if (!space)
+      return;
+  }
+  ssize_t n = recv(c.fd, dst, space, 0);
+  if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+    drop(c);
+    return;
+  }
+  if (n < 0 || c.state == CONN_STREAM)
+    return;
+  if (c.rxLen == 0 && c.state == CONN_READ)
+    c.deadline = now + cfg.requestTimeoutMs; // отсчёт с первого байта
+  if (c.state == CONN_UPLOAD)
+    c.deadline = now + cfg.requestTimeoutMs; // таймаут паузы, не всего тела
+  c.rxLen += n;
+}
+
+// Разбор одного запроса из буфера и вызов обработчика.
+// false — запрос ещё не пришёл целиком
+bool HttpServer::dispatch(HttpConn &c, uint32_t now) {
+  HttpResponse res(*this, c);
+  long hdrLen = findHeaderEnd(c.rx, c.rxLen);
+  if (hdrLen < 0) {
+    if (c.rxLen < sizeof(c.rx) - 1)
+      return false;
+    c.keepAlive = false;
+    res.respond(431, "text/plain", "Headers too large");
+    return true;
+  }
+  long bodyLen = contentLength(c.rx, hdrLen);
+  bool upload = isUpload(c.rx, hdrLen);
+  size_t total = hdrLen + (bodyLen > 0 && !upload ? bodyLen : 0);
+  if (bodyLen < 0 || total > sizeof(c.rx) - 1) {
+    c.keepAlive = false;
+    res.respond(413, "text/plain", "Body too large");
+    return true;
+  }
+  if (c.rxLen < total)
+    return false;
+
+  // Разбор на месте; байт за запросом (начало следующего) сохраняем
+  char next = c.rx[total];
+  c.rx[total] = 0;
+  c.rx[hdrLen - 2] = 0;
+  HttpRequest req;
+  req.body = c.rx + hdrLen;
+  req.bodyLen = total - hdrLen;
+
+  char *line = c.rx;
+  char *eol = strstr(line, "\r\n");
+  *eol = 0;
+  char *method = line;
+  char *target = strchr(method, ' ');
+  char *version = target ? strchr(target + 1, ' ') : nullptr;
+  if (!version) {
+    c.keepAlive = false;
+    res.respond(400, "text/plain", "Bad request");
+  } else {
+    *target++ = 0;
+    *version++ = 0;
+    req.method = strcmp(method, "GET") == 0    ? HTTP_METHOD_GET
+                 : strcmp(method, "POST") == 0 ? HTTP_METHOD_POST
+                                               : HTTP_METHOD_OTHER;
+    c.keepAlive = strcmp(version, "HTTP/1.1") == 0;
+
+    for (line = eol + 2; *line; line = eol + 2) {
+      eol = strstr(line, "\r\n");
+      *eol = 0;
+      char *colon = strchr(line, ':');
+      if (!colon || req.headers == HTTP_MAX_HEADERS)
+        continue;
+      *colon++ = 0;
+      while (*colon == ' ' || *colon == '\t')
+        ++colon;
+      req.hdrName[req.headers] = line;
+      req.hdrValue[req.headers++] = colon;
+    }
+    const char *conn = req.header("Connection");
+    if (strcasecmp(conn, "close") == 0)
+      c.keepAlive = false;
+    else if (strcasecmp(conn, "keep-alive") == 0)
+      c.keepAlive = true;
+
+    char *query = strchr(target, '?');
+    if (query) {
+      *query++ = 0;
+      while (*query && req.args < HTTP_MAX_ARGS) {
+        char *amp = strchr(query, '&');
+        if (amp)
+          *amp = 0;
+        char *eq = strchr(query, '=');
+        if (eq)
+          *eq++ = 0;
+        urlDecode(query);
+        if (eq)
+          urlDecode(eq);
+        req.argName[req.args] = query;
+        req.argValue[req.args++] = eq ? eq : (char *)"";
+        if (!amp)
+          break;
+        query = amp + 1;
+      }
+    }
+    urlDecode(target);
+    req.path = target;
+
+    Route *route = nullptr;
+    bool pathKnown = false;
+    for (int i = 0; i < routeCount && !route; ++i) {
+      if (strcmp(routes[i].path, target) != 0)
+        continue;
+      pathKnown = true;
+      if (routes[i].method == req.method)
+        route = &routes[i];
+    }
+    LatencyTimer timer(route ? route->latency : otherLatency);
+    if (route && route->upload) {
+      if (!upload) // путь в %-кодировке: тело уже отрезано как обычное
+        res.respond(400, "text/plain", "Bad upload path");
+      else
+        route->upload->begin(req, bodyLen > 0 ? bodyLen : 0, res);
+      if (res.sent()) {
+        c.keepAlive = false; // отказ: тело не читаем
+      } else {
+        c.upload = route->upload;
+        c.remaining = bodyLen > 0 ? bodyLen : 0;
+        c.uploadFailed = false;
+        c.state = CONN_UPLOAD;
+      }
+    } else if (route) {
+      route->handler(req, res);
+    } else if (pathKnown) {
+      res.respond(405, "text/plain", "Method not allowed");
+    } else if (notFound) {
+      notFound(req, res);
+    } else {
+      res.respond(404, "text/plain", "Not found");
+    }
+    if (c.state != CONN_UPLOAD) { // ответ upload — в uploadBody()
+      if (!res.sent())
+        res.respond(500, "text/plain", "No response");
+      ++requests;
+    }
+  }
+  if (c.fd < 0) // append() не дождался клиента — соединение закрыто
+    return true;
+
+  c.rx[total] = next;
+  c.rxLen -= total;
+  memmove(c.rx, c.rx + total, c.rxLen);
+  c.deadline = now + cfg.requestTimeoutMs; // на отправку ответа
+  return true;
+}
+
+// Принятая часть тела — в обработчик; в конце тела — его ответ.
+// false — ждём следующих данных
+bool HttpServer::uploadBody(HttpConn &c, uint32_t now) {
+  size_t n = c.rxLen < c.remaining ? c.rxLen : c.remaining;
+  if (n && !c.uploadFailed && !c.upload->data((const uint8_t *)c.rx, n))
+    c.uploadFailed = true;
+  c.remaining -= n;
+  c.rxLen -= n;
+  memmove(c.rx, c.rx + n, c.rxLen);
+  if (c.remaining && !c.uploadFailed)
+    return false;
+
+  HttpUploadHandler *handler = c.upload;
+  c.upload = nullptr;
+  if (c.uploadFailed)
+    c.keepAlive = false; // остаток тела не читаем
+  HttpResponse res(*this, c);
+  handler->end(res);
+  if (!res.sent())
+    res.respond(500, "text/plain", "No response");
+  ++requests;
+  c.deadline = now + cfg.requestTimeoutMs;
+  return true;
+}
+
+// Неблокирующая отправка; false — соединение разорвано
+bool HttpServer::flush(HttpConn &c) {
+  while (pending(c)) {
+    const char *p;
+    size_t n;
+    if (c.txSent < c.txLen) {
+      p = c.tx + c.txSent;
+      n = c.txLen - c.txSent;
+    } else {
+      p = (const char *)c.body + c.bodySent;
+      n = c.bodyLen - c.bodySent;
+    }
+    ssize_t sent = send(c.fd, p, n, MSG_NOSIGNAL);
+    if (sent < 0)
+      return errno == EAGAIN || errno == EWOULDBLOCK;
+    if (c.txSent < c.txLen)
+      c.txSent += sent;
+    else
+      c.bodySent += sent;
+  }
+  c.txLen = c.txSent = 0;
+  c.body = nullptr;
+  c.bodyLen = c.bodySent = 0;
+  return true;
+}
+
+// Отправка с коротким ожиданием (append() при заполненном буфере)
+bool HttpServer::flushWait(HttpConn &c, uint32_t timeoutMs) {
+  uint32_t deadline = msNow() + timeoutMs;
+  while (true) {
+    if (!flush(c))
+      return false;
+    if (!pending(c))
+      return true;
+    uint32_t now = msNow();
+    if (expired(now, deadline))
+      return false;
+    fd_set wr;
+    FD_ZERO(&wr);
+    FD_SET(c.fd, &wr);
+    struct timeval tv = {0, (long)(deadline - now) * 1000};
+    tv.tv_sec = tv.tv_usec / 1000000;
+    tv.tv_usec %= 1000000;
+    select(c.fd + 1, nullptr, &wr, nullptr, &tv);
+  }
+}
+
+void HttpServer::produce(HttpConn &c) {
+  HttpResponse res(*this, c);
+  res.started = true;
+  if (!c.producer(res, c.producerState))
+    c.producer = nullptr;
+}
+
+int HttpServer::broadcast(const char *data, size_t len) {
+  int n = 0;
+  for (HttpConn &c : conns) {
+    if (c.fd < 0 || c.state != CONN_STREAM)
+      continue;
+    if (c.txSent) {
+      c.txLen -= c.txSent;
+      memmove(c.tx, c.tx + c.txSent, c.txLen);
+      c.txSent = 0;
+    }
+    if (sizeof(c.tx) - c.txLen < len) {
+      drop(c); // клиент не успевает — не копим очередь
+      continue;
+    }
+    memcpy(c.tx + c.txLen, data, len);
+    c.txLen += len;
+    if (flush(c))
+      ++n;
+    else
+      drop(c);
+  }
+  return n;
+}
+
+void HttpServer::loop(uint32_t waitMs) {
+  fd_set rd, wr;
+  FD_ZERO(&rd);
+  FD_ZERO(&wr);
+  int maxFd = -1;
+  if (listenFd >= 0 && connectionCount() < HTTP_MAX_CONNS) {
+    FD_SET(listenFd, &rd);
+    maxFd = listenFd;
+  }
+  for (HttpConn &c : conns) {
+    if (c.fd < 0)
+      continue;
+    if (c.state == CONN_STREAM || c.rxLen < sizeof(c.rx) - 1)
+      FD_SET(c.fd, &rd);
+    if (pending(c) || c.producer)
+      FD_SET(c.fd, &wr);
+    if (c.fd > maxFd)
+      maxFd = c.fd;
+  }
+  struct timeval tv = {(long)(waitMs / 1000), (long)(waitMs % 1000) * 1000};
+  int ready = maxFd >= 0 ? select(maxFd + 1, &rd, &wr, nullptr, &tv) : 0;
+  if (ready < 0) {
+    FD_ZERO(&rd);
+    FD_ZERO(&wr);
+  }
+  uint32_t now = msNow();
+  if (listenFd >= 0 && FD_ISSET(listenFd, &rd))
+    acceptConns(now);
+
+  for (HttpConn &c : conns) {
+    if (c.fd >= 0 && FD_ISSET(c.fd, &rd))
+      receive(c, now);
+    // Ответ, следующий запрос из буфера (keep-alive, конвейер), снова ответ
+    while (c.fd >= 0) {
+      if (c.state == CONN_READ && !dispatch(c, now))
+        break;
+      if (c.state == CONN_UPLOAD && !uploadBody(c, now))
+        break;
+      if (c.producer && !pending(c)) {
+        produce(c); // одна порция за шаг: остальные соединения не ждут
+        c.deadline = now + cfg.requestTimeoutMs; // таймаут паузы клиента
+      }
+      if (!flush(c)) {
+        drop(c);
+        break;
+      }
+      if (pending(c) || c.producer || c.state != CONN_WRITE)
+        break;
+      if (!c.keepAlive) {
+        drop(c);
+        break;
+      }
+      c.state = CONN_READ;
+      c.deadline = now + (c.rxLen ? cfg.requestTimeoutMs : cfg.idleTimeoutMs);
+    }
+    if (c.fd >= 0 && c.state != CONN_STREAM && expired(now, c.deadline)) {
+      drop(c);
+      ++timeouts;
+    }
+  }
+}
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Metrics.h"
+
+// Событийный HTTP/1.1 сервер на BSD-сокетах (lwIP на ESP32, POSIX на ПК).
+// Один шаг loop() обслуживает все соединения через select(): медленный
+// клиент не держит остальных (длинные ответы — генератором, который
+// loop() продолжает, когда клиент забрал порцию), keep-alive и
+// конвейерные запросы поддерживаются, у каждого соединения свой таймаут.
+// Память только статическая: буферы приёма/передачи на соединение.
+// Все методы вызываются из одной задачи (задачи веб-сервера).
+
+const int HTTP_MAX_CONNS = 6;     // одновременных соединений
+const int HTTP_MAX_ROUTES = 16;
+const int HTTP_MAX_ARGS = 12;     // параметров в query-строке
+const int HTTP_MAX_HEADERS = 12;  // заголовков запроса
+const size_t HTTP_RX_BUF = 1024;  // строка запроса + заголовки + тело
+const size_t HTTP_TX_BUF = 2048;  // заголовки ответа + тело (кроме static)
+const size_t HTTP_EXTRA_HDR = 192; // доп. заголовки ответа
+const size_t HTTP_PRODUCER_STATE = 32; // курсор генератора ответа
+const uint32_t HTTP_APPEND_WAIT_MS = 5; // append(): ожидание клиента
+
+enum HttpMethod {
+  HTTP_METHOD_GET = 0,
+  HTTP_METHOD_POST = 1,
+  HTTP_METHOD_OTHER = 2,
+};
+
+struct HttpServerConfig {
+  uint16_t port;
+  uint32_t idleTimeoutMs;    // keep-alive без запросов
+  uint32_t requestTimeoutMs; // приём запроса / отправка ответа
+};
+
+const HttpServerConfig DEFAULT_HTTP_SERVER = {80, 5000, 2000};
+
+class HttpServer;
+class HttpResponse;
+struct HttpConn;
+
+// Генератор длинного ответа: дописывает порцию в res, false — конец
+typedef bool (*HttpProducer)(HttpResponse &res, void *state);
+
+// Разобранный запрос: строки указывают в буфер приёма соединения
+// и живут до выхода из обработчика
+class HttpRequest {
+public:
+  HttpMethod method = HTTP_METHOD_OTHER;
+  const char *path = "";
+  const char *body = "";
+  size_t bodyLen = 0;
+
+  bool hasArg(const char *name) const;
+  const char *arg(const char *name) const;       // "" если нет
+  const char *header(const char *name) const;    // без учёта регистра
+
+private:
+  friend class HttpServer;
+  const char *argName[HTTP_MAX_ARGS];
+  const char *argValue[HTTP_MAX_ARGS];
+  int args = 0;
+  const char *hdrName[HTTP_MAX_HEADERS];
+  const char *hdrValue[HTTP_MAX_HEADERS];
+  int headers = 0;
+};
+
+// Ответ пишется в буфер передачи соединения и уходит из цикла loop()
+class HttpResponse {
+public:
+  void header(const char *name, const char *value);
+
+  // Тело копируется в буфер передачи (не больше HTTP_TX_BUF)
+  void respond(int code, const char *type = nullptr, const char *body = "");
+  void respond(int code, const char *type, const char *body, size_t len);
+  // Тело не копируется: данные во flash, живущие всё время работы
+  void respondStatic(int code, const char *type, const uint8_t *body,
+                     size_t len);
+
+  // Тело без длины: до закрытия соединения (списки, поток событий).
+  // append() при заполненном буфере ждёт клиента не дольше
+  // HTTP_APPEND_WAIT_MS, иначе закрывает соединение и возвращает false:
+  // годится для ответов, которые почти целиком ложатся в буфер сокета
+  void start(int code, const char *type);
+  bool append(const char *data, size_t len);
+  // Тело без длины частями, без ожидания клиента: fill() вызывается
+  // сразу и затем из loop() каждый раз, когда буфер передачи ушёл.
+  // Внутри fill() append() не ждёт: порция больше room() не пишется
+  // (false). state — курсор генератора, копируется в соединение
+  void produce(int code, const char *type, HttpProducer fill,
+               const void *state, size_t len);
+  size_t room() const;
+  // Оставить соединение открытым для HttpServer::broadcast() (SSE)
+  void keepOpen();
+
+  bool sent() const { return started; }
+
+private:
+  friend class HttpServer;
+  HttpResponse(HttpServer &server, HttpConn &conn)
+      : server(server), conn(conn) {}
+  bool head(int code, const char *type, long len);
+
+  HttpServer &server;
+  HttpConn &conn;
+  char extra[HTTP_EXTRA_HDR];
+  size_t extraLen = 0;
+  bool started = false;
+};
+
+typedef void (*HttpHandler)(HttpRequest &req, HttpResponse &res);
+
+// POST с телом больше буфера приёма (прошивка): тело отдаётся кусками по
+// мере прихода, целиком в памяти не бывает. begin() — после заголовков
+// (req без тела, живёт до выхода из begin); отказ — ответить в res, тело
+// тогда не читается и соединение закрывается. Затем data() на каждый
+// кусок (false — прервать приём) и end() с ответом: тело принято целиком
+// или data() отказал. Обрыв и таймаут — abort() без ответа
+class HttpUploadHandler {
+public:
+  virtual ~HttpUploadHandler() {}
+  virtual void begin(HttpRequest &req, size_t len, HttpResponse &res) = 0;
+  virtual bool data(const uint8_t *chunk, size_t len) = 0;
+  virtual void end(HttpResponse &res) = 0;
+  virtual void abort() = 0;
+};
+
+// Внутреннее состояние соединения (в заголовке — ради статического размера)
+struct HttpConn {
+  int fd = -1;
+  uint8_t state = 0;
+  bool keepAlive = false;
+  uint32_t deadline = 0;
+  size_t rxLen = 0;
+  size_t txLen = 0, txSent = 0;
+  const uint8_t *body = nullptr; // тело respondStatic()
+  size_t bodyLen = 0, bodySent = 0;
+  HttpUploadHandler *upload = nullptr; // приём тела по частям
+  size_t remaining = 0;                // байт тела ещё не принято
+  bool uploadFailed = false;
+  HttpProducer producer = nullptr; // ответ генератором
+  alignas(8) uint8_t producerState[HTTP_PRODUCER_STATE];
+  char rx[HTTP_RX_BUF];
+  char tx[HTTP_TX_BUF];
+};
+
+class HttpServer {
+public:
+  explicit HttpServer(const HttpServerConfig &cfg = DEFAULT_HTTP_SERVER);
+  ~HttpServer();
+
+  void on(HttpMethod method, const char *path, HttpHandler handler);
+  void onNotFound(HttpHandler handler) { notFound = handler; }
+  // POST path с потоковым телом (HttpUploadHandler)
+  void onUpload(const char *path, HttpUploadHandler &handler);
+
+  bool begin(); // false — не удалось открыть порт
+  void end();
+  uint16_t port() const { return boundPort; } // для порта 0 — выданный
+
+  // Один шаг цикла событий: ждёт активности не дольше waitMs
+  void loop(uint32_t waitMs);
+
+  // Отправить данные всем открытым потокам (keepOpen); поток, который
+  // не успевает забирать данные, закрывается. Возвращает число получателей
+  int broadcast(const char *data, size_t len);
+  int streamCount() const;
+  int connectionCount() const;
+
+  uint32_t requests = 0; // обработано запросов
+  uint32_t timeouts = 0; // закрыто по таймауту
+
+  // Время обработчиков по маршрутам (потоковые — вместе с отправкой),
+  // счётчики и соединения — в формате Prometheus
+  void writeMetrics(PromWriter &w) const;
+
+private:
+  friend class HttpResponse;
+  void acceptConns(uint32_t now);
+  void receive(HttpConn &c, uint32_t now);
+  bool dispatch(HttpConn &c, uint32_t now);
+  bool uploadBody(HttpConn &c, uint32_t now);
+  bool isUpload(const char *rx, size_t len) const;
+  bool flush(HttpConn &c);
+  bool flushWait(HttpConn &c, uint32_t timeoutMs);
+  void produce(HttpConn &c);
+  void drop(HttpConn &c);
+
+  HttpServerConfig cfg;
+  int listenFd = -1;
+  uint16_t boundPort = 0;
+  struct Route {
+    HttpMethod method;
+    const char *path;
+    HttpHandler handler;
+    HttpUploadHandler *upload;
+    LatencyHistogram latency;
+  } routes[HTTP_MAX_ROUTES];
+  int routeCount = 0;
+  LatencyHistogram otherLatency; // 404, 405, notFound
+  HttpHandler notFound = nullptr;
+  HttpConn conns[HTTP_MAX_CONNS];
+};
@@ -0,0 +1,181 @@
+#include "JsonWriter.h"
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+JsonWriter::JsonWriter(char *buf, size_t cap, JsonFlushFn flush, void *ctx)
+    : buf(buf), cap(cap), flush(flush), ctx(ctx) {
+  first[0] = true;
+}
+
+void JsonWriter::put(char c) {
+  // Последний байт буфера оставляем под завершающий ноль
+  if (len + 1 >= cap) {
+    if (!flush) {
+      lost = true;
+      return;
+    }
+    flush(buf, len, ctx);
+    flushed += len;
+    len = 0;
+  }
+  buf[len++] = c;
+}
+
+void JsonWriter::raw(const char *s, size_t n) {
+  for (size_t i = 0; i < n; i++)
+    put(s[i]);
+}
+
+// Самое длинное число — float около ±3.4e38 с JSON_MAX_DECIMALS знаками
+// после точки (50 символов); обрезанное число в JSON не пишется
+void JsonWriter::number(const char *fmt, ...) {
+  char tmp[64];
+  va_list args;
+  va_start(args, fmt);
+  int n = vsnprintf(tmp, sizeof(tmp), fmt, args);
+  va_end(args);
+  if (n < 0 || (size_t)n >= sizeof(tmp))
+    lost = true;
+  else
+    raw(tmp, n);
+}
+
+// Запятая перед элементом (кроме первого и значения после ключа)
+void JsonWriter::separator() {
+  if (afterKey) {
+    afterKey = false;
+    return;
+  }
+  if (!first[depth])
+    put(',');
+  first[depth] = false;
+}
+
+JsonWriter &JsonWriter::beginObject() {
+  separator();
+  put('{');
+  if (depth < JSON_MAX_DEPTH)
+    first[++depth] = true;
+  return *this;
+}
+
+JsonWriter &JsonWriter::endObject() {
+  put('}');
+  if (depth > 0)
+    depth--;
+  return *this;
+}
+
+JsonWriter &JsonWriter::beginArray() {
+  separator();
+  put('[');
+  if (depth < JSON_MAX_DEPTH)
+    first[++depth] = true;
+  return *this;
+}
+
+JsonWriter &JsonWriter::endArray() {
+  put(']');
+  if (depth > 0)
+    depth--;
+  return *this;
+}
+
+JsonWriter &JsonWriter::key(const char *name) {
+  value(name);
+  put(':');
+  afterKey = true;
+  return *this;
+}
+
+JsonWriter &JsonWriter::value(const char *str) {
+  separator();
+  put('"');
+  for (const char *p = str; *p; p++) {
+    unsigned char c = *p;
+    if (c == '"' || c == '\\') {
+      put('\\');
+      put(c);
+    } else if (c < 0x20) {
+      number("\\u%04x", c);
+    } else {
+      put(c);
+    }
+  }
+  put('"');
+  return *this;
+}
+
+JsonWriter &JsonWriter::value(int v) {
+  separator();
+  number("%d", v);
+  return *this;
+}
+
+JsonWriter &JsonWriter::value(unsigned v) {
+  separator();
+  number("%u", v);
+  return *this;
+}
+
+JsonWriter &JsonWriter::value(long v) {
+  separator();
+  number("%ld", v);
+  return *this;
+}
+
+JsonWriter &JsonWriter::value(unsigned long v) {
+  separator();
+  number("%lu", v);
+  return *this;
+}
+
+JsonWriter &JsonWriter::value(long long v) {
+  separator();
+  number("%lld", v);
+  return *this;
+}
+
+JsonWriter &JsonWriter::value(unsigned long long v) {
+  separator();
+  number("%llu", v);
+  return *this;
+}
+
+JsonWriter &JsonWriter::value(float v, int decimals) {
+  separator();
+  if (decimals < 0)
+    decimals = 0;
+  if (decimals > JSON_MAX_DECIMALS)
+    decimals = JSON_MAX_DECIMALS;
+  if (isnan(v) || isinf(v))
+    raw("null", 4);
+  else
+    number("%.*f", decimals, (double)v);
+  return *this;
+}
+
+JsonWriter &JsonWriter::value(bool v) {
+  separator();
+  if (v)
+    raw("true", 4);
+  else
+    raw("false", 5);
+  return *this;
+}
+
+const char *JsonWriter::c_str() {
+  buf[len] = 0;
+  return buf;
+}
+
+void JsonWriter::finish() {
+  if (flush && len) {
+    flush(buf, len, ctx);
+    flushed += len;
+    len = 0;
+  }
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Потоковая запись JSON в фиксированный буфер без выделения памяти.
+// Запятые и вложенность расставляются автоматически. Если задан flush,
+// заполненный буфер отдаётся ему (например, server.sendContent() для
+// chunked-ответа) и запись продолжается с начала; без flush лишнее
+// отбрасывается и выставляется overflow().
+
+typedef void (*JsonFlushFn)(const char *data, size_t len, void *ctx);
+
+const int JSON_MAX_DEPTH = 8;
+const int JSON_MAX_DECIMALS = 9; // больше float всё равно не хранит
+
+class JsonWriter {
+public:
+  JsonWriter(char *buf, size_t cap, JsonFlushFn flush = nullptr,
+             void *ctx = nullptr);
+
+  JsonWriter &beginObject();
+  JsonWriter &endObject();
+  JsonWriter &beginArray();
+  JsonWriter &endArray();
+  JsonWriter &key(const char *name);
+
+  JsonWriter &value(const char *str);
+  JsonWriter &value(int v);
+  JsonWriter &value(unsigned v);
+  JsonWriter &value(long v);
+  JsonWriter &value(unsigned long v);
+  JsonWriter &value(long long v);
+  JsonWriter &value(unsigned long long v);
+  JsonWriter &value(float v, int decimals = 2);
+  JsonWriter &value(bool v);
+
+  // Пара "ключ": значение внутри объекта
+  template <typename T> JsonWriter &field(const char *name, T v) {
+    return key(name).value(v);
+  }
+  JsonWriter &field(const char *name, float v, int decimals) {
+    return key(name).value(v, decimals);
+  }
+
+  const char *c_str(); // завершает строку нулём
+  size_t length() const { return len; }
+  size_t written() const { return flushed + len; }
+  bool overflow() const { return lost; }
+  void finish(); // отдать остаток в flush
+
+private:
+  void separator();
+  void raw(const char *s, size_t n);
+  void put(char c);
+  void number(const char *fmt, ...);
+
+  char *buf;
+  size_t cap;
+  size_t len = 0;
+  size_t flushed = 0;
+  JsonFlushFn flush;
+  void *ctx;
+  bool lost = false;
+  bool afterKey = false;
+  int depth = 0;
+  bool first[JSON_MAX_DEPTH + 1];
+};
@@ -0,0 +1,92 @@
+#include "Metrics.h"
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <time.h>
+
+// 50 мкс .. 100 мс: от цикла движения до медленного обработчика HTTP
+const uint32_t LATENCY_BOUNDS_US[LATENCY_BUCKETS - 1] = {
+    50, 100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000};
+
+uint32_t metricsMicros() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)ts.tv_sec * 1000000u + (uint32_t)(ts.tv_nsec / 1000);
+}
+
+void PromWriter::format(const char *fmt, ...) {
+  for (int attempt = 0; attempt < 2; ++attempt) {
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(buf + len, cap - len, fmt, ap);
+    va_end(ap);
+    if (n < 0)
+      return;
+    if ((size_t)n < cap - len) {
+      len += n;
+      return;
+    }
+    // Строка не влезла: отдаём накопленное и пробуем с начала буфера
+    if (!flush || len == 0)
+      break;
+    flush(buf, len, ctx);
+    len = 0;
+  }
+  buf[len] = 0;
+  lost = true;
+}
+
+void PromWriter::family(const char *name, const char *type,
+                        const char *help) {
+  format("# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+}
+
+void PromWriter::sample(const char *name, const char *labels, double value) {
+  format(*labels ? "%s{%s} %.9g\n" : "%s%s %.9g\n", name, labels, value);
+}
+
+void PromWriter::sample(const char *name, const char *labels,
+                        uint32_t value) {
+  format(*labels ? "%s{%s} %u\n" : "%s%s %u\n", name, labels,
+         (unsigned)value);
+}
+
+const char *PromWriter::c_str() {
+  buf[len < cap ? len : cap - 1] = 0;
+  return buf;
+}
+
+void PromWriter::finish() {
+  if (flush && len) {
+    flush(buf, len, ctx);
+    len = 0;
+  }
+}
+
+#if TRACKER_METRICS
+double LatencyHistogram::sumSeconds() const {
+  return sumS.load(std::memory_order_relaxed) +
+         sumUs.load(std::memory_order_relaxed) / 1e6;
+}
+
+void LatencyHistogram::write(PromWriter &w, const char *name,
+                             const char *labels) const {
+  char metric[64], lab[96];
+  snprintf(metric, sizeof(metric), "%s_bucket", name);
+  const char *sep = *labels ? "," : "";
+  uint32_t cumulative = 0;
+  for (int i = 0; i < LATENCY_BUCKETS; ++i) {
+    cumulative += bucket[i].load(std::memory_order_relaxed);
+    if (i < LATENCY_BUCKETS - 1)
+      snprintf(lab, sizeof(lab), "%s%sle=\"%g\"", labels, sep,
+               LATENCY_BOUNDS_US[i] / 1e6);
+    else
+      snprintf(lab, sizeof(lab), "%s%sle=\"+Inf\"", labels, sep);
+    w.sample(metric, lab, cumulative);
+  }
+  snprintf(metric, sizeof(metric), "%s_sum", name);
+  w.sample(metric, labels, sumSeconds());
+  snprintf(metric, sizeof(metric), "%s_count", name);
+  w.sample(metric, labels, cumulative);
+}
+#endif
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "JsonWriter.h" // JsonFlushFn
+
+// Метрики горячих путей в текстовом формате Prometheus (/api/metrics).
+// Гистограмма латентности — фиксированные корзины, запись O(число корзин)
+// без блокировок: у каждой гистограммы один пишущий (задача или поток
+// обработки HTTP), читатель может увидеть запись, сделанную наполовину, —
+// для метрик это допустимо. С -DTRACKER_METRICS=0 запись и таймеры
+// становятся пустыми, а /api/metrics не регистрируется.
+
+#ifndef TRACKER_METRICS
+#define TRACKER_METRICS 1
+#endif
+
+const int LATENCY_BUCKETS = 12; // последняя — +Inf
+extern const uint32_t LATENCY_BOUNDS_US[LATENCY_BUCKETS - 1];
+
+// Монотонные микросекунды (clock_gettime, как у HttpServer)
+uint32_t metricsMicros();
+
+// Текст Prometheus в фиксированный буфер; flush — как у JsonWriter
+class PromWriter {
+public:
+  PromWriter(char *buf, size_t cap, JsonFlushFn flush = nullptr,
+             void *ctx = nullptr)
+      : buf(buf), cap(cap), flush(flush), ctx(ctx) {}
+
+  // # HELP + # TYPE (gauge, counter, histogram) — один раз на семейство
+  void family(const char *name, const char *type, const char *help);
+  // name{labels} value; labels без скобок ("task=\"web\""), может быть ""
+  void sample(const char *name, const char *labels, double value);
+  void sample(const char *name, const char *labels, uint32_t value);
+
+  const char *c_str(); // завершает строку нулём
+  bool overflow() const { return lost; }
+  void finish(); // отдать остаток в flush
+
+private:
+  void format(const char *fmt, ...);
+
+  char *buf;
+  size_t cap;
+  size_t len = 0;
+  JsonFlushFn flush;
+  void *ctx;
+  bool lost = false;
+};
+
+class LatencyHistogram {
+public:
+#if TRACKER_METRICS
+  void record(uint32_t us) {
+    int i = 0;
+    while (i < LATENCY_BUCKETS - 1 && us > LATENCY_BOUNDS_US[i])
+      ++i;
+    bump(bucket[i], 1);
+    bump(n, 1);
+    // Сумма — секунды + остаток в мкс: не переполняется за время работы
+    uint32_t u = sumUs.load(std::memory_order_relaxed) + us;
+    if (u >= 1000000) {
+      bump(sumS, u / 1000000);
+      u %= 1000000;
+    }
+    sumUs.store(u, std::memory_order_relaxed);
+    if (us > maxUs.load(std::memory_order_relaxed))
+      maxUs.store(us, std::memory_order_relaxed);
+  }
+
+  uint32_t count() const { return n.load(std::memory_order_relaxed); }
+  uint32_t max() const { return maxUs.load(std::memory_order_relaxed); }
+  double sumSeconds() const;
+  // Корзины name_bucket{labels,le=...}, name_sum, name_count
+  void write(PromWriter &w, const char *name, const char *labels) const;
+
+private:
+  // Один пишущий: без атомарного сложения (дорогого на Xtensa)
+  static void bump(std::atomic<uint32_t> &a, uint32_t d) {
+    a.store(a.load(std::memory_order_relaxed) + d, std::memory_order_relaxed);
+  }
+
+  std::atomic<uint32_t> bucket[LATENCY_BUCKETS] = {};
+  std::atomic<uint32_t> n{0};
+  std::atomic<uint32_t> sumS{0};
+  std::atomic<uint32_t> sumUs{0};
+  std::atomic<uint32_t> maxUs{0};
+#else
+  // Выключено: ни памяти, ни кода
+  void record(uint32_t) {}
+  uint32_t count() const { return 0; }
+  uint32_t max() const { return 0; }
+  double sumSeconds() const { return 0; }
+  void write(PromWriter &, const char *, const char *) const {}
+#endif
+};
+
+// Замер области видимости: { LatencyTimer t(hist); ... }
+class LatencyTimer {
+public:
+#if TRACKER_METRICS
+  explicit LatencyTimer(LatencyHistogram &h) : h(h), start(metricsMicros()) {}
+  ~LatencyTimer() { h.record(metricsMicros() - start); }
+
+private:
+  LatencyHistogram &h;
+  uint32_t start;
+#else
+  explicit LatencyTimer(LatencyHistogram &) {}
+#endif
+};
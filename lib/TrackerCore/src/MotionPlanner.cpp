@@ -0,0 +1,102 @@
+#include "MotionPlanner.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+MotionPlanner::MotionPlanner(HalActuator &servos, int startHor, int startVer)
+    : servos(servos) {
+  reset(startHor, startVer);
+}
+
+void MotionPlanner::moveTo(int hor, int ver) {
+  target[AXIS_HOR].store(hor);
+  target[AXIS_VER].store(ver);
+  busy.store(true);
+}
+
+void MotionPlanner::power(bool on) { wantPower.store(on); }
+
+void MotionPlanner::reset(int hor, int ver) {
+  int start[AXIS_COUNT] = {hor, ver};
+  for (int i = 0; i < AXIS_COUNT; i++) {
+    axis[i].pos = start[i] / (float)ANGLE_SCALE;
+    axis[i].vel = 0;
+    sent[i] = start[i];
+    target[i].store(start[i]);
+    pos[i].store(angleToDeg(start[i]));
+  }
+  busy.store(false);
+}
+
+// Один шаг трапециевидного профиля. Возвращает true, пока ось в движении.
+bool MotionPlanner::stepAxis(int i, float dt) {
+  Axis &a = axis[i];
+  const AxisLimits &lim = limits[i];
+  float goal = target[i].load() / (float)ANGLE_SCALE;
+  float err = goal - a.pos;
+  if (fabsf(err) < 0.01f && fabsf(a.vel) < lim.aMax * dt) {
+    a.pos = goal;
+    a.vel = 0;
+    return false;
+  }
+
+  float dir = err > 0 ? 1.0f : -1.0f;
+  float stopDist = a.vel * a.vel / (2.0f * lim.aMax);
+  if (a.vel * dir < 0 || stopDist < fabsf(err))
+    a.vel += dir * lim.aMax * dt; // разгон (или разворот к цели)
+  else
+    a.vel -= (a.vel > 0 ? 1.0f : -1.0f) * lim.aMax * dt; // торможение
+
+  if (a.vel > lim.vMax)
+    a.vel = lim.vMax;
+  else if (a.vel < -lim.vMax)
+    a.vel = -lim.vMax;
+
+  a.pos += a.vel * dt;
+
+  // Проскочили цель на малой скорости — встаём точно в неё
+  if ((goal - a.pos) * dir < 0) {
+    a.pos = goal;
+    a.vel = 0;
+    return false;
+  }
+  return true;
+}
+
+void MotionPlanner::step(uint32_t dtMs) {
+  bool on = wantPower.load();
+  bool attachedNow = false;
+  if (on != powered) {
+    if (on)
+      servos.attach();
+    else
+      servos.detach();
+    powered = on;
+    attachedNow = on;
+  }
+
+  float dt = dtMs / 1000.0f;
+  bool active = false;
+  // После attach серво встаёт в положение по умолчанию — сразу
+  // возвращаем его в известную планировщику позицию
+  bool due = attachedNow;
+  int band = servos.deadBand();
+  int fine[AXIS_COUNT];
+  for (int i = 0; i < AXIS_COUNT; i++) {
+    bool axisMoving = stepAxis(i, dt);
+    active |= axisMoving;
+    fine[i] = lroundf(axis[i].pos * ANGLE_SCALE);
+    pos[i].store(angleToDeg(fine[i]));
+    // В движении — по зоне, остановка — точно в цель
+    int d = abs(fine[i] - sent[i]);
+    due |= d && (!axisMoving || d >= band);
+  }
+
+  if (powered && due) {
+    servos.write(fine[AXIS_HOR], fine[AXIS_VER]);
+    sent[AXIS_HOR] = fine[AXIS_HOR];
+    sent[AXIS_VER] = fine[AXIS_VER];
+    writes++;
+  }
+  busy.store(active);
+}
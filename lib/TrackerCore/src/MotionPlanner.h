@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+
+#include "TrackerHal.h"
+
+// Неблокирующий планировщик движения сервоприводов.
+// Вызывающие (setServos, демо, выход из ночи) только публикуют цель через
+// moveTo() и сразу возвращаются. Сам поворот выполняет step(), который
+// вызывается периодически из отдельной задачи (TaskMotion): обе оси
+// движутся одновременно по трапециевидному профилю скорости
+// с ограничением скорости и ускорения на каждую ось.
+//
+// Цель и положение — в долях градуса (ANGLE_SCALE). В движении положение
+// уходит в серво, только когда отошло от записанного на зону
+// нечувствительности исполнительного слоя (HalActuator::deadBand());
+// при остановке ось всегда пишется точно в цель.
+//
+// moveTo()/power() можно звать из любой задачи (атомарные поля),
+// step() — только из одной задачи движения.
+
+enum { AXIS_HOR = 0, AXIS_VER = 1, AXIS_COUNT = 2 };
+
+struct AxisLimits {
+  float vMax; // град/с
+  float aMax; // град/с^2
+};
+
+const AxisLimits DEFAULT_AXIS_LIMITS = {30.0, 60.0};
+const uint32_t MOTION_PERIOD_MS = 20; // период PWM серво (50 Гц)
+
+class MotionPlanner {
+public:
+  // Углы здесь и в moveTo()/reset() — 1/ANGLE_SCALE градуса
+  explicit MotionPlanner(HalActuator &servos, int startHor = degToAngle(90),
+                         int startVer = degToAngle(90));
+
+  void moveTo(int hor, int ver);
+  void power(bool on); // подача (attach) / снятие (detach) питания
+  // Известное положение без движения (после сна): до запуска step()
+  void reset(int hor, int ver);
+
+  void step(uint32_t dtMs);
+
+  bool moving() const { return busy.load(); } // обновляется каждым step()
+  int hor() const { return pos[AXIS_HOR].load(); }
+  int ver() const { return pos[AXIS_VER].load(); }
+
+  AxisLimits limits[AXIS_COUNT] = {DEFAULT_AXIS_LIMITS, DEFAULT_AXIS_LIMITS};
+  long writes = 0; // записей в серво (для тестов и метрик)
+
+private:
+  struct Axis {
+    float pos;
+    float vel;
+  };
+
+  bool stepAxis(int i, float dt);
+
+  HalActuator &servos;
+  Axis axis[AXIS_COUNT];
+  int sent[AXIS_COUNT]; // последняя запись в серво, 1/ANGLE_SCALE градуса
+  std::atomic<int> target[AXIS_COUNT]; // 1/ANGLE_SCALE градуса
+  std::atomic<int> pos[AXIS_COUNT];    // градусы
+  std::atomic<bool> wantPower{false};
+  std::atomic<bool> busy{false};
+  bool powered = false;
+};
@@ -0,0 +1,362 @@
+#include "MqttClient.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0 // lwIP не шлёт SIGPIPE
+#endif
+
+// Типы пакетов (старшая тетрада первого байта)
+enum {
+  PKT_CONNECT = 0x10,
+  PKT_CONNACK = 0x20,
+  PKT_PUBLISH = 0x30,
+  PKT_PUBACK = 0x40,
+  PKT_PINGREQ = 0xC0,
+  PKT_PINGRESP = 0xD0,
+  PKT_DISCONNECT = 0xE0,
+};
+
+static bool expired(uint32_t now, uint32_t deadline) {
+  return (int32_t)(now - deadline) >= 0;
+}
+
+// Запись пакета в буфер: заголовок с переменной длиной, затем поля
+class Packet {
+public:
+  Packet(uint8_t *buf, size_t cap) : buf(buf), cap(cap) {}
+
+  void str(const char *s) { bytes(s, strlen(s), true); }
+  void u16(uint16_t v) {
+    u8(v >> 8);
+    u8(v & 0xFF);
+  }
+  void u8(uint8_t v) {
+    if (len < cap)
+      buf[len] = v;
+    ++len;
+  }
+  void bytes(const void *p, size_t n, bool prefixed = false) {
+    if (prefixed)
+      u16(n);
+    if (n <= cap && len <= cap - n)
+      memcpy(buf + len, p, n);
+    len += n;
+  }
+  // Собрать: fixed header перед телом. 0 — не влезло
+  size_t finish(uint8_t type, uint8_t *out, size_t outCap) const {
+    uint8_t head[5];
+    size_t h = 0;
+    head[h++] = type;
+    size_t rem = len;
+    do {
+      uint8_t b = rem % 128;
+      rem /= 128;
+      head[h++] = rem ? b | 0x80 : b;
+    } while (rem && h < sizeof(head));
+    if (len > cap || h + len > outCap)
+      return 0;
+    memmove(out + h, buf, len);
+    memcpy(out, head, h);
+    return h + len;
+  }
+
+private:
+  uint8_t *buf;
+  size_t cap;
+  size_t len = 0;
+};
+
+MqttClient::~MqttClient() { end(); }
+
+void MqttClient::begin(const MqttClientConfig &c, uint32_t nowMs) {
+  end();
+  cfg = c;
+  backoffMs = MQTT_BACKOFF_MIN_MS;
+  nextTryAt = nowMs;
+}
+
+void MqttClient::end() {
+  if (fd >= 0 && st == MQTT_ONLINE) {
+    const uint8_t bye[2] = {PKT_DISCONNECT, 0};
+    send(fd, bye, sizeof(bye), MSG_NOSIGNAL);
+  }
+  if (fd >= 0)
+    ::close(fd);
+  fd = -1;
+  st = MQTT_OFF;
+  txLen = txSent = rxLen = 0;
+  inflightId = 0;
+}
+
+void MqttClient::drop(uint32_t nowMs) {
+  if (fd >= 0)
+    ::close(fd);
+  fd = -1;
+  st = MQTT_OFF;
+  txLen = txSent = rxLen = 0;
+  inflightId = 0; // неподтверждённое отправит заново владелец очереди
+  ++drops;
+  nextTryAt = nowMs + backoffMs;
+  backoffMs = backoffMs * 2 > MQTT_BACKOFF_MAX_MS ? MQTT_BACKOFF_MAX_MS
+                                                  : backoffMs * 2;
+}
+
+bool MqttClient::openSocket() {
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(cfg.port);
+  if (inet_pton(AF_INET, cfg.host, &addr.sin_addr) != 1) {
+    struct addrinfo hints, *res = nullptr;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(cfg.host, nullptr, &hints, &res) != 0 || !res)
+      return false;
+    addr.sin_addr = ((struct sockaddr_in *)res->ai_addr)->sin_addr;
+    freeaddrinfo(res);
+  }
+
+  fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0)
+    return false;
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+  int one = 1;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 &&
+      errno != EINPROGRESS)
+    return false;
+  return true;
+}
+
+bool MqttClient::queue(const uint8_t *data, size_t len) {
+  if (txSent) {
+    txLen -= txSent;
+    memmove(tx, tx + txSent, txLen);
+    txSent = 0;
+  }
+  if (len > sizeof(tx) - txLen)
+    return false;
+  memcpy(tx + txLen, data, len);
+  txLen += len;
+  return true;
+}
+
+// Неблокирующая отправка; false — соединение разорвано
+bool MqttClient::flush() {
+  while (txSent < txLen) {
+    ssize_t n = send(fd, tx + txSent, txLen - txSent, MSG_NOSIGNAL);
+    if (n < 0)
+      return errno == EAGAIN || errno == EWOULDBLOCK;
+    txSent += n;
+  }
+  txLen = txSent = 0;
+  return true;
+}
+
+bool MqttClient::sendConnect() {
+  uint8_t body[192], pkt[200];
+  Packet p(body, sizeof(body));
+  p.str("MQTT");
+  p.u8(4); // 3.1.1
+  uint8_t flags = 0x02; // clean session
+  if (cfg.willTopic)
+    flags |= 0x04 | 0x20; // will, retain, QoS 0
+  p.u8(flags);
+  p.u16(MQTT_KEEPALIVE_S);
+  p.str(cfg.clientId);
+  if (cfg.willTopic) {
+    p.str(cfg.willTopic);
+    p.str(cfg.willMessage);
+  }
+  size_t n = p.finish(PKT_CONNECT, pkt, sizeof(pkt));
+  return n && queue(pkt, n);
+}
+
+uint16_t MqttClient::publish(const char *topic, const char *payload,
+                             size_t len, uint32_t nowMs) {
+  if (!ready())
+    return 0;
+  uint16_t id = nextId++;
+  if (!nextId)
+    nextId = 1;
+  // Тело собирается прямо в свободной части буфера передачи
+  if (txSent) {
+    txLen -= txSent;
+    memmove(tx, tx + txSent, txLen);
+    txSent = 0;
+  }
+  uint8_t *out = tx + txLen;
+  size_t space = sizeof(tx) - txLen;
+  if (space < 5)
+    return 0;
+  Packet p(out + 5, space - 5);
+  p.str(topic);
+  p.u16(id);
+  p.bytes(payload, len);
+  size_t n = p.finish(PKT_PUBLISH | 0x02, out, space); // QoS 1
+  if (!n)
+    return 0;
+  txLen += n;
+  inflightId = id;
+  inflightAt = nowMs;
+  lastSend = nowMs;
+  ++published;
+  flush(); // ошибку заметит следующий poll()
+  return id;
+}
+
+bool MqttClient::publishRetained(const char *topic, const char *payload) {
+  if (!online())
+    return false;
+  uint8_t body[128], pkt[136];
+  Packet p(body, sizeof(body));
+  p.str(topic);
+  p.bytes(payload, strlen(payload));
+  size_t n = p.finish(PKT_PUBLISH | 0x01, pkt, sizeof(pkt)); // retain
+  return n && queue(pkt, n);
+}
+
+// Разбор ответов брокера; false — ошибка протокола или обрыв
+bool MqttClient::receive(uint32_t nowMs) {
+  while (true) {
+    ssize_t n = recv(fd, rx + rxLen, sizeof(rx) - rxLen, MSG_DONTWAIT);
+    if (n == 0)
+      return false;
+    if (n < 0) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK)
+        return false;
+      break;
+    }
+    rxLen += n;
+    lastRecv = nowMs;
+
+    size_t pos = 0;
+    while (rxLen - pos >= 2) {
+      // Длина — до 4 байт; входящие PUBLISH без подписок не ждём
+      size_t rem = 0, h = 1;
+      int shift = 0;
+      uint8_t b;
+      do {
+        if (pos + h >= rxLen)
+          goto more;
+        b = rx[pos + h++];
+        rem |= (size_t)(b & 0x7F) << shift;
+        shift += 7;
+      } while (b & 0x80 && h < 5);
+      if (h + rem > sizeof(rx))
+        return false; // длиннее буфера — не от нашего брокера
+      if (pos + h + rem > rxLen)
+        break;
+      const uint8_t *d = rx + pos + h;
+      switch (rx[pos] & 0xF0) {
+      case PKT_CONNACK:
+        if (rem < 2 || d[1] != 0)
+          return false; // брокер отказал
+        st = MQTT_ONLINE;
+        backoffMs = MQTT_BACKOFF_MIN_MS;
+        ++connects;
+        break;
+      case PKT_PUBACK:
+        if (rem >= 2) {
+          uint16_t id = d[0] << 8 | d[1];
+          if (id == inflightId) {
+            lastAck = id;
+            inflightId = 0;
+            ++acks;
+          }
+        }
+        break;
+      case PKT_PINGRESP:
+        pingSent = false;
+        break;
+      }
+      pos += h + rem;
+    }
+  more:
+    rxLen -= pos;
+    memmove(rx, rx + pos, rxLen);
+  }
+  return true;
+}
+
+void MqttClient::poll(uint32_t nowMs) {
+  if (!cfg.host)
+    return;
+  switch (st) {
+  case MQTT_OFF:
+    if (!expired(nowMs, nextTryAt))
+      return;
+    if (!openSocket()) {
+      drop(nowMs);
+      return;
+    }
+    st = MQTT_CONNECTING;
+    deadline = nowMs + MQTT_CONNECT_TIMEOUT_MS;
+    return;
+
+  case MQTT_CONNECTING: {
+    fd_set wr;
+    FD_ZERO(&wr);
+    FD_SET(fd, &wr);
+    struct timeval tv = {0, 0};
+    if (select(fd + 1, nullptr, &wr, nullptr, &tv) <= 0) {
+      if (expired(nowMs, deadline))
+        drop(nowMs);
+      return;
+    }
+    int err = 0;
+    socklen_t len = sizeof(err);
+    getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &len);
+    if (err || !sendConnect()) {
+      drop(nowMs);
+      return;
+    }
+    st = MQTT_HANDSHAKE;
+    deadline = nowMs + MQTT_CONNECT_TIMEOUT_MS;
+    lastSend = lastRecv = nowMs;
+    pingSent = false;
+    break;
+  }
+
+  case MQTT_HANDSHAKE:
+  case MQTT_ONLINE:
+    break;
+  }
+
+  if (!flush() || !receive(nowMs)) {
+    drop(nowMs);
+    return;
+  }
+  if (st == MQTT_HANDSHAKE) {
+    if (expired(nowMs, deadline))
+      drop(nowMs);
+    return;
+  }
+
+  // Брокер молчит дольше keep-alive или не подтверждает публикацию
+  if (expired(nowMs, lastRecv + MQTT_KEEPALIVE_S * 1500u) ||
+      (inflightId && expired(nowMs, inflightAt + MQTT_ACK_TIMEOUT_MS))) {
+    drop(nowMs);
+    return;
+  }
+  if (!pingSent && expired(nowMs, lastSend + MQTT_KEEPALIVE_S * 500u)) {
+    const uint8_t ping[2] = {PKT_PINGREQ, 0};
+    if (queue(ping, sizeof(ping))) {
+      pingSent = true;
+      lastSend = nowMs;
+    }
+  }
+  if (!flush())
+    drop(nowMs);
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Минимальный клиент MQTT 3.1.1 на BSD-сокетах (lwIP на ESP32, POSIX на
+// ПК): CONNECT с завещанием (LWT), PUBLISH QoS 0/1, PUBACK, PINGREQ.
+// Без подписок. Всё неблокирующее: poll() из цикла задачи подключается,
+// дописывает буфер передачи, разбирает ответы брокера и держит keep-alive.
+// Одновременно в полёте не больше одного PUBLISH QoS 1 — этим и задаётся
+// противодавление для очереди (MqttPublisher). Адрес брокера — IPv4 или
+// имя (getaddrinfo блокирует на время DNS-запроса, только при
+// подключении). Все методы вызываются из одной задачи.
+
+const size_t MQTT_TX_BUF = 2048; // самый большой пакет
+const size_t MQTT_RX_BUF = 64;   // ответы брокера короткие
+const uint16_t MQTT_KEEPALIVE_S = 60;
+const uint32_t MQTT_CONNECT_TIMEOUT_MS = 5000;
+const uint32_t MQTT_ACK_TIMEOUT_MS = 10000; // нет PUBACK — переподключение
+const uint32_t MQTT_BACKOFF_MIN_MS = 1000;
+const uint32_t MQTT_BACKOFF_MAX_MS = 30000;
+
+enum MqttState {
+  MQTT_OFF = 0,        // пауза перед подключением
+  MQTT_CONNECTING = 1, // TCP-подключение
+  MQTT_HANDSHAKE = 2,  // CONNECT отправлен, ждём CONNACK
+  MQTT_ONLINE = 3,
+};
+
+struct MqttClientConfig {
+  const char *host;
+  uint16_t port;
+  const char *clientId;
+  const char *willTopic;   // nullptr — без завещания
+  const char *willMessage; // публикуется брокером при обрыве (retain)
+};
+
+class MqttClient {
+public:
+  ~MqttClient();
+
+  void begin(const MqttClientConfig &cfg, uint32_t nowMs);
+  void end(); // DISCONNECT и закрытие
+  void poll(uint32_t nowMs);
+
+  MqttState state() const { return st; }
+  bool online() const { return st == MQTT_ONLINE; }
+  // Можно отдать следующий PUBLISH QoS 1 (нет неподтверждённого)
+  bool ready() const { return online() && !inflightId; }
+
+  // QoS 1: номер пакета или 0 (не подключены, есть неподтверждённый,
+  // не влезает в буфер). Подтверждение — acked(id)
+  uint16_t publish(const char *topic, const char *payload, size_t len,
+                   uint32_t nowMs);
+  // QoS 0, с флагом retain; false — некуда записать
+  bool publishRetained(const char *topic, const char *payload);
+  bool acked(uint16_t id) const { return id && id == lastAck; }
+
+  uint32_t connects = 0;
+  uint32_t drops = 0;     // обрывы и неудачные подключения
+  uint32_t published = 0; // PUBLISH QoS 1 отправлено
+  uint32_t acks = 0;
+
+private:
+  bool openSocket();
+  void drop(uint32_t nowMs);
+  bool queue(const uint8_t *data, size_t len);
+  bool flush();
+  bool receive(uint32_t nowMs);
+  bool sendConnect();
+
+  MqttClientConfig cfg = {};
+  int fd = -1;
+  MqttState st = MQTT_OFF;
+  uint32_t nextTryAt = 0;
+  uint32_t backoffMs = MQTT_BACKOFF_MIN_MS;
+  uint32_t deadline = 0;   // подключение / CONNACK
+  uint32_t lastSend = 0;   // для PINGREQ
+  uint32_t lastRecv = 0;
+  uint32_t inflightAt = 0;
+  uint16_t nextId = 1;
+  uint16_t inflightId = 0;
+  uint16_t lastAck = 0;
+  bool pingSent = false;
+  uint8_t tx[MQTT_TX_BUF];
+  size_t txLen = 0, txSent = 0;
+  uint8_t rx[MQTT_RX_BUF];
+  size_t rxLen = 0;
+};
@@ -0,0 +1,92 @@
+#include "MqttPublisher.h"
+
+#include <initializer_list>
+
+#include "JsonWriter.h"
+
+// Запись в JSON не длиннее этого; меньший остаток буфера закрывает пачку
+const size_t MQTT_RECORD_JSON = 64;
+
+MqttPublisher::MqttPublisher(MqttClient &client, const char *topic,
+                             const char *deviceId)
+    : client(client), topic(topic), deviceId(deviceId) {}
+
+void MqttPublisher::push(const MqttRecord &r) {
+  if (depth() == MQTT_QUEUE)
+    ++tail, ++dropped;
+  ring[head++ & (MQTT_QUEUE - 1)] = r;
+  if (depth() > maxDepth)
+    maxDepth = depth();
+}
+
+// {"id":..,"fields":[..],"data":[[t,volts,sunAz,sunAlt,hor,ver,wh,mode,
+// night],..]} — как /api/history, плюс выработка и режим
+size_t MqttPublisher::writeBatch(char *buf, size_t cap, int &count) const {
+  JsonWriter w(buf, cap);
+  w.beginObject().field("id", deviceId);
+  w.key("fields").beginArray();
+  for (const char *f : {"t", "volts", "sunAz", "sunAlt", "hor", "ver", "wh",
+                        "mode", "night"})
+    w.value(f);
+  w.endArray();
+  w.key("data").beginArray();
+  count = 0;
+  for (uint32_t i = tail; i != head && count < MQTT_BATCH; ++i, ++count) {
+    if (w.length() + MQTT_RECORD_JSON > cap)
+      break;
+    const MqttRecord &r = ring[i & (MQTT_QUEUE - 1)];
+    w.beginArray()
+        .value(r.s.t)
+        .value(r.s.voltsCenti / 100.0f, 2)
+        .value(r.s.sunAzDeci / 10.0f, 1)
+        .value(r.s.sunAltDeci / 10.0f, 1)
+        .value((int)r.s.hor)
+        .value((int)r.s.ver)
+        .value(r.whDeci / 10.0f, 1)
+        .value((int)r.mode)
+        .value((int)r.night)
+        .endArray();
+  }
+  w.endArray().endObject();
+  w.c_str();
+  return w.overflow() ? 0 : w.length();
+}
+
+void MqttPublisher::poll(uint32_t nowMs) {
+  client.poll(nowMs);
+
+  if (inflightId) {
+    if (client.acked(inflightId)) {
+      // Вытесненные за время полёта записи уже сняты с хвоста
+      if ((int32_t)(inflightEnd - tail) > 0)
+        tail = inflightEnd;
+      sent += inflightCount;
+      ++batches;
+      inflightId = 0;
+    } else if (client.ready()) {
+      inflightId = 0; // соединение оборвалось — отправим пачку заново
+      ++resent;
+    } else {
+      return;
+    }
+  }
+
+  // Возраст неполной пачки — от момента, когда очередь была пуста
+  if (!depth())
+    lastFlush = nowMs;
+  if (!client.ready() || !depth())
+    return;
+  if (depth() < (uint32_t)MQTT_BATCH && nowMs - lastFlush < MQTT_FLUSH_MS)
+    return;
+
+  char payload[MQTT_PAYLOAD];
+  int count;
+  size_t len = writeBatch(payload, sizeof(payload), count);
+  if (!len || !count)
+    return;
+  inflightId = client.publish(topic, payload, len, nowMs);
+  if (inflightId) {
+    inflightEnd = tail + count;
+    inflightCount = count;
+  }
+}
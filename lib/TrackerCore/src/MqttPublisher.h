@@ -0,0 +1,63 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "HistoryStore.h"
+#include "MqttClient.h"
+
+// Телеметрия в MQTT с буфером на время обрыва (store-and-forward).
+// push() кладёт запись в кольцо в RAM за O(1) и сразу возвращается;
+// переполненное кольцо теряет самые старые записи. poll() из цикла веб-задачи
+// собирает до MQTT_BATCH записей в одно сообщение JSON и публикует его
+// с QoS 1. Пока брокер не подтвердил пачку, следующая не уходит
+// (противодавление), после обрыва та же пачка отправляется заново —
+// порядок записей сохраняется, повторы возможны (at-least-once).
+// Все методы вызываются из одной задачи.
+
+const int MQTT_QUEUE = 512; // записей в RAM: ~85 мин при периоде 10 с
+const int MQTT_BATCH = 30;  // записей в сообщении
+const uint32_t MQTT_FLUSH_MS = 60000; // неполная пачка — не реже раза в мин
+const size_t MQTT_PAYLOAD = 1900;     // + топик и заголовок < MQTT_TX_BUF
+static_assert((MQTT_QUEUE & (MQTT_QUEUE - 1)) == 0,
+              "MQTT_QUEUE must be a power of two");
+
+// Точка истории + выработка за сегодня и режим
+struct MqttRecord {
+  HistorySample s;
+  uint16_t whDeci; // выработка за местные сутки, 0.1 Вт·ч
+  uint8_t mode;
+  uint8_t night;
+};
+static_assert(sizeof(MqttRecord) == 16, "MqttRecord must stay packed");
+
+class MqttPublisher {
+public:
+  // topic и deviceId должны жить не меньше издателя
+  MqttPublisher(MqttClient &client, const char *topic, const char *deviceId);
+
+  void push(const MqttRecord &r);
+  void poll(uint32_t nowMs); // заодно обслуживает соединение клиента
+
+  uint32_t depth() const { return head - tail; } // ждут подтверждения
+
+  uint32_t maxDepth = 0;
+  uint32_t dropped = 0; // вытеснено из полного кольца
+  uint32_t sent = 0;    // записей подтверждено брокером
+  uint32_t batches = 0;
+  uint32_t resent = 0;  // пачек, отправленных заново после обрыва
+
+private:
+  size_t writeBatch(char *buf, size_t cap, int &count) const;
+
+  MqttClient &client;
+  const char *topic;
+  const char *deviceId;
+  MqttRecord ring[MQTT_QUEUE];
+  uint32_t head = 0; // всего принято
+  uint32_t tail = 0; // всего подтверждено или вытеснено
+  uint16_t inflightId = 0;
+  uint32_t inflightEnd = 0; // head на момент отправки пачки
+  int inflightCount = 0;
+  uint32_t lastFlush = 0; // очередь была пуста
+};
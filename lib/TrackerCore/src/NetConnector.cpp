@@ -0,0 +1,64 @@
+#include "NetConnector.h"
+
+void NetConnector::begin(uint32_t nowMs, bool haveCredentials) {
+  credentials = haveCredentials;
+  st = NET_OFF;
+  failsInRow = 0;
+  backoffMs = NET_BACKOFF_MIN_MS;
+  nextTryAt = nowMs;
+}
+
+NetAction NetConnector::poll(uint32_t nowMs, bool linkUp) {
+  if (!credentials) {
+    if (ap)
+      return NET_NONE;
+    ap = true;
+    return NET_START_AP;
+  }
+
+  if (linkUp) {
+    if (st != NET_ONLINE) {
+      st = NET_ONLINE;
+      failsInRow = 0;
+      backoffMs = NET_BACKOFF_MIN_MS;
+      return NET_CONNECTED;
+    }
+    if (ap) {
+      ap = false;
+      return NET_STOP_AP;
+    }
+    return NET_NONE;
+  }
+
+  switch (st) {
+  case NET_ONLINE: // связь пропала — сразу пробуем снова
+    ++drops;
+    st = NET_OFF;
+    nextTryAt = nowMs;
+    return NET_NONE;
+
+  case NET_CONNECTING:
+    if (nowMs - attemptAt < NET_CONNECT_TIMEOUT_MS)
+      return NET_NONE;
+    ++failures;
+    ++failsInRow;
+    st = NET_OFF;
+    nextTryAt = nowMs + backoffMs;
+    backoffMs = backoffMs * 2 < NET_BACKOFF_MAX_MS ? backoffMs * 2
+                                                   : NET_BACKOFF_MAX_MS;
+    if (failsInRow >= NET_AP_AFTER_FAILS && !ap) {
+      ap = true;
+      return NET_START_AP;
+    }
+    return NET_NONE;
+
+  case NET_OFF:
+    if ((int32_t)(nowMs - nextTryAt) < 0)
+      return NET_NONE;
+    st = NET_CONNECTING;
+    attemptAt = nowMs;
+    ++attempts;
+    return NET_BEGIN;
+  }
+  return NET_NONE;
+}
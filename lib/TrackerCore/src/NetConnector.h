@@ -0,0 +1,54 @@
+#pragma once
+
+#include <stdint.h>
+
+// Фоновое подключение к Wi-Fi без блокировки загрузки.
+// Автомат вызывается из цикла веб-задачи и возвращает одно действие за
+// вызов, само обращение к WiFi выполняет main.cpp. Попытка подключения
+// ограничена NET_CONNECT_TIMEOUT_MS, между попытками пауза растёт вдвое
+// до NET_BACKOFF_MAX_MS. После NET_AP_AFTER_FAILS неудач поднимается точка
+// доступа для настройки, а попытки подключиться к сети продолжаются;
+// сохранённые SSID и пароль не стираются. Без SSID — сразу точка доступа.
+
+const uint32_t NET_CONNECT_TIMEOUT_MS = 10000;
+const uint32_t NET_BACKOFF_MIN_MS = 2000;
+const uint32_t NET_BACKOFF_MAX_MS = 60000;
+const int NET_AP_AFTER_FAILS = 3;
+
+enum NetState {
+  NET_OFF = 0,        // пауза перед следующей попыткой
+  NET_CONNECTING = 1, // WiFi.begin() выполнен, ждём связи
+  NET_ONLINE = 2,
+};
+
+enum NetAction {
+  NET_NONE = 0,
+  NET_BEGIN,     // начать подключение к сохранённой сети
+  NET_CONNECTED, // связь есть: синхронизировать время
+  NET_START_AP,  // поднять точку доступа
+  NET_STOP_AP,   // сеть доступна — точка доступа больше не нужна
+};
+
+class NetConnector {
+public:
+  // Начать заново (старт, новые SSID/пароль). Поднятая точка доступа
+  // остаётся до подключения к сети
+  void begin(uint32_t nowMs, bool haveCredentials);
+  NetAction poll(uint32_t nowMs, bool linkUp);
+
+  NetState state() const { return st; }
+  bool apActive() const { return ap; }
+
+  uint32_t attempts = 0; // вызовов WiFi.begin()
+  uint32_t failures = 0; // попыток, не дождавшихся связи
+  uint32_t drops = 0;    // потерь связи после подключения
+
+private:
+  NetState st = NET_OFF;
+  bool credentials = false;
+  bool ap = false;
+  int failsInRow = 0;
+  uint32_t backoffMs = NET_BACKOFF_MIN_MS;
+  uint32_t attemptAt = 0;
+  uint32_t nextTryAt = 0;
+};
@@ -0,0 +1,38 @@
+#include "NightPlanner.h"
+
+time_t nextSunrise(HalSun &sun, const Config &cfg, time_t now) {
+  float az, alt;
+  sun.position(cfg, now, az, alt);
+  if (alt > 0)
+    return now;
+
+  // Грубо вперёд до первого отсчёта над горизонтом, затем делением пополам
+  time_t lo = now;
+  for (time_t t = now + NIGHT_SEARCH_STEP_S; t <= now + NIGHT_SEARCH_SPAN_S;
+       t += NIGHT_SEARCH_STEP_S) {
+    sun.position(cfg, t, az, alt);
+    if (alt <= 0) {
+      lo = t;
+      continue;
+    }
+    time_t hi = t;
+    while (hi - lo > 1) {
+      time_t mid = lo + (hi - lo) / 2;
+      sun.position(cfg, mid, az, alt);
+      (alt > 0 ? hi : lo) = mid;
+    }
+    return hi;
+  }
+  return 0;
+}
+
+uint32_t nightSleepSeconds(time_t now, time_t sunrise) {
+  int64_t left = sunrise ? (int64_t)(sunrise - now) - NIGHT_WAKE_LEAD_S
+                         : (int64_t)NIGHT_MAX_SLEEP_S;
+  if (left < (int64_t)NIGHT_MIN_SLEEP_S)
+    return 0;
+  uint32_t chunk = left < NIGHT_MAX_SLEEP_S ? left : NIGHT_MAX_SLEEP_S;
+  // RTC может спешить или отставать: последний отрезок кончится не позже
+  // (sunrise - lead) даже при уходе на NIGHT_RTC_DRIFT_PCT
+  return chunk - chunk * NIGHT_RTC_DRIFT_PCT / 100;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <stdint.h>
+#include <time.h>
+
+#include "TrackerHal.h"
+
+// Ночной сон контроллера.
+// При заходе Солнца трекер один раз ищет ближайший восход по эфемеридам,
+// после чего main.cpp усыпляет ESP32 (light или deep sleep) с пробуждением
+// по RTC-таймеру. Сон режется на отрезки до NIGHT_MAX_SLEEP_S: RC-генератор
+// RTC уходит на единицы процентов, а каждое пробуждение сверяет часы по NTP.
+// Последний отрезок кончается за NIGHT_WAKE_LEAD_S до восхода — успеть
+// подключиться к Wi-Fi и повернуть панель к утреннему Солнцу.
+
+enum NightSleepMode {
+  NIGHT_SLEEP_OFF = 0,   // только снять питание серво (как раньше)
+  NIGHT_SLEEP_LIGHT = 1, // RAM и задачи сохраняются, Wi-Fi выключен
+  NIGHT_SLEEP_DEEP = 2,  // перезагрузка при пробуждении, состояние в RTC
+};
+
+const uint32_t NIGHT_WAKE_LEAD_S = 300;   // проснуться до восхода
+const uint32_t NIGHT_MIN_SLEEP_S = 600;   // короче — не засыпаем
+const uint32_t NIGHT_MAX_SLEEP_S = 7200;  // отрезок между сверками часов
+const uint32_t NIGHT_RTC_DRIFT_PCT = 5;   // запас на уход RTC
+const uint32_t NIGHT_SEARCH_STEP_S = 600; // шаг поиска восхода
+const uint32_t NIGHT_SEARCH_SPAN_S = 2 * 86400;
+
+// Ближайший момент после now, когда высота Солнца станет > 0, с точностью
+// до секунды; 0 — восхода нет в ближайшие двое суток (полярная ночь)
+time_t nextSunrise(HalSun &sun, const Config &cfg, time_t now);
+
+// Сколько спать сейчас (0 — не спать): до восхода без запаса на
+// пробуждение, не больше отрезка и с поправкой на уход RTC
+uint32_t nightSleepSeconds(time_t now, time_t sunrise);
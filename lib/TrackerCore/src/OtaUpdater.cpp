@@ -0,0 +1,187 @@
+#include "OtaUpdater.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "JsonWriter.h"
+
+const char *otaStatusText(OtaStatus s) {
+  switch (s) {
+  case OTA_OK: return "ok";
+  case OTA_BUSY: return "busy";
+  case OTA_BAD_REQUEST: return "bad request";
+  case OTA_TOO_LARGE: return "too large";
+  case OTA_UNAUTHORIZED: return "unauthorized";
+  case OTA_BAD_IMAGE: return "bad image";
+  case OTA_FLASH_ERROR: return "flash error";
+  case OTA_INCOMPLETE: return "incomplete";
+  case OTA_CHECKSUM: return "checksum mismatch";
+  }
+  return "";
+}
+
+// Сравнение за постоянное время: подпись не подбирается по таймингу
+static bool sameDigest(const uint8_t *a, const uint8_t *b) {
+  uint8_t d = 0;
+  for (size_t i = 0; i < SHA256_SIZE; ++i)
+    d |= a[i] ^ b[i];
+  return d == 0;
+}
+
+OtaUpdater::OtaUpdater(HalOtaPartition &part, const uint8_t *key,
+                       size_t keyLen)
+    : part(part), key(key), keyLen(keyLen) {}
+
+OtaStatus OtaUpdater::fail(OtaStatus s) {
+  running = false;
+  return last = s;
+}
+
+OtaStatus OtaUpdater::begin(size_t len, const char *sha256Hex,
+                            const char *signatureHex) {
+  if (running)
+    return last = OTA_BUSY;
+  uint8_t sig[SHA256_SIZE], mac[SHA256_SIZE];
+  if (!len || !sha256FromHex(sha256Hex, expect) ||
+      !sha256FromHex(signatureHex, sig))
+    return fail(OTA_BAD_REQUEST);
+  if (!keyLen)
+    return fail(OTA_UNAUTHORIZED);
+  hmacSha256(key, keyLen, expect, SHA256_SIZE, mac);
+  if (!sameDigest(sig, mac))
+    return fail(OTA_UNAUTHORIZED);
+  if (len > part.size())
+    return fail(OTA_TOO_LARGE);
+
+  size = len;
+  offset = bufLen = 0;
+  running = true;
+  return last = OTA_OK;
+}
+
+OtaStatus OtaUpdater::flushSector() {
+  if (!part.erase(offset, OTA_SECTOR) || !part.write(offset, buf, bufLen))
+    return fail(OTA_FLASH_ERROR);
+  offset += bufLen;
+  bufLen = 0;
+  ++sectors;
+  return OTA_OK;
+}
+
+OtaStatus OtaUpdater::write(const uint8_t *data, size_t len) {
+  if (!running)
+    return last;
+  if (received() + len > size)
+    return fail(OTA_TOO_LARGE);
+  if (received() == 0 && len && data[0] != OTA_IMAGE_MAGIC)
+    return fail(OTA_BAD_IMAGE);
+  while (len) {
+    size_t n = OTA_SECTOR - bufLen < len ? OTA_SECTOR - bufLen : len;
+    memcpy(buf + bufLen, data, n);
+    bufLen += n;
+    data += n;
+    len -= n;
+    if (bufLen == OTA_SECTOR && flushSector() != OTA_OK)
+      return last;
+  }
+  return OTA_OK;
+}
+
+OtaStatus OtaUpdater::finish() {
+  if (!running)
+    return last;
+  if (received() != size)
+    return fail(OTA_INCOMPLETE);
+  if (bufLen && flushSector() != OTA_OK)
+    return last;
+
+  // Контрольная сумма — по тому, что действительно лежит на flash
+  Sha256 sha;
+  for (size_t at = 0; at < size; at += OTA_SECTOR) {
+    size_t n = size - at < OTA_SECTOR ? size - at : OTA_SECTOR;
+    if (!part.read(at, buf, n))
+      return fail(OTA_FLASH_ERROR);
+    sha.update(buf, n);
+  }
+  uint8_t got[SHA256_SIZE];
+  sha.finish(got);
+  if (!sameDigest(got, expect))
+    return fail(OTA_CHECKSUM);
+  if (!part.activate())
+    return fail(OTA_FLASH_ERROR);
+  ++updates;
+  return fail(OTA_OK);
+}
+
+void OtaUpdater::abort() {
+  if (running)
+    fail(OTA_INCOMPLETE);
+}
+
+// ================= OtaUploadHandler =================
+void OtaUploadHandler::respond(HttpResponse &res, OtaStatus s) {
+  static const int codes[] = {200, 409, 400, 413, 401, 400, 500, 400, 400};
+  char buf[96];
+  JsonWriter w(buf, sizeof(buf));
+  w.beginObject()
+      .field("ok", s == OTA_OK)
+      .field("status", otaStatusText(s))
+      .field("bytes", (unsigned long)ota.received())
+      .endObject();
+  res.respond(codes[s], "application/json", w.c_str());
+}
+
+void OtaUploadHandler::begin(HttpRequest &req, size_t len,
+                             HttpResponse &res) {
+  status = ota.begin(len, req.header("X-Firmware-SHA256"),
+                     req.header("X-Firmware-Signature"));
+  if (status != OTA_OK)
+    respond(res, status);
+}
+
+bool OtaUploadHandler::data(const uint8_t *chunk, size_t len) {
+  status = ota.write(chunk, len);
+  return status == OTA_OK;
+}
+
+void OtaUploadHandler::end(HttpResponse &res) {
+  if (status == OTA_OK)
+    status = ota.finish();
+  else
+    ota.abort();
+  done = status == OTA_OK;
+  respond(res, status);
+}
+
+// ================= OtaBootGuard =================
+void OtaBootGuard::load() {
+  if (kv.get("ota", &rec, sizeof(rec)) != sizeof(rec))
+    rec = {0, 0};
+}
+
+void OtaBootGuard::store() { kv.put("ota", &rec, sizeof(rec)); }
+
+void OtaBootGuard::armed() {
+  rec = {1, 0};
+  store();
+}
+
+OtaBootAction OtaBootGuard::boot() {
+  load();
+  if (!rec.pending)
+    return OTA_BOOT_NORMAL;
+  if (++rec.attempts > OTA_TRIAL_BOOTS) {
+    rec = {0, 0};
+    store();
+    return OTA_BOOT_ROLLBACK;
+  }
+  store();
+  return OTA_BOOT_TRIAL;
+}
+
+void OtaBootGuard::confirm() {
+  if (!rec.pending)
+    return;
+  rec = {0, 0};
+  store();
+}
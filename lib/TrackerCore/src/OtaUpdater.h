@@ -0,0 +1,123 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "HttpServer.h"
+#include "Sha256.h"
+#include "TrackerHal.h"
+
+// Обновление прошивки по сети (OTA) потоком в неактивный раздел.
+// Заголовки запроса: Content-Length — размер образа, X-Firmware-SHA256 —
+// его SHA-256 (hex), X-Firmware-Signature — HMAC-SHA256(ключ устройства,
+// SHA-256 образа) (hex). Подпись проверяется до стирания flash: без ключа
+// раздел не трогается. Данные копятся в буфер сектора (4 КБ), полный
+// сектор стирается и пишется — образ целиком в RAM не бывает. В конце
+// SHA-256 считается по прочитанному из раздела (ловит и ошибки передачи,
+// и ошибки flash), и только тогда раздел становится загрузочным.
+// Все методы вызываются из одной задачи (веб).
+
+const size_t OTA_SECTOR = 4096;
+const uint8_t OTA_IMAGE_MAGIC = 0xE9; // первый байт образа приложения ESP32
+
+enum OtaStatus {
+  OTA_OK = 0,
+  OTA_BUSY = 1,         // уже идёт загрузка
+  OTA_BAD_REQUEST = 2,  // нет размера, SHA-256 или подписи
+  OTA_TOO_LARGE = 3,    // больше раздела
+  OTA_UNAUTHORIZED = 4, // подпись не сходится или ключ не задан
+  OTA_BAD_IMAGE = 5,    // не образ приложения
+  OTA_FLASH_ERROR = 6,
+  OTA_INCOMPLETE = 7,   // тело короче заявленного
+  OTA_CHECKSUM = 8,     // SHA-256 записанного не совпал
+};
+
+const char *otaStatusText(OtaStatus s);
+
+class OtaUpdater {
+public:
+  // key — секрет устройства для подписи; пустой — OTA выключено
+  OtaUpdater(HalOtaPartition &part, const uint8_t *key, size_t keyLen);
+
+  OtaStatus begin(size_t size, const char *sha256Hex,
+                  const char *signatureHex);
+  OtaStatus write(const uint8_t *data, size_t len);
+  OtaStatus finish(); // проверка записанного и activate()
+  void abort();
+
+  bool active() const { return running; }
+  size_t received() const { return offset + bufLen; }
+
+  uint32_t sectors = 0; // стёрто и записано
+  uint32_t updates = 0; // успешных обновлений
+  OtaStatus last = OTA_OK;
+
+private:
+  OtaStatus flushSector();
+  OtaStatus fail(OtaStatus s);
+
+  HalOtaPartition &part;
+  const uint8_t *key;
+  size_t keyLen;
+  bool running = false;
+  size_t size = 0;
+  size_t offset = 0; // записано на flash
+  uint8_t expect[SHA256_SIZE];
+  uint8_t buf[OTA_SECTOR];
+  size_t bufLen = 0;
+};
+
+// POST /api/ota: OtaUpdater за HttpServer, ответ — JSON
+// {"ok":..,"status":"..","bytes":..}
+class OtaUploadHandler : public HttpUploadHandler {
+public:
+  explicit OtaUploadHandler(OtaUpdater &ota) : ota(ota) {}
+
+  void begin(HttpRequest &req, size_t len, HttpResponse &res) override;
+  bool data(const uint8_t *chunk, size_t len) override;
+  void end(HttpResponse &res) override;
+  void abort() override { ota.abort(); }
+
+  bool done = false; // раздел активирован — пора перезагружаться
+
+private:
+  void respond(HttpResponse &res, OtaStatus s);
+
+  OtaUpdater &ota;
+  OtaStatus status = OTA_OK;
+};
+
+// Пробный запуск новой прошивки. После activate() — armed(); при каждом
+// старте boot() считает попытки. Прошивка, которая за OTA_TRIAL_BOOTS
+// запусков не вызвала confirm() (не дошла до рабочего состояния,
+// падает или виснет под сторожевым таймером), получает
+// OTA_BOOT_ROLLBACK — вызывающий возвращает прежний раздел.
+// Состояние — запись "ota" в HalKeyValue (NVS)
+enum OtaBootAction {
+  OTA_BOOT_NORMAL = 0,
+  OTA_BOOT_TRIAL = 1,
+  OTA_BOOT_ROLLBACK = 2,
+};
+
+const uint8_t OTA_TRIAL_BOOTS = 3;
+
+class OtaBootGuard {
+public:
+  explicit OtaBootGuard(HalKeyValue &kv) : kv(kv) {}
+
+  void armed();
+  OtaBootAction boot();
+  void confirm();
+  bool pending() const { return rec.pending; }
+  uint8_t attempts() const { return rec.attempts; }
+
+private:
+  void load();
+  void store();
+
+  HalKeyValue &kv;
+  struct {
+    uint8_t pending;
+    uint8_t attempts;
+  } rec = {0, 0};
+};
@@ -0,0 +1,80 @@
+#include "ScanCache.h"
+
+#include <string.h>
+
+static const char *const STATE_NAMES[] = {"idle", "running", "ready",
+                                          "failed"};
+
+bool ScanCache::needsScan(uint32_t nowMs, bool force) const {
+  if (st == SCAN_RUNNING)
+    return nowMs - startedAt >= SCAN_TIMEOUT_MS;
+  return force || !haveResult || nowMs - resultAt >= ttlMs;
+}
+
+void ScanCache::started(uint32_t nowMs) {
+  st = SCAN_RUNNING;
+  startedAt = nowMs;
+}
+
+void ScanCache::add(const char *ssid, int rssi, uint8_t channel, bool open) {
+  if (!ssid[0])
+    return; // скрытая сеть
+
+  // Тот же SSID уже есть: оставляем более сильную точку
+  int pos = -1;
+  for (int i = 0; i < count; ++i)
+    if (strncmp(nets[i].ssid, ssid, sizeof(nets[i].ssid) - 1) == 0) {
+      if (nets[i].rssi >= rssi)
+        return;
+      pos = i;
+      break;
+    }
+  if (pos < 0) {
+    if (count == SCAN_MAX_NETWORKS) {
+      if (nets[count - 1].rssi >= rssi)
+        return; // слабее всех в заполненном списке
+      pos = count - 1;
+    } else {
+      pos = count++;
+    }
+  }
+
+  // Вставка с сохранением порядка по убыванию RSSI
+  while (pos > 0 && nets[pos - 1].rssi < rssi) {
+    nets[pos] = nets[pos - 1];
+    --pos;
+  }
+  ScanNetwork &n = nets[pos];
+  strncpy(n.ssid, ssid, sizeof(n.ssid) - 1);
+  n.ssid[sizeof(n.ssid) - 1] = 0;
+  n.rssi = rssi < -128 ? -128 : rssi > 127 ? 127 : rssi;
+  n.channel = channel;
+  n.open = open;
+}
+
+void ScanCache::done(uint32_t nowMs) {
+  st = SCAN_READY;
+  haveResult = true;
+  resultAt = nowMs;
+}
+
+void ScanCache::failed(uint32_t nowMs) {
+  st = haveResult ? SCAN_READY : SCAN_FAILED;
+  if (!haveResult)
+    resultAt = nowMs;
+}
+
+void ScanCache::write(JsonWriter &w, uint32_t nowMs) const {
+  w.beginObject()
+      .field("state", STATE_NAMES[st])
+      .field("age", haveResult ? (long)((nowMs - resultAt) / 1000) : -1L);
+  w.key("networks").beginArray();
+  for (int i = 0; i < count; ++i)
+    w.beginObject()
+        .field("ssid", nets[i].ssid)
+        .field("rssi", (int)nets[i].rssi)
+        .field("ch", (int)nets[i].channel)
+        .field("open", nets[i].open)
+        .endObject();
+  w.endArray().endObject();
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "JsonWriter.h"
+
+// Кэш результатов сканирования Wi-Fi.
+// Сканирование запускается в фоне (WiFi.scanNetworks(true)), /api/scan
+// сразу отдаёт последний результат и состояние. Сети с одинаковым SSID
+// (mesh, несколько точек) схлопываются в самую сильную, скрытые
+// пропускаются, список хранится отсортированным по RSSI — браузеру
+// остаётся только вывести его. Вызывается из одной задачи (веб).
+
+const int SCAN_MAX_NETWORKS = 20;
+const uint32_t SCAN_TTL_MS = 30000; // старше — при запросе сканируем снова
+const uint32_t SCAN_TIMEOUT_MS = 15000; // зависшее сканирование — заново
+
+enum ScanState {
+  SCAN_IDLE = 0,    // ещё не сканировали
+  SCAN_RUNNING = 1, // идёт фоновое сканирование
+  SCAN_READY = 2,   // есть результат
+  SCAN_FAILED = 3,  // последнее сканирование не удалось
+};
+
+struct ScanNetwork {
+  char ssid[33];
+  int8_t rssi;
+  uint8_t channel;
+  bool open; // без пароля
+};
+
+class ScanCache {
+public:
+  explicit ScanCache(uint32_t ttlMs = SCAN_TTL_MS) : ttlMs(ttlMs) {}
+
+  // Нужно ли запускать сканирование (не идёт или зависло, результат устарел)
+  bool needsScan(uint32_t nowMs, bool force = false) const;
+  void started(uint32_t nowMs);
+
+  // Результат фонового сканирования: clear(), add() по всем сетям, done()
+  void clear() { count = 0; }
+  void add(const char *ssid, int rssi, uint8_t channel, bool open);
+  void done(uint32_t nowMs);
+  void failed(uint32_t nowMs);
+
+  ScanState state() const { return st; }
+  int size() const { return count; }
+  const ScanNetwork &operator[](int i) const { return nets[i]; }
+
+  // {"state":"ready","age":12,"networks":[{"ssid":..,"rssi":..,...}]}
+  void write(JsonWriter &w, uint32_t nowMs) const;
+
+private:
+  uint32_t ttlMs;
+  ScanState st = SCAN_IDLE;
+  bool haveResult = false;
+  uint32_t resultAt = 0;  // время последнего результата
+  uint32_t startedAt = 0;
+  ScanNetwork nets[SCAN_MAX_NETWORKS];
+  int count = 0;
+};
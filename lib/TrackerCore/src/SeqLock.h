@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+#include <string.h>
+
+// Seqlock для небольших POD-структур (снимки телеметрии).
+// Писатель никогда не ждёт читателей; читатель повторяет копирование,
+// если попал на запись (нечётный или изменившийся номер версии).
+// Писатель должен быть один в каждый момент времени (несколько задач —
+// только под общим мьютексом команд). Читатель не должен вытеснять
+// писателя на том же ядре, иначе он будет крутиться до его возврата.
+template <typename T> class SeqLock {
+  static_assert(sizeof(T) % sizeof(uint32_t) == 0,
+                "SeqLock: size must be a multiple of 4 bytes");
+  static const size_t WORDS = sizeof(T) / sizeof(uint32_t);
+
+public:
+  SeqLock() {
+    T empty = T();
+    store(empty);
+  }
+
+  void store(const T &v) {
+    uint32_t words[WORDS];
+    memcpy(words, &v, sizeof(T));
+    uint32_t s = seq.load(std::memory_order_relaxed);
+    seq.store(s + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < WORDS; i++)
+      data[i].store(words[i], std::memory_order_relaxed);
+    seq.store(s + 2, std::memory_order_release);
+  }
+
+  // retries (необязательно) — сколько раз пришлось перечитать
+  T load(uint32_t *retries = nullptr) const {
+    uint32_t words[WORDS];
+    uint32_t n = 0;
+    while (true) {
+      uint32_t s1 = seq.load(std::memory_order_acquire);
+      if (!(s1 & 1)) {
+        for (size_t i = 0; i < WORDS; i++)
+          words[i] = data[i].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq.load(std::memory_order_relaxed) == s1)
+          break;
+      }
+      n++;
+    }
+    if (retries)
+      *retries += n;
+    T v;
+    memcpy(&v, words, sizeof(T));
+    return v;
+  }
+
+  // Номер версии: растёт на 2 с каждой публикацией
+  uint32_t version() const { return seq.load(std::memory_order_acquire); }
+
+private:
+  std::atomic<uint32_t> seq{0};
+  std::atomic<uint32_t> data[WORDS];
+};
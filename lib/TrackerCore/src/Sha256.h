@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// SHA-256 и HMAC-SHA256 (FIPS 180-4, RFC 2104) без зависимостей: одинаково
+// на ESP32 и на хосте. Поток — update() кусками любого размера.
+
+const size_t SHA256_SIZE = 32;
+
+class Sha256 {
+public:
+  Sha256() { reset(); }
+  void reset();
+  void update(const void *data, size_t len);
+  void finish(uint8_t out[SHA256_SIZE]);
+
+private:
+  void block(const uint8_t *p);
+
+  uint32_t h[8];
+  uint64_t total = 0;
+  uint8_t buf[64];
+  size_t bufLen = 0;
+};
+
+void hmacSha256(const uint8_t *key, size_t keyLen, const void *data,
+                size_t len, uint8_t out[SHA256_SIZE]);
+
+// 64 hex-символа <-> 32 байта; false — не hex или не та длина
+bool sha256FromHex(const char *hex, uint8_t out[SHA256_SIZE]);
+void sha256ToHex(const uint8_t d[SHA256_SIZE], char out[2 * SHA256_SIZE + 1]);
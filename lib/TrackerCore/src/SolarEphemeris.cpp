@@ -0,0 +1,119 @@
+#include "SolarEphemeris.h"
+
+#include <math.h>
+
+static const double PI_D = 3.14159265358979323846;
+
+time_t solarDayStart(float lon, time_t now) {
+  long shift = lroundf(lon * 240.0f); // 4 минуты на градус долготы
+  time_t solar = now + shift;
+  time_t day = solar / 86400;
+  if (solar < 0 && solar % 86400)
+    day--;
+  return day * 86400 - shift;
+}
+
+float azimuthDiff(float a, float b) {
+  float d = fmodf(a - b + 540.0f, 360.0f);
+  if (d < 0)
+    d += 360.0f;
+  return d - 180.0f;
+}
+
+float pointingError(float az1, float alt1, float az2, float alt2) {
+  float dAz = azimuthDiff(az1, az2) * cosf((alt1 + alt2) * 0.5f * 0.0174533f);
+  float dAlt = alt1 - alt2;
+  return sqrtf(dAz * dAz + dAlt * dAlt);
+}
+
+// Значение ряда Чебышёва в x из [-1, 1] (схема Кленшоу)
+static float chebEval(const float *c, float x) {
+  float b1 = 0, b2 = 0;
+  float x2 = 2.0f * x;
+  for (int k = EPH_DEGREE; k > 0; k--) {
+    float b0 = c[k] + x2 * b1 - b2;
+    b2 = b1;
+    b1 = b0;
+  }
+  return c[0] + x * b1 - b2;
+}
+
+void SolarEphemeris::fitSegment(const Config &cfg, int i) {
+  const int n = EPH_DEGREE + 1;
+  time_t segStart = dayStart + (time_t)i * EPH_SEG_SEC;
+  float az[n], alt[n];
+
+  // Значения в узлах Чебышёва; азимут "разворачиваем", чтобы переход
+  // через север не давал скачка на 360
+  for (int j = 0; j < n; j++) {
+    double x = cos(PI_D * (j + 0.5) / n);
+    time_t t = segStart + (time_t)lround((x + 1.0) * 0.5 * EPH_SEG_SEC);
+    source.position(cfg, t, az[j], alt[j]);
+    if (j > 0)
+      az[j] = az[j - 1] + azimuthDiff(az[j], az[j - 1]);
+  }
+
+  Segment &s = seg[i];
+  for (int k = 0; k < n; k++) {
+    double sa = 0, sh = 0;
+    for (int j = 0; j < n; j++) {
+      double w = cos(PI_D * k * (j + 0.5) / n);
+      sa += az[j] * w;
+      sh += alt[j] * w;
+    }
+    s.az[k] = (k == 0 ? 1.0 : 2.0) * sa / n;
+    s.alt[k] = (k == 0 ? 1.0 : 2.0) * sh / n;
+  }
+
+  // Проверка между узлами
+  float worst = 0;
+  for (int j = 0; j < EPH_CHECKS; j++) {
+    time_t t = segStart + EPH_SEG_SEC * (2 * j + 1) / (2 * EPH_CHECKS);
+    float refAz, refAlt;
+    source.position(cfg, t, refAz, refAlt);
+    float x = 2.0f * (t - segStart) / EPH_SEG_SEC - 1.0f;
+    float e = pointingError(chebEval(s.az, x), chebEval(s.alt, x), refAz,
+                            refAlt);
+    if (e > worst)
+      worst = e;
+  }
+
+  s.direct = worst > EPH_MAX_ERR_DEG;
+  if (s.direct)
+    directSegs++;
+  else if (worst > maxError)
+    maxError = worst;
+}
+
+void SolarEphemeris::build(const Config &cfg, time_t start) {
+  dayStart = start;
+  lat = cfg.lat;
+  lon = cfg.lon;
+  directSegs = 0;
+  maxError = 0;
+  for (int i = 0; i < EPH_SEGMENTS; i++)
+    fitSegment(cfg, i);
+  ready = true;
+  builds++;
+}
+
+void SolarEphemeris::position(const Config &cfg, time_t now, float &az,
+                              float &alt) {
+  if (!ready || cfg.lat != lat || cfg.lon != lon ||
+      now < dayStart || now >= dayStart + 86400)
+    build(cfg, solarDayStart(cfg.lon, now));
+
+  long off = (long)(now - dayStart);
+  int i = off / EPH_SEG_SEC;
+  const Segment &s = seg[i];
+  if (s.direct) {
+    source.position(cfg, now, az, alt);
+    return;
+  }
+
+  float x = 2.0f * (off - (long)i * EPH_SEG_SEC) / EPH_SEG_SEC - 1.0f;
+  az = fmodf(chebEval(s.az, x), 360.0f);
+  if (az < 0)
+    az += 360.0f;
+  alt = chebEval(s.alt, x);
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "TrackerHal.h"
+
+// Суточный кэш эфемерид Солнца.
+// Раз в сутки (или при смене координат) солнечные сутки делятся на часовые
+// отрезки, и азимут/высота на каждом аппроксимируются полиномом Чебышёва
+// по значениям из источника (SunPosition). Каждый цикл трекера — только
+// вычисление полинома (Кленшоу), без полного расчёта NOAA.
+// Отрезки, где аппроксимация хуже EPH_MAX_ERR_DEG (например, прохождение
+// Солнца около зенита в тропиках), считаются напрямую через источник.
+
+const int EPH_SEGMENTS = 24;        // отрезков на сутки
+const int EPH_SEG_SEC = 86400 / EPH_SEGMENTS;
+const int EPH_DEGREE = 5;           // степень полинома на отрезке
+const int EPH_CHECKS = 8;           // контрольных точек на отрезок
+const float EPH_MAX_ERR_DEG = 0.05; // гарантированная точность кэша
+
+class SolarEphemeris : public HalSun {
+public:
+  explicit SolarEphemeris(HalSun &source) : source(source) {}
+
+  void position(const Config &cfg, time_t now, float &az,
+                float &alt) override;
+  void invalidate() { ready = false; }
+
+  long builds = 0;     // сколько раз строилась таблица
+  int directSegs = 0;  // отрезков без аппроксимации в текущей таблице
+  float maxError = 0;  // худшая ошибка наведения в контрольных точках
+
+private:
+  struct Segment {
+    float az[EPH_DEGREE + 1];
+    float alt[EPH_DEGREE + 1];
+    bool direct;
+  };
+
+  void build(const Config &cfg, time_t start);
+  void fitSegment(const Config &cfg, int i);
+
+  HalSun &source;
+  Segment seg[EPH_SEGMENTS];
+  time_t dayStart = 0;
+  float lat = 0;
+  float lon = 0;
+  bool ready = false;
+};
+
+// Начало солнечных суток (местная полночь по долготе) для момента now
+time_t solarDayStart(float lon, time_t now);
+
+// Разница азимутов с учётом перехода 360 -> 0, в диапазоне [-180, 180)
+float azimuthDiff(float a, float b);
+
+// Угловая ошибка наведения между двумя направлениями, градусы
+// (ошибка азимута у зенита почти не влияет на наведение)
+float pointingError(float az1, float alt1, float az2, float alt2);
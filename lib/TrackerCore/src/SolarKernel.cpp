@@ -0,0 +1,118 @@
+#include "SolarKernel.h"
+
+#include <math.h>
+
+// ================= Таблица синусов (constexpr) =================
+static const int SIN_STEPS = 512; // шагов на оборот
+
+struct SinTable {
+  float v[SIN_STEPS + 1];
+
+  // Ряд Тейлора в double после приведения к [-pi/2, pi/2]
+  static constexpr double sinSeries(double x) {
+    const double PI = 3.14159265358979323846;
+    if (x > PI / 2)
+      x = PI - x;
+    if (x < -PI / 2)
+      x = -PI - x;
+    double term = x, sum = x;
+    for (int k = 1; k < 12; k++) {
+      term *= -x * x / ((2 * k) * (2 * k + 1));
+      sum += term;
+    }
+    return sum;
+  }
+
+  constexpr SinTable() : v() {
+    const double PI = 3.14159265358979323846;
+    for (int i = 0; i <= SIN_STEPS; i++) {
+      double a = 2 * PI * i / SIN_STEPS;
+      v[i] = (float)sinSeries(a > PI ? a - 2 * PI : a);
+    }
+  }
+};
+
+static constexpr SinTable SIN_TABLE{};
+static_assert(SIN_TABLE.v[SIN_STEPS / 4] > 0.999999f, "sin(90) != 1");
+
+float fastSin(float deg) {
+  float pos = deg * (SIN_STEPS / 360.0f);
+  float fl = floorf(pos);
+  float frac = pos - fl;
+  int i = (int)fl % SIN_STEPS;
+  if (i < 0)
+    i += SIN_STEPS;
+  return SIN_TABLE.v[i] + (SIN_TABLE.v[i + 1] - SIN_TABLE.v[i]) * frac;
+}
+
+float fastCos(float deg) { return fastSin(deg + 90.0f); }
+
+// atan на [0, 1], минимаксный полином (ошибка ~1e-5 рад)
+static float atanUnit(float x) {
+  float x2 = x * x;
+  return x * (0.99997726f +
+              x2 * (-0.33262347f +
+                    x2 * (0.19354346f +
+                          x2 * (-0.11643287f +
+                                x2 * (0.05265332f + x2 * -0.01172120f)))));
+}
+
+float fastAtan2(float y, float x) {
+  const float R2D = 57.2957795f;
+  float ax = fabsf(x), ay = fabsf(y);
+  if (ax == 0 && ay == 0)
+    return 0;
+  float a = ax >= ay ? atanUnit(ay / ax) : 1.57079633f - atanUnit(ax / ay);
+  if (x < 0)
+    a = 3.14159265f - a;
+  return (y < 0 ? -a : a) * R2D;
+}
+
+float fastAsin(float x) {
+  if (x >= 1)
+    return 90.0f;
+  if (x <= -1)
+    return -90.0f;
+  return fastAtan2(x, sqrtf(1.0f - x * x));
+}
+
+static float wrap360(float deg) {
+  deg = fmodf(deg, 360.0f);
+  return deg < 0 ? deg + 360.0f : deg;
+}
+
+// ================= Положение Солнца =================
+void solarPosition(float lat, float lon, time_t now, float &az, float &alt) {
+  // Сутки от J2000.0 (2000-01-01 12:00 UTC): целая часть + доля
+  long long sec = (long long)now - 946728000LL;
+  long days = (long)(sec / 86400);
+  long rem = (long)(sec % 86400);
+  if (rem < 0) {
+    rem += 86400;
+    days--;
+  }
+  float frac = rem / 86400.0f;
+  float n = (float)days + frac;
+
+  // Эклиптическая долгота и наклон эклиптики
+  float L = wrap360(280.460f + wrap360(0.9856474f * days) + 0.9856474f * frac);
+  float g = wrap360(357.528f + wrap360(0.9856003f * days) + 0.9856003f * frac);
+  float lambda = L + 1.915f * fastSin(g) + 0.020f * fastSin(2 * g);
+  float eps = 23.439f - 0.0000004f * n;
+
+  float sinLambda = fastSin(lambda);
+  float ra = fastAtan2(fastCos(eps) * sinLambda, fastCos(lambda));
+  float sinDec = fastSin(eps) * sinLambda;
+  float cosDec = sqrtf(1.0f - sinDec * sinDec);
+
+  // Звёздное время: 24*days кратно суткам и отбрасывается
+  float gmst = 280.46061837f + 360.0f * frac + wrap360(0.98564736629f * days) +
+               0.98564736629f * frac;
+  float ha = wrap360(gmst + lon - ra);
+
+  float sinLat = fastSin(lat), cosLat = fastCos(lat);
+  float cosHa = fastCos(ha);
+  alt = fastAsin(sinLat * sinDec + cosLat * cosDec * cosHa);
+  az = wrap360(fastAtan2(-cosDec * fastSin(ha),
+                         sinDec * cosLat - cosDec * cosHa * sinLat));
+}
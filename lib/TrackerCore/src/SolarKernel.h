@@ -0,0 +1,26 @@
+#pragma once
+
+#include "TrackerHal.h"
+
+// Расчёт положения Солнца только во float (FPU ESP32 аппаратно умеет
+// лишь одинарную точность). Алгоритм низкой точности Astronomical Almanac
+// (~0.01°), тригонометрия — таблица синусов, построенная при компиляции
+// (constexpr), и полиномиальные atan/asin. Время делится на целые сутки и
+// долю суток, чтобы не терять точность float на больших датах.
+
+// Тригонометрия в градусах
+float fastSin(float deg);
+float fastCos(float deg);
+float fastAtan2(float y, float x); // результат в градусах (-180, 180]
+float fastAsin(float x);           // результат в градусах [-90, 90]
+
+// Азимут (от севера по часовой) и высота Солнца в градусах
+void solarPosition(float lat, float lon, time_t now, float &az, float &alt);
+
+class KernelSun : public HalSun {
+public:
+  void position(const Config &cfg, time_t now, float &az,
+                float &alt) override {
+    solarPosition(cfg.lat, cfg.lon, now, az, alt);
+  }
+};
@@ -0,0 +1,57 @@
+#include "StatusFrame.h"
+
+#include <math.h>
+#include <stdio.h>
+
+StatusFrame makeStatusFrame(const TrackerSnapshot &snap, int curHor,
+                            int curVer, bool isAP, int32_t timeSec) {
+  StatusFrame f;
+  f.voltsCenti = lroundf(snap.panelVolts * 100.0f);
+  f.sunAzDeci = lroundf(snap.sunAz * 10.0f);
+  f.sunAltDeci = lroundf(snap.sunAlt * 10.0f);
+  f.curHor = curHor;
+  f.curVer = curVer;
+  f.mode = snap.mode;
+  f.isNight = snap.isNight;
+  f.isAP = isAP;
+  f.timeSec = timeSec;
+  return f;
+}
+
+bool writeStatusDelta(JsonWriter &w, const StatusFrame *prev,
+                      const StatusFrame &cur) {
+#define CHANGED(field) (!prev || prev->field != cur.field)
+  if (!CHANGED(voltsCenti) && !CHANGED(sunAzDeci) && !CHANGED(sunAltDeci) &&
+      !CHANGED(curHor) && !CHANGED(curVer) && !CHANGED(mode) &&
+      !CHANGED(isNight) && !CHANGED(isAP))
+    return false;
+
+  // Время само по себе не повод для сообщения: браузер досчитывает
+  // секунды локально, а каждое сообщение заново синхронизирует часы
+  char timeStr[10] = "00:00:00";
+  if (cur.timeSec >= 0)
+    snprintf(timeStr, sizeof(timeStr), "%02d:%02d:%02d",
+             (int)(cur.timeSec / 3600 % 24), (int)(cur.timeSec / 60 % 60),
+             (int)(cur.timeSec % 60));
+  w.beginObject();
+  w.field("time", timeStr);
+  if (CHANGED(voltsCenti))
+    w.field("volts", cur.voltsCenti / 100.0f, 2);
+  if (CHANGED(sunAzDeci))
+    w.field("sunAz", cur.sunAzDeci / 10.0f, 1);
+  if (CHANGED(sunAltDeci))
+    w.field("sunAlt", cur.sunAltDeci / 10.0f, 1);
+  if (CHANGED(curHor))
+    w.field("curHor", (int)cur.curHor);
+  if (CHANGED(curVer))
+    w.field("curVer", (int)cur.curVer);
+  if (CHANGED(mode))
+    w.field("mode", (int)cur.mode);
+  if (CHANGED(isNight))
+    w.field("isNight", cur.isNight);
+  if (CHANGED(isAP))
+    w.field("isAP", cur.isAP);
+  w.endObject();
+#undef CHANGED
+  return true;
+}
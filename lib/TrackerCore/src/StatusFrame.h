@@ -0,0 +1,31 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "JsonWriter.h"
+#include "TrackerCore.h"
+
+// Живые значения дашборда, округлённые до точности отображения.
+// Сравнение кадров после округления отсекает шум АЦП и доли градуса,
+// поэтому push-канал шлёт сообщение, только когда на экране что-то
+// действительно изменится.
+struct StatusFrame {
+  int32_t voltsCenti; // В * 100
+  int32_t sunAzDeci;  // градусы * 10
+  int32_t sunAltDeci;
+  int16_t curHor;
+  int16_t curVer;
+  int8_t mode;
+  bool isNight;
+  bool isAP;
+  int32_t timeSec; // местное время, секунды от полуночи (-1 — нет времени)
+};
+
+StatusFrame makeStatusFrame(const TrackerSnapshot &snap, int curHor,
+                            int curVer, bool isAP, int32_t timeSec);
+
+// Пишет объект с полями, отличающимися от prev (все поля, если prev ==
+// nullptr), плюс текущее время. Возвращает false, если кроме времени
+// ничего не изменилось — тогда объект не пишется.
+bool writeStatusDelta(JsonWriter &w, const StatusFrame *prev,
+                      const StatusFrame &cur);
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <stdint.h>
+
+// Память (раскладка совпадает с EEPROM-образом прошивки)
+struct Config {
+  uint8_t magic;
+  char ssid[32];
+  char pass[32];
+  int gmt;
+  float lat;
+  float lon;
+  int verMin;
+  int verMax;
+  int hOff;
+  int vOff;
+};
@@ -0,0 +1,194 @@
+#include "TrackerCore.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "NightPlanner.h"
+#include "SolarEphemeris.h"
+
+TrackerCore::TrackerCore(Config &cfg, HalClock &clock, HalAdc &adc,
+                         HalActuator &servos, HalSun &sun)
+    : motion(servos), cfg(cfg), clock(clock), adc(adc), sun(sun) {}
+
+// Проверка включения сервоприводов
+void TrackerCore::ensureServosAttached() { motion.power(true); }
+
+// Отключение сервоприводов (Сон)
+void TrackerCore::detachServos() { motion.power(false); }
+
+// Новая цель для серво (1/ANGLE_SCALE градуса); поворот выполнит
+// планировщик
+void TrackerCore::setServos(int h, int v) {
+  ensureServosAttached();
+  currentHor = clampInt(h, 0, degToAngle(180));
+  currentVer = clampInt(v, degToAngle(cfg.verMin), degToAngle(cfg.verMax));
+  motion.moveTo(currentHor, currentVer);
+}
+
+// Инициализация демо режима
+void TrackerCore::startDemo() {
+  demoHor = 0;
+  demoDirHor = 1;
+  setServos(degToAngle(demoHor), degToAngle(cfg.verMin));
+}
+
+// Напряжение панели по отфильтрованному значению конвейера АЦП
+void TrackerCore::measureVoltage() {
+  panelVolts = pinToPanelVolts(adc.pinMilliVolts());
+}
+
+// Демо-режим (Плавное движение)
+void TrackerCore::demoStep() {
+  demoHor += demoDirHor * 2; // Шаг 2 градуса
+
+  if (demoHor >= 180) {
+    demoHor = 180;
+    demoDirHor = -1;
+  } else if (demoHor <= 0) {
+    demoHor = 0;
+    demoDirHor = 1;
+  }
+
+  // Вертикаль имитирует солнце (подъем в центре, опускание по краям)
+  // Математика: парабола, где на 90 градусах азимута наклон максимальный
+  // (verMax)
+  float progress = abs(demoHor - 90) / 90.0; // от 0 (центр) до 1 (края)
+  int targetV = cfg.verMax - (progress * (cfg.verMax - cfg.verMin));
+
+  setServos(degToAngle(demoHor), degToAngle(targetV));
+}
+
+// Последние команды веба; промежуточные уже затёрты в ячейках. Ручные
+// углы применяются только в ручном режиме (с учётом пришедшей смены режима)
+bool TrackerCore::applyCommands() {
+  bool any = false;
+  int m, h, v;
+  if (commands.take(CMD_MODE, m)) {
+    mode = m;
+    if (mode == MODE_DEMO)
+      startDemo();
+    any = true;
+  }
+  bool hasH = commands.take(CMD_HOR, h);
+  bool hasV = commands.take(CMD_VER, v);
+  if ((hasH || hasV) && mode == MODE_MANUAL) {
+    setServos(hasH ? h : currentHor, hasV ? v : currentVer);
+    any = true;
+  }
+  if (any)
+    commandsApplied.fetch_add(1, std::memory_order_relaxed);
+  return any;
+}
+
+void TrackerCore::configChanged() {
+  isNight = false;
+  sunrise = 0;
+  trackDelayMs = TRACK_IDLE_MS;
+}
+
+// Слежение по NOAA + ночной режим
+void TrackerCore::autoStep() {
+  time_t now = clock.now();
+  if (now <= 100000)
+    return;
+
+  sun.position(cfg, now, sunAz, sunAlt);
+
+  float q = trackQuantum / (float)ANGLE_SCALE;
+  float lead = aimAhead ? q / 2 : 0.0f;
+  int targetHor = azimuthToHor(floorf((sunAz + lead) / q) * q, cfg.hOff);
+  int targetVer = altitudeToVer(floorf((sunAlt + lead) / q) * q, cfg.vOff);
+
+  if (sunAlt <= 0) {
+    if (!isNight) {
+      isNight = true;
+      detachServos();
+      sunrise = nextSunrise(sun, cfg, now);
+    }
+  } else {
+    // Выход из ночи тоже плавный: скорость ограничивает планировщик
+    isNight = false;
+    sunrise = 0;
+    setServos(targetHor, targetVer);
+  }
+  scheduleNextStep(now, lead);
+}
+
+// Цель меняется, только когда азимут или высота переходят шаг
+// trackQuantum: оцениваем скорость Солнца и спим до ближайшего перехода.
+// Ночью скорость не считаем (таблица эфемерид меняется в полночь) —
+// ждём восхода
+void TrackerCore::scheduleNextStep(time_t now, float lead) {
+  trackDelayMs = TRACK_MAX_SLEEP_MS;
+  if (sunAlt <= 0) {
+    if (sunrise > now && sunrise - now < TRACK_MAX_SLEEP_MS / 1000)
+      trackDelayMs = (uint32_t)(sunrise - now) * 1000;
+    if (trackDelayMs < TRACK_MIN_SLEEP_MS)
+      trackDelayMs = TRACK_MIN_SLEEP_MS;
+    return;
+  }
+  float az2, alt2;
+  sun.position(cfg, now + TRACK_RATE_PROBE_S, az2, alt2);
+  float azRate = azimuthDiff(az2, sunAz) / TRACK_RATE_PROBE_S;
+  float altRate = (alt2 - sunAlt) / TRACK_RATE_PROBE_S;
+  float q = trackQuantum / (float)ANGLE_SCALE;
+  float sec = fminf(secondsToNextStep(sunAz + lead, azRate, q),
+                    secondsToNextStep(sunAlt + lead, altRate, q));
+  // Часы идут целыми секундами: просыпаемся не раньше перехода
+  if (sec * 1000.0f < TRACK_MAX_SLEEP_MS)
+    trackDelayMs = (uint32_t)ceilf(sec) * 1000;
+  if (trackDelayMs < TRACK_MIN_SLEEP_MS)
+    trackDelayMs = TRACK_MIN_SLEEP_MS;
+}
+
+// Логика работы
+void TrackerCore::control() {
+  trackDelayMs = TRACK_IDLE_MS;
+  if (mode != MODE_AUTO) {
+    isNight = false;
+    sunrise = 0;
+    ensureServosAttached();
+
+    if (mode == MODE_CALIB)
+      setServos(degToAngle(90), degToAngle(90));
+    else if (mode == MODE_DEMO)
+      demoStep();
+  } else {
+    autoStep(); // без времени (нет NTP и RTC) ничего не делает
+  }
+}
+
+void TrackerCore::publish() {
+  TrackerSnapshot snap = {};
+  snap.panelVolts = panelVolts;
+  snap.sunAz = sunAz;
+  snap.sunAlt = sunAlt;
+  snap.currentHor = angleToDeg(currentHor);
+  snap.currentVer = angleToDeg(currentVer);
+  snap.mode = mode;
+  snap.isNight = isNight;
+  snap.sunrise = sunrise;
+  telemetry.store(snap);
+}
+
+void TrackerCore::cycle() {
+  measureVoltage();
+  applyCommands();
+  control();
+  publish();
+}
+
+// В демо-режиме цикл работает быстрее для плавности, в авто — по прогнозу
+uint32_t TrackerCore::cycleDelayMs() const {
+  return mode == MODE_DEMO ? TRACK_DEMO_MS : trackDelayMs;
+}
+
+float secondsToNextStep(float x, float rate, float quantum) {
+  x /= quantum;
+  rate /= quantum;
+  if (rate > 0)
+    return (floorf(x) + 1.0f - x) / rate;
+  if (rate < 0)
+    return (x - floorf(x)) / -rate;
+  return INFINITY;
+}
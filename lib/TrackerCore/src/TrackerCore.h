@@ -0,0 +1,148 @@
+#pragma once
+
+#include <math.h>
+
+#include "CommandMailbox.h"
+#include "MotionPlanner.h"
+#include "SeqLock.h"
+#include "TrackerConfig.h"
+#include "TrackerHal.h"
+
+// Калибровка вольтметра
+const float R1 = 10000.0;
+const float R2 = 5100.0;
+const float V_REF = 3.3;
+
+// Режимы работы
+enum {
+  MODE_AUTO = 0,
+  MODE_MANUAL = 1,
+  MODE_CALIB = 2,
+  MODE_DEMO = 3,
+};
+
+// Планировщик цикла в авто-режиме: цель — на сетке trackQuantum, сон до
+// её следующей смены по скорости Солнца, но в этих пределах
+const uint32_t TRACK_IDLE_MS = 2000;      // ручной режим, нет времени
+const uint32_t TRACK_DEMO_MS = 100;       // демо: плавность
+const uint32_t TRACK_MIN_SLEEP_MS = 1000;
+const uint32_t TRACK_MAX_SLEEP_MS = 300000; // ограничивает ошибку прогноза
+const int TRACK_RATE_PROBE_S = 60; // шаг оценки скорости Солнца
+const int TRACK_QUANTUM = 1 * ANGLE_SCALE; // шаг цели, 1/ANGLE_SCALE градуса
+
+// Неизменяемый снимок состояния трекера для веб-задачи
+struct TrackerSnapshot {
+  float panelVolts;
+  float sunAz;
+  float sunAlt;
+  int currentHor;
+  int currentVer;
+  int mode;
+  bool isNight;
+  time_t sunrise; // ночью — ближайший восход (unix), днём 0
+};
+
+// Логика TaskTracker без привязки к Arduino/FreeRTOS.
+// Один вызов cycle() = одна итерация цикла трекера. Режим и ручные углы
+// веб кладёт в commands без блокировок, трекер забирает их в
+// applyCommands(); её, control() и прочие команды сериализует вызывающая
+// сторона (dataMutex);
+// читатели телеметрии берут снимок telemetry.load() без блокировок.
+// Сервоприводы двигает MotionPlanner (motion.step() из задачи движения),
+// поэтому ни cycle(), ни setServos() не ждут окончания поворота.
+// Заданные углы — в 1/ANGLE_SCALE градуса от отображения Солнца до
+// moveTo(); в снимок телеметрии — целые градусы.
+class TrackerCore {
+public:
+  TrackerCore(Config &cfg, HalClock &clock, HalAdc &adc, HalActuator &servos,
+              HalSun &sun);
+
+  void cycle(); // measureVoltage() + applyCommands() + control() + publish()
+  bool applyCommands(); // false — новых команд не было
+  void control();
+  void publish(); // только под тем же мьютексом, что и команды
+  uint32_t cycleDelayMs() const; // когда вызвать cycle() снова
+
+  void ensureServosAttached();
+  void detachServos();
+  void setServos(int h, int v);
+  void startDemo();
+  // Настройки (cfg) изменены на лету: ночь и восход пересчитать на
+  // следующем шаге. Вызывать под тем же мьютексом, что и команды
+  void configChanged();
+
+  // Шаги цикла (доступны отдельно для тестов)
+  void measureVoltage();
+  void demoStep();
+  void autoStep();
+
+  MotionPlanner motion;
+  SeqLock<TrackerSnapshot> telemetry;
+  CommandMailbox commands;
+  std::atomic<uint32_t> commandsApplied{0}; // циклов с новыми командами
+
+  // Данные
+  int mode = MODE_AUTO; // 0-Авто, 1-Ручной, 2-Калибровка, 3-Демо
+  // Заданные углы, 1/ANGLE_SCALE градуса (фактические — motion.hor()/ver())
+  int currentHor = degToAngle(90);
+  int currentVer = degToAngle(90);
+  float sunAz = 0;
+  float sunAlt = 0;
+  float panelVolts = 0.0;
+
+  // Переменные для демо-режима
+  int demoHor = 0;
+  int demoDirHor = 1;
+
+  bool isAPMode = false;
+  bool isNight = false; // Флаг ночного режима
+  time_t sunrise = 0;   // ищется один раз при заходе Солнца
+
+  // Шаг цели в авто-режиме: мельче — точнее, но чаще пробуждения и
+  // поправки серво (поправки мельче зоны нечувствительности не пишутся)
+  int trackQuantum = TRACK_QUANTUM;
+  // Цель — ближайший шаг (с упреждением на полшага), а не отстающий:
+  // средняя ошибка наведения ~0.25° вместо ~0.5° при шаге 1°
+  bool aimAhead = false;
+
+private:
+  void scheduleNextStep(time_t now, float lead);
+
+  Config &cfg;
+  HalClock &clock;
+  HalAdc &adc;
+  HalSun &sun;
+  uint32_t trackDelayMs = TRACK_IDLE_MS;
+};
+
+// Аналоги Arduino constrain()/map() (целочисленные, с теми же округлениями)
+inline int clampInt(int x, int lo, int hi) {
+  return x < lo ? lo : (x > hi ? hi : x);
+}
+
+inline long mapRange(long x, long inMin, long inMax, long outMin,
+                     long outMax) {
+  return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+// Азимут/высота Солнца -> углы сервоприводов (до ограничений),
+// 1/ANGLE_SCALE градуса с округлением; поправки — в градусах
+inline int azimuthToHor(float az, int hOff) {
+  long a = lroundf(az * ANGLE_SCALE);
+  return mapRange(a, 90 * ANGLE_SCALE, 270 * ANGLE_SCALE, 0,
+                  180 * ANGLE_SCALE) +
+         degToAngle(hOff);
+}
+
+inline int altitudeToVer(float alt, int vOff) {
+  return lroundf(alt * ANGLE_SCALE) + degToAngle(vOff);
+}
+
+// Напряжение на пине АЦП (мВ) -> напряжение панели (В) через делитель
+inline float pinToPanelVolts(float pinMilliVolts) {
+  return pinMilliVolts / 1000.0f * ((R1 + R2) / R2);
+}
+
+// Через сколько секунд floor(x / quantum) сменится, если x меняется со
+// скоростью rate (ед./с); INFINITY — не сменится
+float secondsToNextStep(float x, float rate, float quantum = 1.0f);
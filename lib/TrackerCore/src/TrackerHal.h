@@ -0,0 +1,103 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "TrackerConfig.h"
+
+// Минимальные интерфейсы железа для ядра трекера.
+// На ESP32 реализуются в main.cpp, на хосте — фейками из test/fakes.
+
+// Часы: unix-время (UTC) и задержка текущей задачи
+class HalClock {
+public:
+  virtual ~HalClock() {}
+  virtual time_t now() = 0;
+  virtual void delayMs(uint32_t ms) = 0;
+};
+
+// Вольтметр: последнее отфильтрованное напряжение на пине АЦП, мВ.
+// Должен отвечать за O(1), не обращаясь к АЦП (см. AdcPipeline)
+class HalAdc {
+public:
+  virtual ~HalAdc() {}
+  virtual float pinMilliVolts() = 0;
+};
+
+// Углы серво в фиксированной точке: ANGLE_SCALE единиц на градус
+const int ANGLE_SCALE = 100;
+
+inline int degToAngle(int deg) { return deg * ANGLE_SCALE; }
+inline int angleToDeg(int a) { // с округлением
+  return (a >= 0 ? a + ANGLE_SCALE / 2 : a - ANGLE_SCALE / 2) / ANGLE_SCALE;
+}
+
+// Пара сервоприводов (горизонт + вертикаль)
+class HalActuator {
+public:
+  virtual ~HalActuator() {}
+  virtual void attach() = 0;
+  virtual void detach() = 0;
+  virtual bool attached() = 0;
+  virtual void write(int hor, int ver) = 0; // 1/ANGLE_SCALE градуса
+  // Зона нечувствительности, 1/ANGLE_SCALE градуса: в движении
+  // планировщик пишет не чаще, чем на столько пути (0 — каждое изменение)
+  virtual int deadBand() { return 0; }
+};
+
+// Банк ШИМ-выходов серво: LEDC напрямую или I2C-расширитель (PCA9685).
+// Каналы — индексы в таблице pins из attach(); запись — одной пачкой
+class HalPwmBank {
+public:
+  virtual ~HalPwmBank() {}
+  virtual void attach(const uint8_t *pins, int n) = 0;
+  virtual void detach() = 0;
+  virtual void write(const uint8_t *channels, const uint16_t *pulseUs,
+                     int n) = 0;
+};
+
+// Положение Солнца (азимут/высота в градусах)
+class HalSun {
+public:
+  virtual ~HalSun() {}
+  virtual void position(const Config &cfg, time_t now, float &az,
+                        float &alt) = 0;
+};
+
+// Файлы с дозаписью (LittleFS на ESP32, память на хосте).
+// Пути плоские ("/hist3.bin"), запись только в конец файла
+class HalStorage {
+public:
+  virtual ~HalStorage() {}
+  virtual bool append(const char *path, const void *data, size_t len) = 0;
+  // Прочитано байт; 0 — конец файла или файла нет
+  virtual size_t read(const char *path, size_t offset, void *buf,
+                      size_t len) = 0;
+  virtual size_t size(const char *path) = 0; // 0 — файла нет
+  virtual void remove(const char *path) = 0;
+};
+
+// Хранилище ключ-значение (NVS на ESP32, map на хосте).
+// Ключ — до 15 символов, значение целиком перезаписывается
+class HalKeyValue {
+public:
+  virtual ~HalKeyValue() {}
+  // Прочитано байт; 0 — ключа нет или буфер мал
+  virtual size_t get(const char *key, void *buf, size_t len) = 0;
+  virtual bool put(const char *key, const void *data, size_t len) = 0;
+};
+
+// Неактивный раздел прошивки для OTA (esp_partition на ESP32, файл на
+// хосте). Как у flash: стирание секторами в 0xFF, запись только по
+// стёртому
+class HalOtaPartition {
+public:
+  virtual ~HalOtaPartition() {}
+  virtual size_t size() = 0;
+  virtual bool erase(size_t offset, size_t len) = 0; // кратно сектору
+  virtual bool write(size_t offset, const void *data, size_t len) = 0;
+  virtual bool read(size_t offset, void *buf, size_t len) = 0;
+  // Загружаться с этого раздела после перезагрузки
+  virtual bool activate() = 0;
+};
@@ -1,535 +1,1219 @@
+#include <ActuatorArray.h>
+#include <AdcPipeline.h>
 #include <Arduino.h>
+#include <BootTimeline.h>
+#include <ConfigStore.h>
 #include <EEPROM.h>
 #include <ESP32Servo.h>
-#include <SunPosition.h>
-#include <WebServer.h>
+#include <EnergyStats.h>
+#include <HistoryStore.h>
+#include <HttpServer.h>
+#include <JsonWriter.h>
+#include <Metrics.h>
+#include <LittleFS.h>
+#include <MqttPublisher.h>
+#include <NetConnector.h>
+#include <NightPlanner.h>
+#include <OtaUpdater.h>
+#include <Preferences.h>
+#include <ScanCache.h>
+#include <SolarEphemeris.h>
+#include <SolarKernel.h>
+#include <StatusFrame.h>
+#include <TrackerCore.h>
 #include <WiFi.h>
+#include <Wire.h>
+#include <driver/adc.h>
+#include <esp_adc_cal.h>
+#include <esp_ota_ops.h>
+#include <esp_sleep.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/semphr.h>
 #include <freertos/task.h>
+#include <index_html.h> // web/index.html, gzip (tools/embed_web.py)
+#include <sys/time.h>
 #include <time.h>
 
 const int PIN_HOR = 5;
 const int PIN_VER = 18;
 const int PIN_VOLTAGE = 34; // Вход делителя напряжения
+const int PIN_SDA = 21;     // I2C для PCA9685
+const int PIN_SCL = 22;
 
-// Калибровка вольтметра
-const float R1 = 10000.0;
-const float R2 = 5100.0;
-const float V_REF = 3.3;
-
-Servo servoHor;
-Servo servoVer;
-WebServer server(80);
-
-// Память
-struct Config {
-  byte magic;
-  char ssid[32];
-  char pass[32];
-  int gmt;
-  float lat;
-  float lon;
-  int verMin;
-  int verMax;
-  int hOff;
-  int vOff;
+// Стеки задач, байт (запас виден в /api/metrics)
+const uint32_t WEB_STACK = 8192;
+const uint32_t TRACKER_STACK = 4096;
+const uint32_t MOTION_STACK = 2048;
+const uint32_t ADC_STACK = 2048;
+
+// Головы трекера (ActuatorArray.h): одна траектория на все, у каждой —
+// свои пины, поправки, пределы и кривые калибровки (по умолчанию —
+// линейные 500..2400 мкс). Для PCA9685 пины — номера его каналов
+enum PwmBackend { PWM_LEDC, PWM_PCA9685 };
+const PwmBackend PWM_BACKEND = PWM_LEDC;
+// const ServoCurve HOR_CURVE = {{530, 990, 1460, 1930, 2380}}; // пример
+const HeadConfig HEADS[] = {
+    {PIN_HOR, PIN_VER, 0, 0, 0, 180, 0, 180},
+    // {PIN_HOR, PIN_VER, 0, 0, 0, 180, 0, 180, &HOR_CURVE}, // с калибровкой
+    // {19, 23, 0, 0, 0, 180, 0, 180}, // вторая панель рядом
 };
+const adc1_channel_t ADC_CH_VOLTAGE = ADC1_CHANNEL_6; // GPIO34
+
+// Непрерывный режим АЦП (DMA): 20 кГц — минимум для I2S-АЦП ESP32,
+// группы по 200 отсчётов дают 100 отфильтрованных значений в секунду
+const uint32_t ADC_SAMPLE_HZ = 20000;
+const AdcPipelineConfig ADC_PIPELINE = {200, ADC_FILTER_MEDIAN, 0.2};
+const int ADC_FRAME_BYTES = 256;
+
+HttpServer http; // порт 80, keep-alive, таймауты — HttpServer.h
 
 Config cfg;
 
-// Данные
-int mode = 0; // 0-Авто, 1-Ручной, 2-Калибровка, 3-Демо
-int currentHor = 90;
-int currentVer = 90;
-float sunAz = 0;
-float sunAlt = 0;
-float panelVolts = 0.0;
-
-// Переменные для демо-режима
-int demoHor = 0;
-int demoDirHor = 1;
-
-bool needReboot = false;
-bool isAPMode = false;
-bool isNight = false; // Флаг ночного режима
-
-SemaphoreHandle_t dataMutex;
-
-// ================= СОВРЕМЕННЫЙ ВЕБ-ИНТЕРФЕЙС =================
-const char index_html[] PROGMEM = R"rawliteral(
-<!DOCTYPE html>
-<html lang="ru">
-<head>
-  <meta charset="UTF-8">
-  <meta name="viewport" content="width=device-width, initial-scale=1.0">
-  <title>Solar Tracker OS</title>
-  <style>
-    :root { 
-      --bg: #0f172a; --card: #1e293b; --text: #f8fafc; 
-      --accent: #10b981; --accent-hover: #059669; --blue: #3b82f6; --night: #8b5cf6; --demo: #f59e0b;
-    }
-    body { font-family: 'Segoe UI', system-ui, sans-serif; background: var(--bg); color: var(--text); margin: 0; padding: 15px; }
-    h2, h3 { margin-top: 0; color: #94a3b8; font-weight: 500; font-size: 1rem; text-transform: uppercase; letter-spacing: 1px; border-bottom: 1px solid #334155; padding-bottom: 8px; }
-    
-    .nav { display: flex; gap: 10px; margin-bottom: 20px; max-width: 800px; margin-left: auto; margin-right: auto; }
-    .nav button { flex: 1; padding: 15px; background: var(--card); color: #94a3b8; border: 2px solid transparent; border-radius: 10px; font-weight: bold; cursor: pointer; transition: 0.3s; font-size: 1rem; }
-    .nav button.active { background: #064e3b; color: var(--accent); border-color: var(--accent); }
-    
-    .grid { display: grid; grid-template-columns: repeat(auto-fit, minmax(280px, 1fr)); gap: 15px; max-width: 800px; margin: 0 auto; }
-    .card { background: var(--card); padding: 20px; border-radius: 12px; box-shadow: 0 10px 15px -3px rgba(0,0,0,0.5); }
-    .card-full { grid-column: 1 / -1; }
-    
-    .stat-row { display: flex; justify-content: space-between; margin-bottom: 12px; font-size: 1.1rem; }
-    .stat-val { font-weight: 600; color: var(--blue); }
-    .volt-box { text-align: center; padding: 10px 0; }
-    .volt-val { font-size: 4rem; font-weight: 800; color: var(--accent); text-shadow: 0 0 20px rgba(16,185,129,0.4); line-height: 1; }
-    .volt-label { font-size: 1.2rem; color: #94a3b8; margin-top: 5px; }
-    
-    .btn-group { display: flex; flex-direction: column; gap: 10px; }
-    button.action-btn { padding: 12px; border: none; border-radius: 8px; background: #334155; color: white; font-weight: bold; cursor: pointer; transition: 0.2s; }
-    button.action-btn.active { background: var(--blue); }
-    button.save-btn { background: var(--accent); color: #000; width: 100%; padding: 15px; font-size: 1.1rem; margin-top: 10px; }
-    button.save-btn:hover { background: var(--accent-hover); }
-    
-    label { display: block; margin-bottom: 5px; color: #cbd5e1; font-size: 0.9rem; }
-    input, select { width: 100%; padding: 12px; margin-bottom: 15px; background: #0f172a; border: 1px solid #334155; color: white; border-radius: 8px; box-sizing: border-box; }
-    input:focus { outline: none; border-color: var(--blue); }
-    input[type=range] { -webkit-appearance: none; background: #0f172a; height: 10px; border-radius: 5px; outline: none; border: 1px solid #334155; }
-    input[type=range]::-webkit-slider-thumb { -webkit-appearance: none; width: 24px; height: 24px; border-radius: 50%; background: var(--blue); cursor: pointer; }
-    
-    .flex-row { display: flex; gap: 10px; }
-    .flex-row > div { flex: 1; }
-    .flex-row button { margin-bottom: 15px; }
-  </style>
-</head>
-<body>
-
-  <div class="nav">
-    <button id="tab-dash" class="active" onclick="switchTab('dash')">ДАШБОРД</button>
-    <button id="tab-setup" onclick="switchTab('setup')">НАСТРОЙКИ</button>
-  </div>
-
-  <div id="view-dash" class="grid">
-    <div class="card card-full volt-box">
-      <h2>ГЕНЕРАЦИЯ ПАНЕЛИ</h2>
-      <div class="volt-val"><span id="volts">0.00</span></div>
-      <div class="volt-label">ВОЛЬТ (V)</div>
-    </div>
-    
-    <div class="card">
-      <h2>ИНФОРМАЦИЯ</h2>
-      <div class="stat-row"><span>Время:</span> <span class="stat-val" id="time">--:--:--</span></div>
-      <div class="stat-row"><span>Солнце Азимут:</span> <span class="stat-val" id="sunAz">--°</span></div>
-      <div class="stat-row"><span>Солнце Высота:</span> <span class="stat-val" id="sunAlt">--°</span></div>
-      <div class="stat-row"><span>Механика Гор:</span> <span class="stat-val" id="curHor">--°</span></div>
-      <div class="stat-row"><span>Механика Вер:</span> <span class="stat-val" id="curVer">--°</span></div>
-    </div>
-
-    <div class="card">
-      <h2>РЕЖИМ РАБОТЫ</h2>
-      <div class="btn-group">
-        <button id="btn0" class="action-btn" onclick="setMode(0)">АВТО (СЛЕЖЕНИЕ)</button>
-        <button id="btn3" class="action-btn" onclick="setMode(3)">🚀 ДЕМО ДЛЯ ПРЕЗЕНТАЦИИ</button>
-        <button id="btn1" class="action-btn" onclick="setMode(1)">РУЧНОЙ РЕЖИМ</button>
-        <button id="btn2" class="action-btn" onclick="setMode(2)">КАЛИБРОВКА (90°)</button>
-      </div>
-      
-      <div id="manualPanel" style="display:none; margin-top:20px;">
-        <label>Горизонт (Азимут): <span id="vH" style="color:var(--accent)">90</span>°</label>
-        <input type="range" id="slH" min="0" max="180" oninput="document.getElementById('vH').innerText=this.value" onchange="sendManual()">
-        <label>Вертикаль (Наклон): <span id="vV" style="color:var(--accent)">90</span>°</label>
-        <input type="range" id="slV" min="0" max="90" oninput="document.getElementById('vV').innerText=this.value" onchange="sendManual()">
-      </div>
-    </div>
-  </div>
-
-  <div id="view-setup" class="grid" style="display:none;">
-    <div class="card card-full">
-      <h2>КОНФИГУРАЦИЯ СИСТЕМЫ</h2>
-      <form id="cfgForm" onsubmit="saveCfg(event)">
-        <div class="flex-row">
-          <div><label>Широта (Lat)</label><input type="text" id="lat"></div>
-          <div><label>Долгота (Lon)</label><input type="text" id="lon"></div>
-          <div><label>GMT (Пояс)</label><input type="number" id="gmt"></div>
-        </div>
-        
-        <div class="flex-row">
-          <div><label>Мин. Наклон</label><input type="number" id="verMin"></div>
-          <div><label>Макс. Наклон</label><input type="number" id="verMax"></div>
-        </div>
-        
-        <div class="flex-row">
-          <div><label>Оффсет Азимут</label><input type="number" id="hOff"></div>
-          <div><label>Оффсет Наклон</label><input type="number" id="vOff"></div>
-        </div>
-
-        <label>WiFi Имя (SSID)</label>
-        <div class="flex-row">
-          <input type="text" id="ssid" placeholder="Название сети">
-          <select id="ssidSelect" style="display:none;" onchange="document.getElementById('ssid').value=this.value;"></select>
-          <button type="button" class="action-btn" id="scanBtn" onclick="scanWifi()" style="width:120px;">ПОИСК</button>
-        </div>
-        
-        <label>WiFi Пароль</label>
-        <input type="text" id="pass">
-        
-        <button type="submit" class="action-btn save-btn">СОХРАНИТЬ ДАННЫЕ В EEPROM</button>
-      </form>
-    </div>
-  </div>
-
-  <script>
-    function switchTab(tab) {
-      document.getElementById('view-dash').style.display = (tab === 'dash') ? 'grid' : 'none';
-      document.getElementById('view-setup').style.display = (tab === 'setup') ? 'grid' : 'none';
-      document.getElementById('tab-dash').className = (tab === 'dash') ? 'active' : '';
-      document.getElementById('tab-setup').className = (tab === 'setup') ? 'active' : '';
-    }
+// ================= HAL (ESP32) =================
+class Esp32Clock : public HalClock {
+public:
+  time_t now() override {
+    time_t t;
+    time(&t);
+    return t;
+  }
+  void delayMs(uint32_t ms) override { vTaskDelay(ms / portTICK_PERIOD_MS); }
+};
 
-    function update() {
-      fetch('/api/status').then(r=>r.json()).then(d=>{
-        document.getElementById('time').innerText = d.time;
-        document.getElementById('volts').innerText = d.volts.toFixed(2);
-        document.getElementById('sunAz').innerText = d.sunAz.toFixed(1) + '°';
-        document.getElementById('sunAlt').innerText = d.sunAlt.toFixed(1) + '°';
-        document.getElementById('curHor').innerText = d.curHor + '°';
-        document.getElementById('curVer').innerText = d.curVer + '°';
-        
-        // Логика ночного режима
-        let btn0 = document.getElementById('btn0');
-        if(d.mode == 0) {
-          btn0.className = 'action-btn active';
-          if(d.isNight) {
-            btn0.innerText = '🌙 НОЧЬ (ЭНЕРГОСБЕРЕЖЕНИЕ)';
-            btn0.style.backgroundColor = 'var(--night)';
-          } else {
-            btn0.innerText = 'АВТО (СЛЕЖЕНИЕ)';
-            btn0.style.backgroundColor = 'var(--blue)';
-          }
-        } else {
-          btn0.className = 'action-btn';
-          btn0.innerText = 'АВТО (СЛЕЖЕНИЕ)';
-          btn0.style.backgroundColor = '#334155';
-        }
-
-        let btn3 = document.getElementById('btn3');
-        if(d.mode == 3) {
-          btn3.className = 'action-btn active';
-          btn3.innerText = '🚀 ДЕМО В ПРОЦЕССЕ...';
-          btn3.style.backgroundColor = 'var(--demo)';
-        } else {
-          btn3.className = 'action-btn';
-          btn3.innerText = '🚀 ДЕМО ДЛЯ ПРЕЗЕНТАЦИИ';
-          btn3.style.backgroundColor = '#334155';
-        }
-
-        document.getElementById('btn1').className = 'action-btn ' + (d.mode==1 ? 'active' : '');
-        document.getElementById('btn2').className = 'action-btn ' + (d.mode==2 ? 'active' : '');
-        document.getElementById('manualPanel').style.display = d.mode==1 ? 'block' : 'none';
-
-        if(!document.getElementById('cfgForm').classList.contains('loaded')){
-          document.getElementById('lat').value = d.lat; document.getElementById('lon').value = d.lon;
-          document.getElementById('gmt').value = d.gmt; document.getElementById('verMin').value = d.verMin;
-          document.getElementById('verMax').value = d.verMax; document.getElementById('hOff').value = d.hOff;
-          document.getElementById('vOff').value = d.vOff; document.getElementById('ssid').value = d.ssid;
-          document.getElementById('cfgForm').classList.add('loaded');
-          if (d.isAP) switchTab('setup'); 
-        }
-      });
-    }
+// Серво на выводах ESP32 (LEDC через ESP32Servo)
+class LedcBank : public HalPwmBank {
+public:
+  void attach(const uint8_t *pins, int n) override {
+    count = n;
+    for (int i = 0; i < n; ++i)
+      if (!servo[i].attached())
+        servo[i].attach(pins[i], SERVO_MIN_US, SERVO_MAX_US);
+  }
+  void detach() override {
+    for (int i = 0; i < count; ++i)
+      if (servo[i].attached())
+        servo[i].detach();
+  }
+  void write(const uint8_t *channels, const uint16_t *pulseUs,
+             int n) override {
+    for (int i = 0; i < n; ++i)
+      servo[channels[i]].writeMicroseconds(pulseUs[i]);
+  }
 
-    function scanWifi() {
-      let b = document.getElementById('scanBtn'); b.innerText = 'ПОИСК...';
-      fetch('/api/scan').then(r=>r.json()).then(d=>{
-        let s = document.getElementById('ssidSelect'); let i = document.getElementById('ssid');
-        s.innerHTML = '<option value="">Выберите сеть</option>';
-        d.forEach(n => s.innerHTML += `<option value="${n.ssid}">${n.ssid} (${n.rssi}dBm)</option>`);
-        i.style.display = 'none'; s.style.display = 'block'; b.innerText = 'ОБНОВИТЬ';
-      });
-    }
-    
-    function setMode(m) { fetch('/api/setMode?mode='+m).then(update); }
-    
-    function sendManual() { 
-      let h = document.getElementById('slH').value; let v = document.getElementById('slV').value;
-      fetch(`/api/setManual?h=${h}&v=${v}`).then(update); 
+private:
+  Servo servo[ACT_MAX_CHANNELS];
+  int count = 0;
+};
+
+// Серво на PCA9685: соседние каналы пишутся одной I2C-транзакцией
+// (автоинкремент регистров)
+class Pca9685Bank : public HalPwmBank {
+public:
+  void attach(const uint8_t *pins, int n) override {
+    memcpy(pin, pins, n);
+    if (!ready) {
+      Wire.begin(PIN_SDA, PIN_SCL);
+      Wire.setClock(400000);
+      reg(PCA9685_MODE1, PCA9685_MODE1_SLEEP); // делитель — только во сне
+      reg(PCA9685_PRESCALE, pca9685Prescale(SERVO_PWM_HZ));
+      reg(PCA9685_MODE1, PCA9685_MODE1_AI);
+      delay(1); // генератор запускается 500 мкс
+      reg(PCA9685_MODE1, PCA9685_MODE1_AI | PCA9685_MODE1_RESTART);
+      ready = true;
     }
-    
-    function saveCfg(e) {
-      e.preventDefault();
-      let p = new URLSearchParams();
-      ['lat','lon','gmt','verMin','verMax','hOff','vOff','ssid','pass'].forEach(k => p.set(k, document.getElementById(k).value));
-      fetch('/api/saveCfg?'+p.toString()).then(()=>alert('Настройки сохранены! ESP32 перезагружается...'));
+  }
+  void detach() override { reg(PCA9685_ALL_OFF_H, 0x10); } // полное «выкл»
+  void write(const uint8_t *channels, const uint16_t *pulseUs,
+             int n) override {
+    for (int i = 0; i < n;) {
+      Wire.beginTransmission(PCA9685_ADDR);
+      Wire.write(PCA9685_LED0 + 4 * pin[channels[i]]);
+      int j = i;
+      do {
+        uint16_t off = pca9685Ticks(pulseUs[j], SERVO_PWM_HZ);
+        const uint8_t led[4] = {0, 0, (uint8_t)off, (uint8_t)(off >> 8)};
+        Wire.write(led, sizeof(led));
+        ++j;
+      } while (j < n && pin[channels[j]] == pin[channels[j - 1]] + 1);
+      Wire.endTransmission();
+      i = j;
     }
+  }
+
+private:
+  void reg(uint8_t r, uint8_t v) {
+    Wire.beginTransmission(PCA9685_ADDR);
+    Wire.write(r);
+    Wire.write(v);
+    Wire.endTransmission();
+  }
+
+  uint8_t pin[ACT_MAX_CHANNELS];
+  bool ready = false;
+};
+
+// Файлы истории на LittleFS (раздел данных flash)
+class LittleFsStorage : public HalStorage {
+public:
+  bool append(const char *path, const void *data, size_t len) override {
+    File f = LittleFS.open(path, FILE_APPEND);
+    if (!f)
+      return false;
+    size_t n = f.write((const uint8_t *)data, len);
+    f.close();
+    return n == len;
+  }
+  size_t read(const char *path, size_t offset, void *buf,
+              size_t len) override {
+    File f = LittleFS.open(path, FILE_READ);
+    if (!f)
+      return 0;
+    size_t n = f.seek(offset) ? f.read((uint8_t *)buf, len) : 0;
+    f.close();
+    return n;
+  }
+  size_t size(const char *path) override {
+    if (!LittleFS.exists(path))
+      return 0;
+    File f = LittleFS.open(path, FILE_READ);
+    size_t n = f ? f.size() : 0;
+    f.close();
+    return n;
+  }
+  void remove(const char *path) override { LittleFS.remove(path); }
+};
+
+// Ключ-значение в NVS (раздел nvs сам распределяет износ flash)
+class NvsKeyValue : public HalKeyValue {
+public:
+  void begin() { prefs.begin("tracker", false); }
+  size_t get(const char *key, void *buf, size_t len) override {
+    size_t n = prefs.getBytesLength(key);
+    return n && n <= len ? prefs.getBytes(key, buf, n) : 0;
+  }
+  bool put(const char *key, const void *data, size_t len) override {
+    return prefs.putBytes(key, data, len) == len;
+  }
+
+private:
+  Preferences prefs;
+};
+
+// Неактивный app-раздел (ota_0/ota_1 таблицы разделов) — туда пишет OTA
+class EspOtaPartition : public HalOtaPartition {
+public:
+  size_t size() override { return part() ? part()->size : 0; }
+  bool erase(size_t offset, size_t len) override {
+    return part() && esp_partition_erase_range(part(), offset, len) == ESP_OK;
+  }
+  bool write(size_t offset, const void *data, size_t len) override {
+    return part() && esp_partition_write(part(), offset, data, len) == ESP_OK;
+  }
+  bool read(size_t offset, void *buf, size_t len) override {
+    return part() && esp_partition_read(part(), offset, buf, len) == ESP_OK;
+  }
+  // esp_ota_set_boot_partition() ещё раз проверяет заголовок образа
+  bool activate() override {
+    return part() && esp_ota_set_boot_partition(part()) == ESP_OK;
+  }
+
+private:
+  const esp_partition_t *part() {
+    if (!next)
+      next = esp_ota_get_next_update_partition(nullptr);
+    return next;
+  }
+  const esp_partition_t *next = nullptr;
+};
+
+Esp32Clock halClock;
+AdcPipeline voltmeter; // последнее значение и окно min/max/mean
+LedcBank ledcBank;
+Pca9685Bank pcaBank;
+ActuatorArray heads(PWM_BACKEND == PWM_PCA9685 ? (HalPwmBank &)pcaBank
+                                               : (HalPwmBank &)ledcBank);
+KernelSun kernelSun; // float-расчёт Солнца (вместо библиотеки SunPosition)
+SolarEphemeris halSun(kernelSun); // полный расчёт — раз в сутки
+
+// Данные трекера (режим, углы, вольты, ночь) — см. TrackerCore
+TrackerCore tracker(cfg, halClock, voltmeter, heads, halSun);
+
+ScanCache wifiScan; // последний результат фонового сканирования Wi-Fi
+
+LittleFsStorage flashFs;
+HistoryStore history(&flashFs); // RAM-кольцо + блоки на LittleFS
+const uint32_t HISTORY_MAX_POINTS = 2000; // точек в ответе /api/history
+
+EnergyStats energy; // выработка по минутам/часам/суткам
+const float ENERGY_LOAD_OHMS = 10.0f; // нагрузка панели для оценки мощности
+
+NvsKeyValue nvs;
+ConfigStore configStore(nvs); // поле Config — запись NVS с CRC
+
+NetConnector net;  // Wi-Fi подключается в фоне, см. pollNet()
+
+// Телеметрия в MQTT (MqttPublisher.h): nullptr — выключено. Топики
+// solar/<id>/telemetry (пачки JSON, QoS 1) и solar/<id>/status
+// (online/offline, retain); <id> — MAC платы
+const char *const MQTT_HOST = nullptr; // например "192.168.1.10"
+const uint16_t MQTT_PORT = 1883;
+char mqttId[16];
+char mqttTopic[40];
+char mqttStatusTopic[40];
+MqttClient mqtt;
+MqttPublisher mqttPub(mqtt, mqttTopic, mqttId);
+BootTimeline boot; // этапы загрузки, /api/boot
+
+// Обновление по сети (OtaUpdater.h): POST /api/ota, образ подписан
+// HMAC-SHA256 ключом OTA_KEY (tools/ota_upload.py). Пустой ключ — отказ
+// 401. Новая прошивка подтверждает себя, проработав OTA_CONFIRM_MS с
+// запущенными веб-сервером и циклом трекера; иначе через OTA_TRIAL_MS
+// перезагрузка, после OTA_TRIAL_BOOTS попыток — откат на прежний раздел
+#ifndef OTA_KEY
+#define OTA_KEY ""
+#endif
+const uint32_t OTA_CONFIRM_MS = 60000;
+const uint32_t OTA_TRIAL_MS = 600000;
+EspOtaPartition otaPartition;
+OtaUpdater ota(otaPartition, (const uint8_t *)OTA_KEY, sizeof(OTA_KEY) - 1);
+OtaUploadHandler otaUpload(ota);
+OtaBootGuard otaGuard(nvs);
+
+// Ядро Arduino не подтверждает образ само — это делает pollOta()
+extern "C" bool verifyRollbackLater() { return true; }
+
+// Ночной сон в авто-режиме (NightPlanner.h). LIGHT сохраняет задачи и RAM,
+// DEEP экономнее, но каждый отрезок сна — перезагрузка
+const NightSleepMode NIGHT_SLEEP = NIGHT_SLEEP_LIGHT;
+const uint32_t NIGHT_CHECK_MS = 60000;
+
+// Продолжение после deep sleep: RTC-память переживает сон
+struct NightResume {
+  uint32_t magic;
+  uint32_t sleptAt; // unix-время засыпания
+  uint32_t sleepS;
+  int16_t hor; // фактическое положение серво
+  int16_t ver;
+};
+const uint32_t NIGHT_RESUME_MAGIC = 0x4E474854;
+RTC_DATA_ATTR NightResume nightResume;
+
+SemaphoreHandle_t dataMutex; // только команды; телеметрия — tracker.telemetry
+TaskHandle_t trackerTask = nullptr; // спит до смены цели или команды
+TaskHandle_t webTask = nullptr;
+TaskHandle_t motionTask = nullptr;
+TaskHandle_t adcTask = nullptr;
+
+// Метрики для /api/metrics (Metrics.h): рабочая часть цикла каждой задачи
+// (без сна и ожидания данных) и ожидание dataMutex
+LatencyHistogram webCycle, trackerCycle, motionCycle, adcCycle;
+LatencyHistogram webMutexWait, trackerMutexWait;
 
-    setInterval(update, 2000); 
-    update();
-  </script>
-</body>
-</html>
-)rawliteral";
+// dataMutex с замером ожидания; отпускать — xSemaphoreGive(dataMutex)
+void lockData(LatencyHistogram &wait) {
+  LatencyTimer t(wait);
+  xSemaphoreTake(dataMutex, portMAX_DELAY);
+}
+
+// Разбудить TaskTracker раньше срока: команда применится сразу
+void wakeTracker() {
+  if (trackerTask)
+    xTaskNotifyGive(trackerTask);
+}
+
+// Вольтметр: калибровка по eFuse Vref и запуск непрерывного режима АЦП
+void setupAdc() {
+  esp_adc_cal_characteristics_t chars;
+  esp_adc_cal_characterize(ADC_UNIT_1, ADC_ATTEN_DB_11, ADC_WIDTH_BIT_12, 1100,
+                           &chars);
+  // Линейная часть характеристики (коррекция LUT для 11 дБ не учитывается)
+  AdcCalibration cal = {chars.coeff_a, chars.coeff_b};
+  voltmeter.configure(ADC_PIPELINE, cal);
+
+  adc_digi_init_config_t init = {};
+  init.max_store_buf_size = ADC_FRAME_BYTES * 8;
+  init.conv_num_each_intr = ADC_FRAME_BYTES;
+  init.adc1_chan_mask = BIT(ADC_CH_VOLTAGE);
+  adc_digi_initialize(&init);
+
+  adc_digi_pattern_config_t pattern = {};
+  pattern.atten = ADC_ATTEN_DB_11;
+  pattern.channel = ADC_CH_VOLTAGE;
+  pattern.unit = 0; // ADC1
+  pattern.bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+
+  adc_digi_configuration_t dig = {};
+  dig.conv_limit_en = 1;
+  dig.conv_limit_num = 250;
+  dig.pattern_num = 1;
+  dig.adc_pattern = &pattern;
+  dig.sample_freq_hz = ADC_SAMPLE_HZ;
+  dig.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+  dig.format = ADC_DIGI_OUTPUT_FORMAT_TYPE1;
+  adc_digi_controller_configure(&dig);
+  adc_digi_start();
+}
 
-// Загрузка EEPROM
+// Настройки из NVS; при первом запуске — перенос из прежней EEPROM
 void loadSettings() {
-  EEPROM.begin(512);
-  EEPROM.get(0, cfg);
-  if (cfg.magic != 123) {
-    cfg.magic = 123;
-    strlcpy(cfg.ssid, "", sizeof(cfg.ssid));
-    strlcpy(cfg.pass, "", sizeof(cfg.pass));
-    cfg.gmt = 5;
-    cfg.lat = 51.1333;
-    cfg.lon = 71.4333;
-    cfg.verMin = 15;
-    cfg.verMax = 90;
-    cfg.hOff = 0;
-    cfg.vOff = 0;
-    EEPROM.put(0, cfg);
-    EEPROM.commit();
-  }
-}
-
-// Проверка включения сервоприводов
-void ensureServosAttached() {
-  if (!servoHor.attached())
-    servoHor.attach(PIN_HOR, 500, 2400);
-  if (!servoVer.attached())
-    servoVer.attach(PIN_VER, 500, 2400);
-}
-
-// Отключение сервоприводов (Сон)
-void detachServos() {
-  if (servoHor.attached())
-    servoHor.detach();
-  if (servoVer.attached())
-    servoVer.detach();
-}
-
-// Моментальная установка
-void setServos(int h, int v) {
-  ensureServosAttached();
-  currentHor = constrain(h, 0, 180);
-  currentVer = constrain(v, cfg.verMin, cfg.verMax);
-  servoHor.write(currentHor);
-  servoVer.write(currentVer);
-}
-
-// Плавный поворот без рывков
-void smoothMove(int targetH, int targetV) {
-  ensureServosAttached();
-  targetH = constrain(targetH, 0, 180);
-  targetV = constrain(targetV, cfg.verMin, cfg.verMax);
-
-  while (currentHor != targetH || currentVer != targetV) {
-    if (currentHor < targetH)
-      currentHor++;
-    else if (currentHor > targetH)
-      currentHor--;
-
-    if (currentVer < targetV)
-      currentVer++;
-    else if (currentVer > targetV)
-      currentVer--;
-
-    servoHor.write(currentHor);
-    servoVer.write(currentVer);
-    vTaskDelay(40 / portTICK_PERIOD_MS); // Плавная скорость
+  nvs.begin();
+  if (!configStore.load(cfg)) {
+    Config legacy;
+    EEPROM.begin(512);
+    EEPROM.get(0, legacy);
+    EEPROM.end();
+    configStore.migrate(cfg, legacy);
+    Serial.println(legacy.magic == CONFIG_LEGACY_MAGIC
+                       ? "[CFG] Настройки перенесены из EEPROM в NVS"
+                       : "[CFG] Настройки по умолчанию");
+  }
+  if (configStore.corrupted) {
+    Serial.print("[CFG] Повреждено записей (взяты значения по умолчанию): ");
+    Serial.println(configStore.corrupted);
   }
 }
 
-void setupRouting() {
-  server.on("/", HTTP_GET, []() { server.send(200, "text/html", index_html); });
-
-  server.on("/api/scan", HTTP_GET, []() {
-    int n = WiFi.scanNetworks();
-    String json = "[";
-    for (int i = 0; i < n; ++i) {
-      if (i > 0)
-        json += ",";
-      json += "{\"ssid\":\"" + WiFi.SSID(i) +
-              "\",\"rssi\":" + String(WiFi.RSSI(i)) + "}";
+// Сравнение с неподвижной панелью: наклон = широта, лицом к экватору
+void configureEnergy() {
+  EnergyModel model = {ENERGY_LOAD_OHMS, fabsf(cfg.lat),
+                       cfg.lat >= 0 ? 180.0f : 0.0f, cfg.gmt * 3600};
+  energy.configure(model);
+}
+
+// Новые настройки — без перезагрузки. Трекер подхватывает пределы,
+// смещения и координаты на следующем шаге; часы и оценка выработки
+// перенастраиваются сразу; Wi-Fi переподключается, только если сменились
+// SSID или пароль
+void applyConfig(uint32_t changed) {
+  if (changed & (cfgBit(CFG_GMT) | cfgBit(CFG_LAT) | cfgBit(CFG_LON)))
+    configureEnergy();
+  if (changed & cfgBit(CFG_GMT))
+    configTime(cfg.gmt * 3600, 0, "pool.ntp.org", "time.nist.gov");
+  if (changed & CFG_CREDENTIALS) {
+    Serial.print("[WiFi] Новые данные сети, переподключение: ");
+    Serial.println(cfg.ssid);
+    WiFi.disconnect();
+    net.begin(millis(), cfg.ssid[0] != 0);
+  }
+  wakeTracker();
+}
+
+// ================= JSON-ответы (без String) =================
+const size_t JSON_BUF = 512;
+
+void sendJson(HttpResponse &res, JsonWriter &w) {
+  res.respond(200, "application/json", w.c_str(), w.length());
+}
+
+// Градусы из запроса (можно дробные) -> 1/ANGLE_SCALE; мусор — в int16
+int angleArg(const char *s) {
+  double a = atof(s) * ANGLE_SCALE;
+  if (!(a > INT16_MIN))
+    return INT16_MIN;
+  return a < INT16_MAX ? (int)lround(a) : INT16_MAX;
+}
+
+// Потоковый ответ: заполненный буфер сразу уходит клиенту
+void sendChunk(const char *data, size_t len, void *ctx) {
+  ((HttpResponse *)ctx)->append(data, len);
+}
+
+// Снимок трекера со свежим напряжением: трекер между переходами цели
+// спит минутами, а конвейер АЦП отдаёт значение за O(1)
+TrackerSnapshot liveSnapshot() {
+  TrackerSnapshot snap = tracker.telemetry.load();
+  snap.panelVolts = pinToPanelVolts(voltmeter.pinMilliVolts());
+  return snap;
+}
+
+// Живые значения дашборда: снимок телеметрии + фактическое положение
+StatusFrame currentFrame() {
+  TrackerSnapshot snap = liveSnapshot();
+  struct tm timeinfo;
+  int32_t timeSec = -1;
+  if (getLocalTime(&timeinfo, 0))
+    timeSec = timeinfo.tm_hour * 3600 + timeinfo.tm_min * 60 + timeinfo.tm_sec;
+  return makeStatusFrame(snap, tracker.motion.hor(), tracker.motion.ver(),
+                         tracker.isAPMode, timeSec);
+}
+
+// ================= Push-канал (Server-Sent Events) =================
+const int SSE_MAX_CLIENTS = 4;
+const uint32_t SSE_PERIOD_MS = 250;  // Опрос снимка на изменения
+const uint32_t SSE_PING_MS = 15000;  // Комментарий-пинг, чтобы не рвали NAT
+
+StatusFrame sseLast;  // Последний разосланный кадр
+bool sseHaveLast = false;
+
+// "data: {...}\n\n" в буфере writer'а
+size_t sseEvent(char *buf, size_t cap, const StatusFrame *prev,
+                const StatusFrame &cur, bool *changed) {
+  memcpy(buf, "data: ", 6);
+  JsonWriter w(buf + 6, cap - 8);
+  *changed = writeStatusDelta(w, prev, cur);
+  size_t len = 6 + w.length();
+  buf[len++] = '\n';
+  buf[len++] = '\n';
+  return len;
+}
+
+void handleEvents(HttpRequest &req, HttpResponse &res) {
+  if (http.streamCount() >= SSE_MAX_CLIENTS) {
+    res.respond(503, "text/plain", "Too many clients");
+    return;
+  }
+  res.header("Cache-Control", "no-cache");
+  res.start(200, "text/event-stream");
+  res.keepOpen();
+
+  // Новому клиенту — полный кадр, дальше он получает общие дельты
+  StatusFrame cur = currentFrame();
+  if (!sseHaveLast) {
+    sseLast = cur;
+    sseHaveLast = true;
+  }
+  StatusFrame full = sseLast;
+  full.timeSec = cur.timeSec;
+  char buf[JSON_BUF];
+  bool changed;
+  res.append(buf, sseEvent(buf, sizeof(buf), nullptr, full, &changed));
+}
+
+// Вызывается из TaskWeb: рассылает только изменившиеся поля
+void ssePush() {
+  static uint32_t lastCheck = 0, lastSend = 0;
+  uint32_t now = millis();
+  if (now - lastCheck < SSE_PERIOD_MS)
+    return;
+  lastCheck = now;
+
+  if (!http.streamCount()) {
+    sseHaveLast = false;
+    return;
+  }
+
+  StatusFrame cur = currentFrame();
+  char buf[JSON_BUF];
+  bool changed;
+  size_t len = sseEvent(buf, sizeof(buf), &sseLast, cur, &changed);
+  if (changed) {
+    sseLast = cur;
+    http.broadcast(buf, len);
+  } else if (now - lastSend >= SSE_PING_MS) {
+    http.broadcast(":\n\n", 3);
+  } else {
+    return;
+  }
+  lastSend = now;
+}
+
+// [t, volts, sunAz, sunAlt, hor, ver] — компактнее объекта на точку
+void writeHistoryPoint(const HistorySample &s, void *ctx) {
+  JsonWriter &w = *(JsonWriter *)ctx;
+  w.beginArray()
+      .value(s.t)
+      .value(s.voltsCenti / 100.0f, 2)
+      .value(s.sunAzDeci / 10.0f, 1)
+      .value(s.sunAltDeci / 10.0f, 1)
+      .value((int)s.hor)
+      .value((int)s.ver)
+      .endArray();
+}
+
+// /api/history генератором (HttpResponse::produce): курсор в соединении,
+// точки запрашиваются кусками по HISTORY_SLICE интервалов — медленный
+// клиент не держит веб-задачу
+const uint32_t HISTORY_SLICE = 10; // точек на кусок, ≤ 44 байт на точку
+
+struct HistoryCursor {
+  uint32_t from, to, step;
+  uint32_t next; // начало следующего куска
+  uint8_t part;  // 0 — заголовок, 1 — точки, 2 — конец
+  bool any;      // точки уже были: следующему куску нужна запятая
+};
+static_assert(sizeof(HistoryCursor) <= HTTP_PRODUCER_STATE,
+              "HistoryCursor must fit the connection");
+
+bool fillHistory(HttpResponse &res, void *state) {
+  HistoryCursor &c = *(HistoryCursor *)state;
+  char buf[JSON_BUF];
+  if (c.part == 0) {
+    JsonWriter w(buf, sizeof(buf));
+    w.beginObject()
+        .field("from", c.from)
+        .field("to", c.to)
+        .field("step", c.step);
+    w.key("fields")
+        .beginArray()
+        .value("t")
+        .value("volts")
+        .value("sunAz")
+        .value("sunAlt")
+        .value("hor")
+        .value("ver")
+        .endArray();
+    w.key("data").beginArray();
+    if (!res.append(w.c_str(), w.length()))
+      return true;
+    c.part = 1;
+  }
+  while (c.part == 1 && res.room() >= sizeof(buf)) {
+    size_t comma = c.any ? 1 : 0;
+    buf[0] = ',';
+    JsonWriter w(buf + comma, sizeof(buf) - comma);
+    uint64_t end = (uint64_t)c.next + (uint64_t)HISTORY_SLICE * c.step - 1;
+    uint32_t last = end < c.to ? (uint32_t)end : c.to;
+    if (history.query(c.next, last, c.step, writeHistoryPoint, &w)) {
+      res.append(buf, comma + w.length());
+      c.any = true;
     }
-    json += "]";
-    server.send(200, "application/json", json);
-    WiFi.scanDelete();
-  });
+    c.next = last + 1;
+    if (last == c.to)
+      c.part = 2;
+  }
+  return c.part != 2 || !res.append("]}", 2);
+}
 
-  server.on("/api/status", HTTP_GET, []() {
-    xSemaphoreTake(dataMutex, portMAX_DELAY);
-    time_t now;
-    time(&now);
-    struct tm timeinfo;
-    char timeStr[10] = "00:00:00";
-    if (getLocalTime(&timeinfo))
-      strftime(timeStr, sizeof(timeStr), "%H:%M:%S", &timeinfo);
-
-    String json = "{";
-    json += "\"time\":\"" + String(timeStr) + "\",";
-    json += "\"volts\":" + String(panelVolts) + ",";
-    json += "\"sunAz\":" + String(sunAz) + ",";
-    json += "\"sunAlt\":" + String(sunAlt) + ",";
-    json += "\"curHor\":" + String(currentHor) + ",";
-    json += "\"curVer\":" + String(currentVer) + ",";
-    json += "\"mode\":" + String(mode) + ",";
-    json += "\"isAP\":" + String(isAPMode ? "true" : "false") + ",";
-    json += "\"isNight\":" + String(isNight ? "true" : "false") + ",";
-    json += "\"lat\":" + String(cfg.lat) + ",\"lon\":" + String(cfg.lon) + ",";
-    json += "\"gmt\":" + String(cfg.gmt) + ",\"verMin\":" + String(cfg.verMin) +
-            ",";
-    json += "\"verMax\":" + String(cfg.verMax) +
-            ",\"hOff\":" + String(cfg.hOff) + ",";
-    json += "\"vOff\":" + String(cfg.vOff) + ",\"ssid\":\"" + String(cfg.ssid) +
-            "\"}";
-    xSemaphoreGive(dataMutex);
-    server.send(200, "application/json", json);
-  });
+#if TRACKER_METRICS
+// Prometheus: задачи (время цикла, запас стека), dataMutex, куча, HTTP
+void writeMetrics(PromWriter &w) {
+  struct TaskMetrics {
+    const char *name;
+    TaskHandle_t handle;
+    uint32_t stack;
+    const LatencyHistogram &cycle;
+  };
+  const TaskMetrics tasks[] = {
+      {"web", webTask, WEB_STACK, webCycle},
+      {"tracker", trackerTask, TRACKER_STACK, trackerCycle},
+      {"motion", motionTask, MOTION_STACK, motionCycle},
+      {"adc", adcTask, ADC_STACK, adcCycle},
+  };
+  char labels[32];
+
+  w.family("task_cycle_seconds", "histogram",
+           "Work part of a task loop, without waits");
+  for (const TaskMetrics &t : tasks) {
+    snprintf(labels, sizeof(labels), "task=\"%s\"", t.name);
+    t.cycle.write(w, "task_cycle_seconds", labels);
+  }
+  w.family("task_stack_size_bytes", "gauge", "Task stack size");
+  for (const TaskMetrics &t : tasks) {
+    snprintf(labels, sizeof(labels), "task=\"%s\"", t.name);
+    w.sample("task_stack_size_bytes", labels, t.stack);
+  }
+  // На ESP32 high-water mark — в байтах (StackType_t = uint8_t)
+  w.family("task_stack_free_min_bytes", "gauge",
+           "Stack never used since start (high-water mark)");
+  for (const TaskMetrics &t : tasks) {
+    if (!t.handle)
+      continue;
+    snprintf(labels, sizeof(labels), "task=\"%s\"", t.name);
+    w.sample("task_stack_free_min_bytes", labels,
+             (uint32_t)uxTaskGetStackHighWaterMark(t.handle));
+  }
+
+  w.family("mutex_wait_seconds", "histogram", "dataMutex acquire latency");
+  webMutexWait.write(w, "mutex_wait_seconds", "task=\"web\"");
+  trackerMutexWait.write(w, "mutex_wait_seconds", "task=\"tracker\"");
+
+  w.family("command_slot_writes_total", "counter",
+           "Web commands per slot (mode, axis); superseded = never applied");
+  w.sample("command_slot_writes_total", "result=\"posted\"",
+           tracker.commands.posted.load());
+  w.sample("command_slot_writes_total", "result=\"superseded\"",
+           tracker.commands.superseded.load());
+  w.family("command_applies_total", "counter",
+           "Tracker cycles that applied new commands");
+  w.sample("command_applies_total", "", tracker.commandsApplied.load());
 
-  server.on("/api/setMode", HTTP_GET, []() {
-    xSemaphoreTake(dataMutex, portMAX_DELAY);
-    if (server.hasArg("mode")) {
-      mode = server.arg("mode").toInt();
-      if (mode == 3) { // Инициализация демо режима
-        demoHor = 0;
-        demoDirHor = 1;
-        setServos(demoHor, cfg.verMin);
-      }
+  w.family("heap_free_bytes", "gauge", "Free heap");
+  w.sample("heap_free_bytes", "", ESP.getFreeHeap());
+  w.family("heap_min_free_bytes", "gauge", "Lowest free heap since start");
+  w.sample("heap_min_free_bytes", "", ESP.getMinFreeHeap());
+  w.family("heap_largest_free_block_bytes", "gauge",
+           "Largest allocatable block");
+  w.sample("heap_largest_free_block_bytes", "", ESP.getMaxAllocHeap());
+  w.family("uptime_seconds", "counter", "Time since boot");
+  w.sample("uptime_seconds", "", (uint32_t)(millis() / 1000));
+
+  if (MQTT_HOST) {
+    w.family("mqtt_queue_depth", "gauge", "Records waiting for PUBACK");
+    w.sample("mqtt_queue_depth", "", mqttPub.depth());
+    w.family("mqtt_queue_depth_max", "gauge", "Queue high-water mark");
+    w.sample("mqtt_queue_depth_max", "", mqttPub.maxDepth);
+    w.family("mqtt_records_total", "counter", "Queued records by outcome");
+    w.sample("mqtt_records_total", "result=\"sent\"", mqttPub.sent);
+    w.sample("mqtt_records_total", "result=\"dropped\"", mqttPub.dropped);
+    w.family("mqtt_connects_total", "counter", "Broker sessions");
+    w.sample("mqtt_connects_total", "", mqtt.connects);
+  }
+
+  http.writeMetrics(w);
+}
+#endif
+
+void setupRouting() {
+  // Повторная загрузка страницы — 304 без тела, пока прошивка не сменилась
+  http.on(HTTP_METHOD_GET, "/", [](HttpRequest &req, HttpResponse &res) {
+    res.header("ETag", INDEX_HTML_ETAG);
+    res.header("Cache-Control", "no-cache");
+    if (strcmp(req.header("If-None-Match"), INDEX_HTML_ETAG) == 0) {
+      res.respond(304);
+      return;
     }
-    xSemaphoreGive(dataMutex);
-    server.send(200, "text/plain", "OK");
+    res.header("Content-Encoding", "gzip");
+    res.respondStatic(200, "text/html", INDEX_HTML_GZ, INDEX_HTML_GZ_LEN);
   });
 
-  server.on("/api/setManual", HTTP_GET, []() {
-    xSemaphoreTake(dataMutex, portMAX_DELAY);
-    if (mode == 1 && server.hasArg("h") && server.hasArg("v")) {
-      setServos(server.arg("h").toInt(), server.arg("v").toInt());
+  // Сразу отдаёт кэш; устаревший (или ?refresh=1) — сканирует в фоне
+  http.on(HTTP_METHOD_GET, "/api/scan",
+          [](HttpRequest &req, HttpResponse &res) {
+            uint32_t now = millis();
+            if (wifiScan.needsScan(now, req.hasArg("refresh"))) {
+              if (WiFi.scanNetworks(true) == WIFI_SCAN_RUNNING)
+                wifiScan.started(now);
+              else
+                wifiScan.failed(now);
+            }
+            res.start(200, "application/json");
+            char buf[256];
+            JsonWriter w(buf, sizeof(buf), sendChunk, &res);
+            wifiScan.write(w, now);
+            w.finish();
+          });
+
+  // Только чтение снимка телеметрии — без dataMutex
+  http.on(HTTP_METHOD_GET, "/api/status",
+          [](HttpRequest &req, HttpResponse &res) {
+            char buf[JSON_BUF];
+            JsonWriter w(buf, sizeof(buf));
+            writeStatusDelta(w, nullptr, currentFrame());
+            sendJson(res, w);
+          });
+
+  // Настройки меняются только через saveCfg (пароль не отдаётся)
+  http.on(HTTP_METHOD_GET, "/api/config",
+          [](HttpRequest &req, HttpResponse &res) {
+            char buf[JSON_BUF];
+            JsonWriter w(buf, sizeof(buf));
+            w.beginObject()
+                .field("lat", cfg.lat, 4)
+                .field("lon", cfg.lon, 4)
+                .field("gmt", cfg.gmt)
+                .field("verMin", cfg.verMin)
+                .field("verMax", cfg.verMax)
+                .field("hOff", cfg.hOff)
+                .field("vOff", cfg.vOff)
+                .field("ssid", cfg.ssid)
+                .field("isAP", tracker.isAPMode)
+                .endObject();
+            sendJson(res, w);
+          });
+
+  http.on(HTTP_METHOD_GET, "/api/events", handleEvents);
+
+  // Средние за интервалы step с на [from, to] (unix-время), потоком
+  http.on(HTTP_METHOD_GET, "/api/history",
+          [](HttpRequest &req, HttpResponse &res) {
+            uint32_t to = req.hasArg("to") ? strtoul(req.arg("to"), 0, 10)
+                                           : history.newest();
+            uint32_t from = req.hasArg("from")
+                                ? strtoul(req.arg("from"), 0, 10)
+                                : (to > 86400 ? to - 86400 : 0);
+            uint32_t step = strtoul(req.arg("step"), 0, 10);
+            if (from > to) {
+              res.respond(400, "text/plain", "from > to");
+              return;
+            }
+            uint32_t minStep = (to - from) / HISTORY_MAX_POINTS + 1;
+            if (!step)
+              step = HISTORY_PERIOD_S;
+            if (step < minStep)
+              step = minStep;
+
+            HistoryCursor cur = {from, to, step, from, 0, false};
+            res.produce(200, "application/json", fillHistory, &cur,
+                        sizeof(cur));
+          });
+
+  // Готовые агрегаты: ?period=minute|hour|day&n=корзин (по умолчанию 24)
+  http.on(HTTP_METHOD_GET, "/api/energy",
+          [](HttpRequest &req, HttpResponse &res) {
+            const char *period = req.arg("period");
+            EnergyPeriod p = ENERGY_HOUR;
+            if (strcmp(period, "minute") == 0)
+              p = ENERGY_MINUTE;
+            else if (strcmp(period, "day") == 0)
+              p = ENERGY_DAY;
+            else if (period[0] && strcmp(period, "hour") != 0) {
+              res.respond(400, "text/plain", "bad period");
+              return;
+            }
+            int n = req.hasArg("n") ? atoi(req.arg("n")) : 24;
+
+            res.start(200, "application/json");
+            char buf[256];
+            JsonWriter w(buf, sizeof(buf), sendChunk, &res);
+            energy.write(w, p, n);
+            w.finish();
+          });
+
+  // Этапы загрузки (мс от старта) и состояние подключения к Wi-Fi
+  http.on(HTTP_METHOD_GET, "/api/boot",
+          [](HttpRequest &req, HttpResponse &res) {
+            static const char *const NET_STATES[] = {"off", "connecting",
+                                                     "online"};
+            char buf[JSON_BUF];
+            JsonWriter w(buf, sizeof(buf));
+            w.beginObject().field("uptime", (unsigned long)millis());
+            w.key("phases");
+            boot.write(w);
+            w.key("net")
+                .beginObject()
+                .field("state", NET_STATES[net.state()])
+                .field("ap", net.apActive())
+                .field("attempts", net.attempts)
+                .field("failures", net.failures)
+                .field("drops", net.drops)
+                .endObject();
+            w.endObject();
+            sendJson(res, w);
+          });
+
+#if TRACKER_METRICS
+  // Текстовый формат Prometheus 0.0.4, чанками
+  http.on(HTTP_METHOD_GET, "/api/metrics",
+          [](HttpRequest &req, HttpResponse &res) {
+            res.start(200, "text/plain; version=0.0.4");
+            char buf[512];
+            PromWriter w(buf, sizeof(buf), sendChunk, &res);
+            writeMetrics(w);
+            w.finish();
+          });
+#endif
+
+  // Режим и ручные углы — в почтовый ящик трекера (CommandMailbox.h):
+  // без dataMutex, серия запросов от ползунка схлопывается в последний
+  http.on(HTTP_METHOD_GET, "/api/setMode",
+          [](HttpRequest &req, HttpResponse &res) {
+            if (req.hasArg("mode")) {
+              tracker.commands.post(CMD_MODE, atoi(req.arg("mode")));
+              wakeTracker();
+            }
+            res.respond(200, "text/plain", "OK");
+          });
+
+  // Углы в градусах, можно дробные (?h=91.25); в ячейку — 1/ANGLE_SCALE.
+  // Вне ручного режима трекер команду отбросит
+  http.on(HTTP_METHOD_GET, "/api/setManual",
+          [](HttpRequest &req, HttpResponse &res) {
+            if (req.hasArg("h") && req.hasArg("v")) {
+              tracker.commands.post(CMD_HOR, angleArg(req.arg("h")));
+              tracker.commands.post(CMD_VER, angleArg(req.arg("v")));
+              wakeTracker();
+            }
+            res.respond(200, "text/plain", "OK");
+          });
+
+  // Образ прошивки потоком в неактивный раздел, см. OTA_KEY
+  http.onUpload("/api/ota", otaUpload);
+
+  // Применяется сразу; ответ — какие поля изменились и записаны ли в NVS
+  http.on(HTTP_METHOD_GET, "/api/saveCfg",
+          [](HttpRequest &req, HttpResponse &res) {
+            Config next = cfg;
+            if (req.hasArg("ssid"))
+              strlcpy(next.ssid, req.arg("ssid"), sizeof(next.ssid));
+            if (req.hasArg("pass"))
+              strlcpy(next.pass, req.arg("pass"), sizeof(next.pass));
+            if (req.hasArg("lat"))
+              next.lat = atof(req.arg("lat"));
+            if (req.hasArg("lon"))
+              next.lon = atof(req.arg("lon"));
+            if (req.hasArg("gmt"))
+              next.gmt = atoi(req.arg("gmt"));
+            if (req.hasArg("verMin"))
+              next.verMin = atoi(req.arg("verMin"));
+            if (req.hasArg("verMax"))
+              next.verMax = atoi(req.arg("verMax"));
+            if (req.hasArg("hOff"))
+              next.hOff = atoi(req.arg("hOff"));
+            if (req.hasArg("vOff"))
+              next.vOff = atoi(req.arg("vOff"));
+
+            uint32_t changed = ConfigStore::diff(cfg, next);
+            uint32_t written = configStore.save(next);
+            if (changed) {
+              lockData(webMutexWait);
+              cfg = next;
+              tracker.configChanged();
+              xSemaphoreGive(dataMutex);
+              applyConfig(changed);
+            }
+
+            char buf[JSON_BUF];
+            JsonWriter w(buf, sizeof(buf));
+            w.beginObject().key("changed").beginArray();
+            for (int i = 0; i < CFG_FIELDS; ++i)
+              if (changed & cfgBit((ConfigField)i))
+                w.value(configFieldName((ConfigField)i));
+            w.endArray()
+                .field("saved", (written & changed) == changed)
+                .field("reconnect", (changed & CFG_CREDENTIALS) != 0)
+                .endObject();
+            sendJson(res, w);
+          });
+}
+
+// Забирает результат фонового сканирования Wi-Fi, когда он готов
+void pollScan() {
+  if (wifiScan.state() != SCAN_RUNNING)
+    return;
+  int n = WiFi.scanComplete();
+  if (n == WIFI_SCAN_RUNNING)
+    return;
+  if (n < 0) {
+    wifiScan.failed(millis());
+    return;
+  }
+  wifiScan.clear();
+  for (int i = 0; i < n; ++i) {
+    wifi_ap_record_t *ap = (wifi_ap_record_t *)WiFi.getScanInfoByIndex(i);
+    if (ap)
+      wifiScan.add((const char *)ap->ssid, ap->rssi, ap->primary,
+                   ap->authmode == WIFI_AUTH_OPEN);
+  }
+  wifiScan.done(millis());
+  WiFi.scanDelete();
+}
+
+// Точка истории раз в HISTORY_PERIOD_S, когда время уже синхронизировано
+void recordHistory() {
+  static uint32_t last = 0;
+  time_t now = halClock.now();
+  if (now <= 100000)
+    return;
+  if ((uint32_t)now < last) // часы назад (NTP) — период отсчитываем заново
+    last = now;
+  if ((uint32_t)now - last < HISTORY_PERIOD_S)
+    return;
+  last = now;
+  TrackerSnapshot snap = liveSnapshot();
+  HistorySample s = makeHistorySample(now, snap, tracker.motion.hor(),
+                                      tracker.motion.ver());
+  uint32_t stale = history.stale;
+  history.record(s); // точка не новее записанных отбрасывается — и в MQTT
+  if (MQTT_HOST && history.stale == stale) {
+    float wh = energy.bucket(ENERGY_DAY).wh;
+    mqttPub.push({s, (uint16_t)fminf(wh * 10.0f + 0.5f, 65535.0f),
+                  (uint8_t)snap.mode, snap.isNight});
+  }
+}
+
+// Пачки телеметрии в MQTT; без Wi-Fi записи копятся в очереди
+void pollMqtt() {
+  static uint32_t connects = 0;
+  if (!MQTT_HOST || WiFi.status() != WL_CONNECTED)
+    return;
+  mqttPub.poll(millis());
+  if (mqtt.connects != connects && mqtt.online()) {
+    connects = mqtt.connects;
+    mqtt.publishRetained(mqttStatusTopic, "online");
+  }
+}
+
+void setupMqtt() {
+  if (!MQTT_HOST)
+    return;
+  snprintf(mqttId, sizeof(mqttId), "%012llx",
+           (unsigned long long)ESP.getEfuseMac());
+  snprintf(mqttTopic, sizeof(mqttTopic), "solar/%s/telemetry", mqttId);
+  snprintf(mqttStatusTopic, sizeof(mqttStatusTopic), "solar/%s/status",
+           mqttId);
+  mqtt.begin({MQTT_HOST, MQTT_PORT, mqttId, mqttStatusTopic, "offline"},
+             millis());
+}
+
+// После загрузки образа — перезагрузка, когда ответ ушёл клиенту.
+// Новая прошивка на пробе подтверждается, когда поработала
+void pollOta() {
+  static uint32_t doneAt = 0;
+  if (otaUpload.done) {
+    if (!doneAt) {
+      doneAt = millis();
+      otaGuard.armed();
+      Serial.printf("[OTA] Образ принят (%u Б), перезагрузка\n",
+                    (unsigned)ota.received());
+    } else if (millis() - doneAt > 1000) {
+      history.flush();
+      ESP.restart();
     }
-    xSemaphoreGive(dataMutex);
-    server.send(200, "text/plain", "OK");
-  });
+    return;
+  }
+  if (!otaGuard.pending())
+    return;
+  if (millis() > OTA_CONFIRM_MS && boot.done(BOOT_HTTP) &&
+      boot.done(BOOT_FIRST_CYCLE)) {
+    otaGuard.confirm();
+    esp_ota_mark_app_valid_cancel_rollback();
+    Serial.println("[OTA] Новая прошивка подтверждена");
+  } else if (millis() > OTA_TRIAL_MS) {
+    history.flush();
+    ESP.restart(); // следующий запуск — новая попытка или откат
+  }
+}
 
-  server.on("/api/saveCfg", HTTP_GET, []() {
-    if (server.hasArg("ssid"))
-      strlcpy(cfg.ssid, server.arg("ssid").c_str(), sizeof(cfg.ssid));
-    if (server.hasArg("pass"))
-      strlcpy(cfg.pass, server.arg("pass").c_str(), sizeof(cfg.pass));
-    if (server.hasArg("lat"))
-      cfg.lat = server.arg("lat").toFloat();
-    if (server.hasArg("lon"))
-      cfg.lon = server.arg("lon").toFloat();
-    if (server.hasArg("gmt"))
-      cfg.gmt = server.arg("gmt").toInt();
-    if (server.hasArg("verMin"))
-      cfg.verMin = server.arg("verMin").toInt();
-    if (server.hasArg("verMax"))
-      cfg.verMax = server.arg("verMax").toInt();
-    if (server.hasArg("hOff"))
-      cfg.hOff = server.arg("hOff").toInt();
-    if (server.hasArg("vOff"))
-      cfg.vOff = server.arg("vOff").toInt();
-
-    cfg.magic = 123;
-    EEPROM.put(0, cfg);
-    EEPROM.commit();
-    server.send(200, "text/plain", "OK");
-    needReboot = true;
-  });
+// Запуск новой прошивки считается попыткой; исчерпаны — прежний раздел
+void otaBoot() {
+  OtaBootAction a = otaGuard.boot();
+  if (a == OTA_BOOT_TRIAL) {
+    Serial.printf("[OTA] Пробный запуск %u из %u\n",
+                  (unsigned)otaGuard.attempts(), (unsigned)OTA_TRIAL_BOOTS);
+  } else if (a == OTA_BOOT_ROLLBACK) {
+    Serial.println("[OTA] Прошивка не подтвердилась, откат");
+    const esp_partition_t *prev = esp_ota_get_next_update_partition(nullptr);
+    if (prev && esp_ota_set_boot_partition(prev) == ESP_OK)
+      ESP.restart();
+  }
+}
+
+// Ночью в авто-режиме: Wi-Fi в экономный режим, затем сон по RTC-таймеру
+// до следующей сверки часов или восхода. Пока открыт дашборд (поток SSE)
+// или новая прошивка не подтверждена, не засыпаем
+void nightSleep() {
+  static uint32_t lastCheck = 0;
+  static bool wifiSaving = false;
+  if (millis() - lastCheck < NIGHT_CHECK_MS)
+    return;
+  lastCheck = millis();
+  TrackerSnapshot snap = tracker.telemetry.load();
+  bool night = snap.mode == MODE_AUTO && snap.isNight && !tracker.isAPMode;
+  if (night != wifiSaving) {
+    WiFi.setSleep(night ? WIFI_PS_MAX_MODEM : WIFI_PS_MIN_MODEM);
+    wifiSaving = night;
+  }
+  if (NIGHT_SLEEP == NIGHT_SLEEP_OFF || !night || http.streamCount() ||
+      otaGuard.pending())
+    return;
+  uint32_t sleepS = nightSleepSeconds(halClock.now(), snap.sunrise);
+  if (!sleepS)
+    return;
+
+  history.flush();
+  Serial.printf("[Night] сон %u с, восход %ld\n", (unsigned)sleepS,
+                (long)snap.sunrise);
+  esp_sleep_enable_timer_wakeup((uint64_t)sleepS * 1000000ULL);
+  if (NIGHT_SLEEP == NIGHT_SLEEP_DEEP) {
+    nightResume = {NIGHT_RESUME_MAGIC, (uint32_t)halClock.now(), sleepS,
+                   (int16_t)tracker.motion.hor(),
+                   (int16_t)tracker.motion.ver()};
+    esp_deep_sleep_start(); // не возвращается
+  }
+
+  adc_digi_stop();
+  WiFi.disconnect(true);
+  WiFi.mode(WIFI_OFF);
+  esp_light_sleep_start();
+  adc_digi_start();
+  WiFi.mode(WIFI_STA);
+  net.begin(millis(), cfg.ssid[0] != 0); // после подключения — NTP
+  wifiSaving = false;
+  wakeTracker();
+}
+
+// Выработка раз в секунду: свежее значение конвейера АЦП, а не снимок
+// трекера (ночью он обновляется редко)
+void recordEnergy() {
+  static uint32_t last = 0;
+  time_t now = halClock.now();
+  if (now <= 100000 || (uint32_t)now == last)
+    return;
+  last = now;
+  TrackerSnapshot snap = liveSnapshot();
+  energy.add(now, snap.panelVolts, snap.mode == MODE_AUTO && !snap.isNight,
+             snap.sunAz, snap.sunAlt);
+}
+
+void printApInfo() {
+  Serial.println();
+  Serial.println("------------------------------------------");
+  Serial.println("  [РЕЖИМ НАСТРОЙКИ — Точка Доступа (AP)]");
+  Serial.println("------------------------------------------");
+  Serial.println("  WiFi сеть : SolarTracker");
+  Serial.println("  Пароль    : 12345678");
+  Serial.print("  IP адрес  : ");
+  Serial.println(WiFi.softAPIP());
+  Serial.println("  Откройте браузер и введите IP адрес выше");
+  Serial.println("------------------------------------------");
+}
+
+void printStaInfo() {
+  Serial.println();
+  Serial.println("------------------------------------------");
+  Serial.println("  [РАБОЧИЙ РЕЖИМ — Подключено к WiFi]");
+  Serial.println("------------------------------------------");
+  Serial.print("  Сеть      : ");
+  Serial.println(cfg.ssid);
+  Serial.print("  IP адрес  : ");
+  Serial.println(WiFi.localIP());
+  Serial.print("  GMT пояс  : +");
+  Serial.println(cfg.gmt);
+  Serial.println("  Откройте браузер и введите IP адрес выше");
+  Serial.println("------------------------------------------");
+}
+
+// Фоновое подключение к Wi-Fi: одно действие автомата за проход цикла.
+// Настройки при неудаче не стираются — поднимается точка доступа,
+// а попытки подключиться к сети продолжаются
+void pollNet() {
+  switch (net.poll(millis(), WiFi.status() == WL_CONNECTED)) {
+  case NET_BEGIN:
+    WiFi.begin(cfg.ssid, cfg.pass);
+    break;
+  case NET_CONNECTED:
+    configTime(cfg.gmt * 3600, 0, "pool.ntp.org", "time.nist.gov");
+    boot.mark(BOOT_NETWORK, millis());
+    printStaInfo();
+    break;
+  case NET_START_AP:
+    WiFi.mode(WIFI_AP_STA);
+    WiFi.softAP("SolarTracker", "12345678");
+    tracker.isAPMode = true;
+    boot.mark(BOOT_NETWORK, millis());
+    printApInfo();
+    break;
+  case NET_STOP_AP:
+    WiFi.softAPdisconnect(true);
+    WiFi.mode(WIFI_STA);
+    tracker.isAPMode = false;
+    break;
+  case NET_NONE:
+    break;
+  }
+
+  // Время появилось (NTP) — трекер не ждёт конца своей паузы
+  if (!boot.done(BOOT_TIME) && halClock.now() > 100000) {
+    boot.mark(BOOT_TIME, millis());
+    wakeTracker();
+  }
 }
 
 // ================= ЯДРО 0 (Веб-сервер) =================
+// Цикл событий: select() просыпается от сетевой активности,
+// таймаут нужен только для рассылки SSE
 void TaskWeb(void *pvParameters) {
   while (true) {
-    server.handleClient();
-    if (needReboot) {
-      vTaskDelay(1000 / portTICK_PERIOD_MS);
-      ESP.restart();
+    http.loop(SSE_PERIOD_MS); // обработчики — в метриках HttpServer
+    {
+      LatencyTimer t(webCycle);
+      pollNet();
+      ssePush();
+      pollScan();
+      recordHistory();
+      recordEnergy();
+      pollMqtt();
+      pollOta();
     }
-    vTaskDelay(10 / portTICK_PERIOD_MS);
+    nightSleep();
   }
 }
 
 // ================= ЯДРО 1 (Механика) =================
-void TaskTracker(void *pvParameters) {
+// Вольтметр: кадры DMA -> конвейер (передискретизация, фильтр, окно)
+void TaskAdc(void *pvParameters) {
+  static uint8_t frame[ADC_FRAME_BYTES];
+  static uint16_t raw[ADC_FRAME_BYTES / SOC_ADC_DIGI_RESULT_BYTES];
   while (true) {
-    xSemaphoreTake(dataMutex, portMAX_DELAY);
+    uint32_t len = 0;
+    adc_digi_read_bytes(frame, sizeof(frame), &len, portMAX_DELAY);
+    LatencyTimer t(adcCycle);
+    size_t n = 0;
+    for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= len;
+         i += SOC_ADC_DIGI_RESULT_BYTES) {
+      adc_digi_output_data_t *d = (adc_digi_output_data_t *)&frame[i];
+      if (d->type1.channel == ADC_CH_VOLTAGE)
+        raw[n++] = d->type1.data;
+    }
+    voltmeter.push(raw, n);
+  }
+}
 
-    // Замер напряжения
-    long sum = 0;
-    for (int i = 0; i < 10; i++) {
-      sum += analogRead(PIN_VOLTAGE);
-      vTaskDelay(2 / portTICK_PERIOD_MS);
+// Движение серво: шаг планировщика каждые 20 мс, без dataMutex
+void TaskMotion(void *pvParameters) {
+  TickType_t last = xTaskGetTickCount();
+  while (true) {
+    {
+      LatencyTimer t(motionCycle);
+      tracker.motion.step(MOTION_PERIOD_MS);
     }
-    float vPin = ((float)sum / 10.0 / 4095.0) * V_REF;
-    panelVolts = vPin * ((R1 + R2) / R2);
-
-    // Логика работы
-    if (mode != 0) {
-      isNight = false;
-      ensureServosAttached();
-
-      if (mode == 2) {
-        setServos(90, 90);
-      } else if (mode == 3) {
-        // Демо-режим (Плавное движение)
-        demoHor += demoDirHor * 2; // Шаг 2 градуса
-
-        if (demoHor >= 180) {
-          demoHor = 180;
-          demoDirHor = -1;
-        } else if (demoHor <= 0) {
-          demoHor = 0;
-          demoDirHor = 1;
-        }
-
-        // Вертикаль имитирует солнце (подъем в центре, опускание по краям)
-        // Математика: парабола, где на 90 градусах азимута наклон максимальный
-        // (verMax)
-        float progress = abs(demoHor - 90) / 90.0; // от 0 (центр) до 1 (края)
-        int targetV = cfg.verMax - (progress * (cfg.verMax - cfg.verMin));
-
-        setServos(demoHor, targetV);
-      }
-    } else if (mode == 0 && !isAPMode) {
-      time_t now;
-      time(&now);
-      if (now > 100000) {
-        SunPosition sun(cfg.lat, cfg.lon, now, cfg.gmt);
-        sunAz = sun.azimuth();
-        sunAlt = sun.altitude();
-
-        int targetHor = map(sunAz, 90, 270, 0, 180) + cfg.hOff;
-        int targetVer = sunAlt + cfg.vOff;
-
-        if (sunAlt <= 0) {
-          if (!isNight) {
-            isNight = true;
-            detachServos();
-          }
-        } else {
-          if (isNight) {
-            isNight = false;
-            smoothMove(targetHor, targetVer);
-          } else {
-            setServos(targetHor, targetVer);
-          }
-        }
-      }
+    if (tracker.motion.moving())
+      boot.mark(BOOT_FIRST_MOVE, millis());
+    vTaskDelayUntil(&last, MOTION_PERIOD_MS / portTICK_PERIOD_MS);
+  }
+}
+
+void TaskTracker(void *pvParameters) {
+  while (true) {
+    // Напряжение — готовое значение конвейера АЦП, O(1)
+    {
+      LatencyTimer t(trackerCycle);
+      tracker.measureVoltage();
+
+      lockData(trackerMutexWait);
+      tracker.applyCommands();
+      tracker.control();
+      tracker.publish();
+      xSemaphoreGive(dataMutex);
     }
+    boot.mark(BOOT_FIRST_CYCLE, millis());
 
-    xSemaphoreGive(dataMutex);
+    // Сон до следующего шага цели; команда из веба будит раньше
+    ulTaskNotifyTake(pdTRUE, tracker.cycleDelayMs() / portTICK_PERIOD_MS);
+  }
+}
 
-    // В демо-режиме цикл работает быстрее для плавности
-    if (mode == 3)
-      vTaskDelay(100 / portTICK_PERIOD_MS);
-    else
-      vTaskDelay(2000 / portTICK_PERIOD_MS);
+// Положение (и время) до перезагрузки. После deep sleep — из RTC-памяти;
+// после программного сброса часы RTC идут сами, а положение берётся из
+// последней точки истории на flash. Время с flash не восстанавливается:
+// после отключения питания неизвестной длительности оно бы увело панель
+void restoreState() {
+  bool resumed = esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_TIMER &&
+                 nightResume.magic == NIGHT_RESUME_MAGIC;
+  nightResume.magic = 0;
+  int hor = -1, ver = -1;
+  if (resumed) {
+    hor = nightResume.hor;
+    ver = nightResume.ver;
+    if (time(nullptr) <= 100000) {
+      timeval tv = {(time_t)(nightResume.sleptAt + nightResume.sleepS), 0};
+      settimeofday(&tv, nullptr);
+    }
+    Serial.println("[Boot] Пробуждение по RTC");
+  } else if (history.newest()) {
+    HistorySample last = {};
+    history.query(
+        history.newest(), history.newest(), 1,
+        [](const HistorySample &s, void *ctx) { *(HistorySample *)ctx = s; },
+        &last);
+    hor = last.hor;
+    ver = last.ver;
   }
+  if (hor >= 0) {
+    // Серво стоят там, где их оставили: утренний поворот — оттуда, а не
+    // рывком через 90/90
+    tracker.motion.reset(degToAngle(hor), degToAngle(ver));
+    tracker.currentHor = degToAngle(hor);
+    tracker.currentVer = degToAngle(ver);
+  }
+  if (time(nullptr) > 100000)
+    Serial.println("[Boot] Время из RTC, слежение без ожидания NTP");
 }
 
+// Загрузка не ждёт сети: задачи стартуют сразу, Wi-Fi и NTP — в TaskWeb
 void setup() {
+  boot.mark(BOOT_SETUP, millis());
   Serial.begin(115200);
-  delay(500);
-  analogReadResolution(12);
 
   Serial.println();
   Serial.println("==========================================");
@@ -538,76 +1222,52 @@ void setup() {
 
   dataMutex = xSemaphoreCreateMutex();
   loadSettings();
+  otaBoot();
+  boot.mark(BOOT_CONFIG, millis());
+  setupAdc();
+  if (!LittleFS.begin(true))
+    Serial.println("[FS] ОШИБКА: LittleFS недоступна, история только в RAM");
+  history.begin();
+  boot.mark(BOOT_STORAGE, millis());
+  restoreState();
+  boot.mark(BOOT_RESTORED, millis());
 
+  for (const HeadConfig &h : HEADS)
+    heads.addHead(h);
   ESP32PWM::allocateTimer(0);
   ESP32PWM::allocateTimer(1);
-  ensureServosAttached();
+  tracker.ensureServosAttached();
 
-  WiFi.disconnect(true);
-  delay(100);
+  configureEnergy();
+  tracker.aimAhead = true; // цель — ближайший градус, а не отстающий
 
-  if (String(cfg.ssid) != "") {
-    Serial.print("[WiFi] Подключение к сети: ");
+  WiFi.mode(WIFI_STA);
+  if (cfg.ssid[0]) {
+    Serial.print("[WiFi] Подключение в фоне к сети: ");
     Serial.println(cfg.ssid);
-    WiFi.mode(WIFI_STA);
-    WiFi.begin(cfg.ssid, cfg.pass);
-    int tries = 0;
-    while (WiFi.status() != WL_CONNECTED && tries < 20) {
-      delay(500);
-      Serial.print(".");
-      tries++;
-    }
-    Serial.println();
-    if (WiFi.status() != WL_CONNECTED) {
-      Serial.println("[WiFi] ОШИБКА подключения! Сброс настроек...");
-      cfg.magic = 0;
-      EEPROM.put(0, cfg);
-      EEPROM.commit();
-      ESP.restart();
-    }
   }
+  net.begin(millis(), cfg.ssid[0] != 0);
+  setupMqtt();
 
-  if (String(cfg.ssid) == "" || WiFi.status() != WL_CONNECTED) {
-    isAPMode = true;
-    WiFi.mode(WIFI_AP_STA);
-    WiFi.softAP("SolarTracker", "12345678");
-    Serial.println();
-    Serial.println("------------------------------------------");
-    Serial.println("  [РЕЖИМ НАСТРОЙКИ — Точка Доступа (AP)]");
-    Serial.println("------------------------------------------");
-    Serial.println("  WiFi сеть : SolarTracker");
-    Serial.println("  Пароль    : 12345678");
-    Serial.print("  IP адрес  : ");
-    Serial.println(WiFi.softAPIP());
-    Serial.println("  Откройте браузер и введите IP адрес выше");
-    Serial.println("------------------------------------------");
+  setupRouting();
+  if (http.begin()) {
+    boot.mark(BOOT_HTTP, millis());
+    Serial.println("[OK] Веб-сервер запущен на порту 80");
   } else {
-    isAPMode = false;
-    WiFi.mode(WIFI_STA);
-    configTime(cfg.gmt * 3600, 0, "pool.ntp.org", "time.nist.gov");
-    Serial.println();
-    Serial.println("------------------------------------------");
-    Serial.println("  [РАБОЧИЙ РЕЖИМ — Подключено к WiFi]");
-    Serial.println("------------------------------------------");
-    Serial.print("  Сеть      : ");
-    Serial.println(cfg.ssid);
-    Serial.print("  IP адрес  : ");
-    Serial.println(WiFi.localIP());
-    Serial.print("  GMT пояс  : +");
-    Serial.println(cfg.gmt);
-    Serial.println("  Откройте браузер и введите IP адрес выше");
-    Serial.println("------------------------------------------");
+    Serial.println("[HTTP] ОШИБКА: порт 80 занят");
   }
 
-  Serial.println("[OK] Веб-сервер запущен на порту 80");
+  xTaskCreatePinnedToCore(TaskWeb, "WebTask", WEB_STACK, NULL, 1, &webTask,
+                          0);
+  xTaskCreatePinnedToCore(TaskTracker, "TrackerTask", TRACKER_STACK, NULL, 1,
+                          &trackerTask, 1);
+  xTaskCreatePinnedToCore(TaskMotion, "MotionTask", MOTION_STACK, NULL, 2,
+                          &motionTask, 1);
+  xTaskCreatePinnedToCore(TaskAdc, "AdcTask", ADC_STACK, NULL, 1, &adcTask,
+                          1);
+  boot.mark(BOOT_TASKS, millis());
   Serial.println("[OK] FreeRTOS задачи запущены");
   Serial.println("==========================================");
-
-  setupRouting();
-  server.begin();
-
-  xTaskCreatePinnedToCore(TaskWeb, "WebTask", 8192, NULL, 1, NULL, 0);
-  xTaskCreatePinnedToCore(TaskTracker, "TrackerTask", 4096, NULL, 1, NULL, 1);
 }
 
 void loop() { vTaskDelete(NULL); }
\ No newline at end of file
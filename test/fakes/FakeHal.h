@@ -0,0 +1,295 @@
+#pragma once
+
+// Фейковая периферия для native-сборки: виртуальное время, АЦП-константа,
+// счётчик записей в серво, файлы и ключи в памяти, раздел OTA в файле и
+// эталонный NOAA-расчёт в double вместо SunPosition (библиотека завязана
+// на Arduino).
+
+#include <algorithm>
+#include <map>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "TrackerHal.h"
+
+class FakeClock : public HalClock {
+public:
+  explicit FakeClock(time_t start = 0) : ms((uint64_t)start * 1000) {}
+
+  time_t now() override { return (time_t)(ms / 1000); }
+  void delayMs(uint32_t d) override {
+    ms += d;
+    delayed += d;
+  }
+
+  void set(time_t t) { ms = (uint64_t)t * 1000; }
+  void advance(uint32_t s) { ms += (uint64_t)s * 1000; }
+
+  uint64_t ms;
+  uint64_t delayed = 0; // сколько мс задача "проспала"
+};
+
+// Постоянное сырое значение АЦП, пересчёт как при V_REF = 3.3 В
+class FakeAdc : public HalAdc {
+public:
+  explicit FakeAdc(int raw = 2048) : raw(raw) {}
+  float pinMilliVolts() override {
+    reads++;
+    return raw * 3300.0f / 4095.0f;
+  }
+
+  int raw;
+  long reads = 0;
+};
+
+class FakeServos : public HalActuator {
+public:
+  void attach() override {
+    isAttached = true;
+    attaches++;
+  }
+  void detach() override { isAttached = false; }
+  bool attached() override { return isAttached; }
+  void write(int h, int v) override {
+    horFine = h;
+    verFine = v;
+    hor = angleToDeg(h);
+    ver = angleToDeg(v);
+    writes++;
+  }
+
+  bool isAttached = false;
+  int hor = -1; // градусы
+  int ver = -1;
+  int horFine = -1; // как записано, 1/ANGLE_SCALE градуса
+  int verFine = -1;
+  long writes = 0;
+  long attaches = 0;
+};
+
+// Банк ШИМ: последний импульс на канал и число пачек
+class FakePwmBank : public HalPwmBank {
+public:
+  void attach(const uint8_t *p, int n) override {
+    pins.assign(p, p + n);
+    us.assign(n, 0);
+    attaches++;
+  }
+  void detach() override { detaches++; }
+  void write(const uint8_t *channels, const uint16_t *pulseUs,
+             int n) override {
+    for (int i = 0; i < n; ++i)
+      us[channels[i]] = pulseUs[i];
+    lastBatch = n;
+    batches++;
+  }
+
+  std::vector<uint8_t> pins;
+  std::vector<uint16_t> us;
+  int lastBatch = 0;
+  long batches = 0;
+  long attaches = 0;
+  long detaches = 0;
+};
+
+// Файлы в памяти; считает операции записи, как износ flash
+class FakeStorage : public HalStorage {
+public:
+  bool append(const char *path, const void *data, size_t len) override {
+    if (failWrites)
+      return false;
+    std::vector<uint8_t> &f = files[path];
+    f.insert(f.end(), (const uint8_t *)data, (const uint8_t *)data + len);
+    appends++;
+    bytesWritten += len;
+    return true;
+  }
+  size_t read(const char *path, size_t offset, void *buf,
+              size_t len) override {
+    auto it = files.find(path);
+    if (it == files.end() || offset >= it->second.size())
+      return 0;
+    size_t n = std::min(len, it->second.size() - offset);
+    memcpy(buf, it->second.data() + offset, n);
+    reads++;
+    return n;
+  }
+  size_t size(const char *path) override {
+    auto it = files.find(path);
+    return it == files.end() ? 0 : it->second.size();
+  }
+  void remove(const char *path) override { files.erase(path); }
+
+  std::map<std::string, std::vector<uint8_t>> files;
+  bool failWrites = false;
+  long appends = 0;
+  long reads = 0;
+  long bytesWritten = 0;
+};
+
+// Ключ-значение в памяти; считает записи, как износ NVS
+class FakeKeyValue : public HalKeyValue {
+public:
+  size_t get(const char *key, void *buf, size_t len) override {
+    auto it = values.find(key);
+    if (it == values.end() || it->second.size() > len)
+      return 0;
+    memcpy(buf, it->second.data(), it->second.size());
+    return it->second.size();
+  }
+  bool put(const char *key, const void *data, size_t len) override {
+    values[key].assign((const uint8_t *)data, (const uint8_t *)data + len);
+    puts++;
+    return true;
+  }
+
+  std::map<std::string, std::vector<uint8_t>> values;
+  long puts = 0;
+};
+
+// Раздел OTA во временном файле с семантикой flash: стирание секторами
+// в 0xFF, запись поверх нестёртого — ошибка
+class FileOtaPartition : public HalOtaPartition {
+public:
+  explicit FileOtaPartition(size_t bytes, size_t sector = 4096)
+      : bytes(bytes), sector(sector), f(tmpfile()) {
+    std::vector<uint8_t> junk(bytes, 0x5A); // "старая прошивка"
+    fwrite(junk.data(), 1, bytes, f);
+    fflush(f);
+  }
+  ~FileOtaPartition() override { fclose(f); }
+
+  size_t size() override { return bytes; }
+  bool erase(size_t offset, size_t len) override {
+    if (offset % sector || len % sector || offset + len > bytes)
+      return false;
+    std::vector<uint8_t> ff(len, 0xFF);
+    erases += len / sector;
+    return put(offset, ff.data(), len);
+  }
+  bool write(size_t offset, const void *data, size_t len) override {
+    std::vector<uint8_t> old(len);
+    if (failWrites || !read(offset, old.data(), len))
+      return false;
+    for (uint8_t b : old)
+      if (b != 0xFF)
+        return false;
+    written += len;
+    return put(offset, data, len);
+  }
+  bool read(size_t offset, void *buf, size_t len) override {
+    if (offset + len > bytes || fseek(f, (long)offset, SEEK_SET))
+      return false;
+    return fread(buf, 1, len, f) == len;
+  }
+  bool activate() override { return ++activations, true; }
+
+  // Испортить байт "на flash" — как сбой записи
+  void corrupt(size_t offset) {
+    uint8_t b;
+    read(offset, &b, 1);
+    b ^= 0x01;
+    put(offset, &b, 1);
+  }
+
+  size_t bytes, sector;
+  long erases = 0, written = 0, activations = 0;
+  bool failWrites = false;
+
+private:
+  bool put(size_t offset, const void *data, size_t len) {
+    if (fseek(f, (long)offset, SEEK_SET) || fwrite(data, 1, len, f) != len)
+      return false;
+    return fflush(f) == 0;
+  }
+
+  FILE *f;
+};
+
+// Алгоритм NOAA (General Solar Position) в double — эталон для тестов
+inline void noaaSunPosition(double lat, double lon, time_t now, double &az,
+                            double &alt) {
+  const double D2R = M_PI / 180.0;
+  double jd = (double)now / 86400.0 + 2440587.5;
+  double t = (jd - 2451545.0) / 36525.0;
+
+  double l0 = fmod(280.46646 + t * (36000.76983 + t * 0.0003032), 360.0);
+  double m = 357.52911 + t * (35999.05029 - 0.0001537 * t);
+  double e = 0.016708634 - t * (0.000042037 + 0.0000001267 * t);
+  double c = sin(m * D2R) * (1.914602 - t * (0.004817 + 0.000014 * t)) +
+             sin(2 * m * D2R) * (0.019993 - 0.000101 * t) +
+             sin(3 * m * D2R) * 0.000289;
+  double omega = 125.04 - 1934.136 * t;
+  double lambda = l0 + c - 0.00569 - 0.00478 * sin(omega * D2R);
+  double eps0 =
+      23.0 +
+      (26.0 + (21.448 - t * (46.815 + t * (0.00059 - t * 0.001813))) / 60.0) /
+          60.0;
+  double eps = eps0 + 0.00256 * cos(omega * D2R);
+  double decl = asin(sin(eps * D2R) * sin(lambda * D2R));
+
+  double y = tan(eps * D2R / 2);
+  y *= y;
+  double eot = 4.0 / D2R *
+               (y * sin(2 * l0 * D2R) - 2 * e * sin(m * D2R) +
+                4 * e * y * sin(m * D2R) * cos(2 * l0 * D2R) -
+                0.5 * y * y * sin(4 * l0 * D2R) -
+                1.25 * e * e * sin(2 * m * D2R));
+
+  double minutes = fmod((double)now, 86400.0) / 60.0;
+  double tst = fmod(minutes + eot + 4.0 * lon, 1440.0);
+  if (tst < 0)
+    tst += 1440.0;
+  double ha = tst / 4.0 - 180.0;
+
+  double la = lat * D2R;
+  double cosZ =
+      sin(la) * sin(decl) + cos(la) * cos(decl) * cos(ha * D2R);
+  if (cosZ > 1)
+    cosZ = 1;
+  if (cosZ < -1)
+    cosZ = -1;
+  double zen = acos(cosZ);
+  alt = 90.0 - zen / D2R;
+
+  double den = cos(la) * sin(zen);
+  double a = 0;
+  if (fabs(den) > 1e-9) {
+    double ca = (sin(la) * cos(zen) - sin(decl)) / den;
+    if (ca > 1)
+      ca = 1;
+    if (ca < -1)
+      ca = -1;
+    a = acos(ca) / D2R;
+  }
+  az = ha > 0 ? fmod(a + 180.0, 360.0) : fmod(540.0 - a, 360.0);
+}
+
+class NoaaSun : public HalSun {
+public:
+  void position(const Config &cfg, time_t now, float &az,
+                float &alt) override {
+    double a, h;
+    noaaSunPosition(cfg.lat, cfg.lon, now, a, h);
+    az = a;
+    alt = h;
+    calls++;
+  }
+
+  long calls = 0;
+};
+
+// Настройки по умолчанию (как в loadSettings())
+inline Config defaultConfig() {
+  Config c = {};
+  c.magic = 123;
+  c.gmt = 5;
+  c.lat = 51.1333;
+  c.lon = 71.4333;
+  c.verMin = 15;
+  c.verMax = 90;
+  return c;
+}
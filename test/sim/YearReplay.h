@@ -0,0 +1,244 @@
+#pragma once
+
+// Ускоренный прогон года на хосте: ядро трекера (TrackerCore + эфемериды +
+// планировщик движения + ActuatorArray, как на ESP32) работает от
+// виртуальных часов, серво — модель с конечной скоростью поворота за
+// банком ШИМ. Каждые REPLAY_SAMPLE_S фактическое
+// направление панели сравнивается с эталонным NOAA-расчётом в double.
+//
+// Сутки независимы: каждые начинаются с прогрева от полудня предыдущих
+// (вечерняя парковка, ночь, утренний поворот), поэтому считаются
+// параллельно на всех ядрах. Итог складывается в порядке дней — результат
+// не зависит от числа потоков и воспроизводится бит в бит.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <math.h>
+#include <thread>
+#include <vector>
+
+#include "ActuatorArray.h"
+#include "FakeHal.h"
+#include "SolarEphemeris.h"
+#include "SolarKernel.h"
+#include "TrackerCore.h"
+
+const float SERVO_TRAVEL_DEG_S = 350.0f; // MG996R: 0.17 с на 60°
+const int REPLAY_SAMPLE_S = 60;
+const int REPLAY_WARMUP_S = 12 * 3600;
+
+// Пара серво за банком ШИМ (каналы 0, 1 — оси, линейная кривая):
+// физический угол догоняет импульс с конечной скоростью, без питания стоит
+class ServoModel : public HalPwmBank {
+public:
+  explicit ServoModel(FakeClock &clk) : clk(clk), at(clk.ms) {}
+
+  void attach(const uint8_t *, int) override {
+    settle();
+    powered = true;
+    attaches++;
+  }
+  void detach() override {
+    settle();
+    powered = false;
+  }
+  void write(const uint8_t *channels, const uint16_t *pulseUs,
+             int n) override {
+    settle();
+    for (int i = 0; i < n; ++i)
+      cmd[channels[i]] = (pulseUs[i] - SERVO_MIN_US) * 180.0f /
+                         (SERVO_MAX_US - SERVO_MIN_US);
+    writes++;
+  }
+
+  // Довести физические углы до момента clk.ms
+  void settle() {
+    float dt = (clk.ms - at) / 1000.0f;
+    at = clk.ms;
+    if (!powered)
+      return;
+    for (int i = 0; i < AXIS_COUNT; ++i) {
+      float d = cmd[i] - pos[i];
+      float m = fminf(fabsf(d), SERVO_TRAVEL_DEG_S * dt);
+      pos[i] += copysignf(m, d);
+      travel += m;
+    }
+  }
+
+  float pos[AXIS_COUNT] = {90, 90};
+  float cmd[AXIS_COUNT] = {90, 90};
+  double travel = 0; // градусов по обеим осям
+  long writes = 0;
+  long attaches = 0;
+
+private:
+  FakeClock &clk;
+  uint64_t at;
+  bool powered = false;
+};
+
+struct ReplayStats {
+  long daylightS = 0;   // Солнце над горизонтом
+  long outOfRangeS = 0; // азимут вне хода горизонтального серво
+  long clampedS = 0;    // высота упирается в verMin/verMax
+  long trackedS = 0;    // остальное дневное время
+  double errSum = 0;    // ошибка наведения на trackedS, градусы
+  double errMax = 0;
+  double errAllSum = 0; // на всём дневном времени (с упором в пределы)
+  double travelDeg = 0;
+  long writes = 0;
+  long attaches = 0;
+  long wakeups = 0;
+  long motionSteps = 0;
+
+  double meanErr() const {
+    return trackedS ? errSum * REPLAY_SAMPLE_S / trackedS : 0;
+  }
+  double meanErrAll() const {
+    return daylightS ? errAllSum * REPLAY_SAMPLE_S / daylightS : 0;
+  }
+
+  void add(const ReplayStats &o) {
+    daylightS += o.daylightS;
+    outOfRangeS += o.outOfRangeS;
+    clampedS += o.clampedS;
+    trackedS += o.trackedS;
+    errSum += o.errSum;
+    errMax = std::max(errMax, o.errMax);
+    errAllSum += o.errAllSum;
+    travelDeg += o.travelDeg;
+    writes += o.writes;
+    attaches += o.attaches;
+    wakeups += o.wakeups;
+    motionSteps += o.motionSteps;
+  }
+};
+
+// Настройки слежения: шаг цели и зона нечувствительности серво
+struct ReplayTuning {
+  int quantum = TRACK_QUANTUM;
+  uint16_t deadBandUs = ACT_DEAD_BAND_US;
+};
+
+// Сутки [dayStart, dayStart + 86400) с прогревом REPLAY_WARMUP_S
+inline ReplayStats replayDay(const Config &site, time_t dayStart,
+                             const ReplayTuning &tune = ReplayTuning()) {
+  Config cfg = site;
+  FakeClock clk(dayStart - REPLAY_WARMUP_S);
+  FakeAdc adc;
+  KernelSun kernel;
+  SolarEphemeris sun(kernel);
+  ServoModel servo(clk);
+  ActuatorArray head(servo);
+  head.addHead({0, 1, 0, 0, 0, 180, 0, 180});
+  head.deadBandUs = tune.deadBandUs;
+  TrackerCore core(cfg, clk, adc, head, sun);
+  core.aimAhead = true;
+  core.trackQuantum = tune.quantum;
+
+  const uint64_t begin = (uint64_t)dayStart * 1000;
+  const uint64_t end = begin + 86400 * 1000ULL;
+  uint64_t nextWake = clk.ms, nextStep = clk.ms, nextSample = begin;
+  bool stepping = false;
+  double travel0 = 0;
+  long writes0 = 0, attaches0 = 0;
+  ReplayStats d;
+
+  while (clk.ms < end) {
+    bool counting = clk.ms >= begin;
+    if (clk.ms >= nextWake) {
+      core.cycle();
+      nextWake = clk.ms + core.cycleDelayMs();
+      d.wakeups += counting;
+      if (!stepping) // задача движения — на своей сетке 20 мс
+        nextStep = (clk.ms + MOTION_PERIOD_MS - 1) / MOTION_PERIOD_MS *
+                   MOTION_PERIOD_MS;
+      stepping = true;
+    }
+    if (stepping && clk.ms >= nextStep) {
+      core.motion.step(MOTION_PERIOD_MS);
+      nextStep += MOTION_PERIOD_MS;
+      d.motionSteps += counting;
+      stepping = core.motion.moving();
+    }
+    if (clk.ms >= nextSample) {
+      if (nextSample == begin) {
+        servo.settle();
+        travel0 = servo.travel;
+        writes0 = servo.writes;
+        attaches0 = servo.attaches;
+      }
+      nextSample += REPLAY_SAMPLE_S * 1000;
+      double az, alt;
+      noaaSunPosition(cfg.lat, cfg.lon, clk.now(), az, alt);
+      if (alt > 0) {
+        servo.settle();
+        // Панель смонтирована так, что поправки точно компенсируют монтаж
+        float panelAz = servo.pos[AXIS_HOR] - cfg.hOff + 90;
+        float panelAlt = servo.pos[AXIS_VER] - cfg.vOff;
+        double err = pointingError(panelAz, panelAlt, az, alt);
+        int hor = azimuthToHor(az, cfg.hOff);
+        int ver = altitudeToVer(alt, cfg.vOff);
+        d.daylightS += REPLAY_SAMPLE_S;
+        d.errAllSum += err;
+        if (hor < 0 || hor > degToAngle(180)) {
+          d.outOfRangeS += REPLAY_SAMPLE_S;
+        } else if (ver < degToAngle(cfg.verMin) ||
+                   ver > degToAngle(cfg.verMax)) {
+          d.clampedS += REPLAY_SAMPLE_S;
+        } else {
+          d.trackedS += REPLAY_SAMPLE_S;
+          d.errSum += err;
+          d.errMax = std::max(d.errMax, err);
+        }
+      }
+    }
+    // Следующее событие; простой планировщика движения пропускается
+    uint64_t next = std::min(nextWake, nextSample);
+    if (stepping)
+      next = std::min(next, nextStep);
+    clk.ms = std::min(next, end);
+  }
+  servo.settle();
+  d.travelDeg = servo.travel - travel0;
+  d.writes = servo.writes - writes0;
+  d.attaches = servo.attaches - attaches0;
+  return d;
+}
+
+struct ReplayReport {
+  ReplayStats total;
+  int days = 0;
+  int threads = 0;
+  double wallMs = 0;
+};
+
+// days суток с yearStart; threads = 0 — по числу ядер
+inline ReplayReport replayYear(const Config &cfg, time_t yearStart,
+                               int days = 365, int threads = 0,
+                               const ReplayTuning &tune = ReplayTuning()) {
+  if (threads <= 0)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<ReplayStats> perDay(days);
+  std::atomic<int> nextDay{0};
+  auto t0 = std::chrono::steady_clock::now();
+  std::vector<std::thread> pool;
+  for (int i = 0; i < threads; ++i)
+    pool.emplace_back([&] {
+      for (int day; (day = nextDay.fetch_add(1)) < days;)
+        perDay[day] = replayDay(cfg, yearStart + (time_t)day * 86400, tune);
+    });
+  for (std::thread &t : pool)
+    t.join();
+
+  ReplayReport r;
+  for (const ReplayStats &d : perDay)
+    r.total.add(d);
+  r.days = days;
+  r.threads = threads;
+  r.wallMs = std::chrono::duration<double, std::milli>(
+                 std::chrono::steady_clock::now() - t0)
+                 .count();
+  return r;
+}
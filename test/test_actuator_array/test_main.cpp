@@ -0,0 +1,277 @@
+// Несколько голов трекера на одном контроллере: pio test -e native
+#include <unity.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ActuatorArray.h"
+#include "FakeHal.h"
+#include "SolarKernel.h"
+#include "TrackerCore.h"
+
+static const time_t SUMMER_NOON = 1782026100; // 2026-06-21 07:15 UTC
+
+static const HeadConfig PLAIN = {5, 18, 0, 0, 0, 180, 0, 180};
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_fans_out_with_offsets_and_limits(void) {
+  FakePwmBank bank;
+  ActuatorArray arr(bank);
+  TEST_ASSERT_EQUAL(0, arr.addHead(PLAIN));
+  TEST_ASSERT_EQUAL(1, arr.addHead({19, 23, 3, -2, 0, 180, 10, 60}));
+  TEST_ASSERT_EQUAL(2, arr.heads());
+  arr.attach();
+  TEST_ASSERT_EQUAL(4, (int)bank.pins.size());
+  TEST_ASSERT_EQUAL(23, bank.pins[3]);
+
+  arr.write(degToAngle(100), degToAngle(70));
+  TEST_ASSERT_EQUAL(degToAngle(100), arr.target(0, AXIS_HOR));
+  TEST_ASSERT_EQUAL(degToAngle(103), arr.target(1, AXIS_HOR));
+  // 68 -> предел головы
+  TEST_ASSERT_EQUAL(degToAngle(60), arr.target(1, AXIS_VER));
+  TEST_ASSERT_EQUAL(servoAngleToUs(103), bank.us[2]);
+  TEST_ASSERT_EQUAL(SERVO_MIN_US, servoAngleToUs(0));
+  TEST_ASSERT_EQUAL(SERVO_MAX_US, servoAngleToUs(180));
+
+  arr.write(degToAngle(178), degToAngle(5));
+  TEST_ASSERT_EQUAL(servoAngleToUs(180), arr.pulse(1, AXIS_HOR));
+  TEST_ASSERT_EQUAL(servoAngleToUs(10), arr.pulse(1, AXIS_VER));
+}
+
+// Кривая калибровки: точки — как заданы, между ними линейно с
+// округлением, за пределами 0..180° — крайние импульсы
+void test_calibration_curve(void) {
+  TEST_ASSERT_EQUAL(1450, servoAngleToUs(90));
+  TEST_ASSERT_EQUAL(511, servoCurveUs(LINEAR_SERVO_CURVE, 106)); // 1.06°
+  TEST_ASSERT_EQUAL(500, servoCurveUs(LINEAR_SERVO_CURVE, -300));
+  TEST_ASSERT_EQUAL(2400, servoCurveUs(LINEAR_SERVO_CURVE, 19000));
+
+  // Серво с "ленивым" концом хода и обратной вертикалью
+  static const ServoCurve worn = {{560, 1000, 1480, 1960, 2330}};
+  static const ServoCurve reversed = {{2400, 1925, 1450, 975, 500}};
+  FakePwmBank bank;
+  ActuatorArray arr(bank);
+  HeadConfig h = PLAIN;
+  h.curveHor = &worn;
+  h.curveVer = &reversed;
+  arr.addHead(h);
+  arr.attach();
+  arr.write(degToAngle(45), 4500 + 2250); // 67.5°
+  TEST_ASSERT_EQUAL(1000, bank.us[0]);
+  TEST_ASSERT_EQUAL(1687, bank.us[1]); // середина 1925..1450
+  arr.write(17550, 0); // 175.5°
+  TEST_ASSERT_EQUAL(2293, bank.us[0]);
+  TEST_ASSERT_EQUAL(2400, bank.us[1]);
+}
+
+// Доли градуса, не меняющие импульс (1 мкс ≈ 0.105°), в банк не уходят
+void test_sub_microsecond_steps_coalesce(void) {
+  FakePwmBank bank;
+  ActuatorArray arr(bank);
+  arr.addHead(PLAIN);
+  arr.attach();
+  for (int a = degToAngle(90); a <= degToAngle(91); ++a)
+    arr.write(a, degToAngle(45));
+  // 101 шаг по 0.01° -> 12 разных импульсов, 1450..1461 мкс
+  TEST_ASSERT_EQUAL(servoAngleToUs(91), bank.us[0]);
+  TEST_ASSERT_EQUAL(12, bank.batches);
+}
+
+// Поворот планировщиком на 60° и слежение шагами по 0.1° с остановкой
+// после каждого: пачек в банк и худшее отклонение импульса от цели
+struct BandRun {
+  long sweep, track;
+  int errUs;
+};
+
+static BandRun runBand(uint16_t deadBandUs) {
+  FakePwmBank bank;
+  ActuatorArray arr(bank);
+  arr.addHead(PLAIN);
+  arr.deadBandUs = deadBandUs;
+  MotionPlanner mp(arr, degToAngle(30), degToAngle(45));
+  mp.power(true);
+  mp.step(MOTION_PERIOD_MS);
+  BandRun r = {0, 0, 0};
+  long b0 = bank.batches;
+  mp.moveTo(degToAngle(90), degToAngle(45));
+  do
+    mp.step(MOTION_PERIOD_MS);
+  while (mp.moving());
+  r.sweep = bank.batches - b0;
+  b0 = bank.batches;
+  for (int k = 1; k <= 50; ++k) {
+    int goal = degToAngle(90) + k * ANGLE_SCALE / 10;
+    mp.moveTo(goal, degToAngle(45));
+    do
+      mp.step(MOTION_PERIOD_MS);
+    while (mp.moving());
+    int err = abs(bank.us[0] - servoCurveUs(LINEAR_SERVO_CURVE, goal));
+    r.errUs = std::max(r.errUs, err);
+  }
+  r.track = bank.batches - b0;
+  return r;
+}
+
+// Зона нечувствительности прореживает записи только в движении:
+// остановка всегда точно в цель, шаг слежения — одна запись
+void test_dead_band_only_while_moving(void) {
+  const uint16_t bands[] = {0, ACT_DEAD_BAND_US, 2 * ACT_DEAD_BAND_US};
+  BandRun r[3];
+  for (int i = 0; i < 3; ++i) {
+    r[i] = runBand(bands[i]);
+    char msg[112];
+    snprintf(msg, sizeof(msg),
+             "dead band %2u us: 60 deg %ld writes, 50 x 0.1 deg %ld writes, "
+             "max error %d us",
+             bands[i], r[i].sweep, r[i].track, r[i].errUs);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_EQUAL(0, r[i].errUs);
+  }
+  TEST_ASSERT_LESS_THAN(r[0].sweep, r[1].sweep);
+  TEST_ASSERT_LESS_THAN(r[1].sweep, r[2].sweep);
+  TEST_ASSERT_LESS_OR_EQUAL(61, r[1].sweep); // запись на градус пути
+  TEST_ASSERT_LESS_OR_EQUAL(50, r[1].track); // не больше записи на шаг
+  TEST_ASSERT_EQUAL(r[1].track, r[2].track);
+}
+
+// Ручной режим: /api/setManual 90 -> 90.3° (~3 мкс) — ровно одна
+// запись, импульс точно по цели
+void test_manual_fraction_writes_once(void) {
+  Config cfg = defaultConfig();
+  FakeClock clk(SUMMER_NOON);
+  FakeAdc adc;
+  KernelSun sun;
+  FakePwmBank bank;
+  ActuatorArray arr(bank);
+  arr.addHead(PLAIN);
+  TrackerCore core(cfg, clk, adc, arr, sun);
+  core.commands.post(CMD_MODE, MODE_MANUAL);
+  core.commands.post(CMD_HOR, degToAngle(90));
+  core.commands.post(CMD_VER, degToAngle(45));
+  core.applyCommands();
+  for (int i = 0; i < 500; ++i)
+    core.motion.step(MOTION_PERIOD_MS);
+  TEST_ASSERT_FALSE(core.motion.moving());
+
+  long b0 = bank.batches;
+  core.commands.post(CMD_HOR, 9030);
+  core.applyCommands();
+  for (int i = 0; i < 100; ++i)
+    core.motion.step(MOTION_PERIOD_MS);
+  TEST_ASSERT_EQUAL(1, bank.batches - b0);
+  TEST_ASSERT_EQUAL(1, bank.lastBatch);
+  TEST_ASSERT_EQUAL(servoCurveUs(LINEAR_SERVO_CURVE, 9030), bank.us[0]);
+  TEST_ASSERT_EQUAL(servoAngleToUs(90) + 3, bank.us[0]);
+}
+
+void test_batches_only_changed_channels(void) {
+  FakePwmBank bank;
+  ActuatorArray arr(bank);
+  for (int i = 0; i < ACT_MAX_HEADS; ++i)
+    TEST_ASSERT_EQUAL(i, arr.addHead(PLAIN));
+  TEST_ASSERT_EQUAL(-1, arr.addHead(PLAIN));
+
+  const int H90 = degToAngle(90), H91 = degToAngle(91), V45 = degToAngle(45);
+  arr.write(H90, V45); // без питания — в банк не пишется
+  TEST_ASSERT_EQUAL(0, bank.batches);
+  arr.attach();
+  arr.write(H90, V45); // после attach — все каналы одной пачкой
+  TEST_ASSERT_EQUAL(1, bank.batches);
+  TEST_ASSERT_EQUAL(ACT_MAX_CHANNELS, bank.lastBatch);
+
+  arr.write(H91, V45); // сменилась одна ось — только её каналы
+  TEST_ASSERT_EQUAL(2, bank.batches);
+  TEST_ASSERT_EQUAL(ACT_MAX_HEADS, bank.lastBatch);
+  arr.write(H91, V45);
+  TEST_ASSERT_EQUAL(2, bank.batches);
+  TEST_ASSERT_EQUAL(ACT_MAX_CHANNELS + ACT_MAX_HEADS, arr.channelWrites);
+}
+
+void test_pca9685_timing(void) {
+  TEST_ASSERT_EQUAL(121, pca9685Prescale(SERVO_PWM_HZ));
+  TEST_ASSERT_EQUAL(307, pca9685Ticks(1500, SERVO_PWM_HZ));
+  TEST_ASSERT_EQUAL(102, pca9685Ticks(SERVO_MIN_US, SERVO_PWM_HZ));
+  TEST_ASSERT_EQUAL(492, pca9685Ticks(SERVO_MAX_US, SERVO_PWM_HZ));
+}
+
+// Цикл трекера + шаг движения: N голов от одной траектории против
+// N независимых трекеров (Солнце и профиль на каждую голову)
+static double benchShared(int heads, int cycles) {
+  Config cfg = defaultConfig();
+  FakeClock clk(SUMMER_NOON);
+  FakeAdc adc;
+  KernelSun sun;
+  FakePwmBank bank;
+  ActuatorArray arr(bank);
+  for (int i = 0; i < heads; ++i)
+    arr.addHead({0, 1, (int8_t)i, (int8_t)-i, 0, 180, 0, 180});
+  TrackerCore core(cfg, clk, adc, arr, sun);
+  core.ensureServosAttached();
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < cycles; ++i) {
+    core.control();
+    core.motion.step(MOTION_PERIOD_MS);
+    clk.advance(2);
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() / cycles;
+}
+
+static double benchSeparate(int heads, int cycles) {
+  Config cfg = defaultConfig();
+  FakeClock clk(SUMMER_NOON);
+  FakeAdc adc;
+  KernelSun sun;
+  std::vector<FakeServos> servos(heads);
+  std::vector<std::unique_ptr<TrackerCore>> cores;
+  for (int i = 0; i < heads; ++i) {
+    cores.emplace_back(new TrackerCore(cfg, clk, adc, servos[i], sun));
+    cores.back()->ensureServosAttached();
+  }
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < cycles; ++i) {
+    for (auto &core : cores) {
+      core->control();
+      core->motion.step(MOTION_PERIOD_MS);
+    }
+    clk.advance(2);
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() / cycles;
+}
+
+void test_bench_heads(void) {
+  const int N = 50000;
+  char msg[96];
+  double shared8 = 0, separate8 = 0;
+  for (int heads = 1; heads <= ACT_MAX_HEADS; heads *= 2) {
+    double shared = benchShared(heads, N);
+    double separate = benchSeparate(heads, N);
+    snprintf(msg, sizeof(msg),
+             "%d heads: shared %.1f ns/cycle, separate %.1f ns/cycle",
+             heads, shared, separate);
+    TEST_MESSAGE(msg);
+    shared8 = shared;
+    separate8 = separate;
+  }
+  TEST_ASSERT_TRUE(shared8 < separate8);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_fans_out_with_offsets_and_limits);
+  RUN_TEST(test_calibration_curve);
+  RUN_TEST(test_sub_microsecond_steps_coalesce);
+  RUN_TEST(test_dead_band_only_while_moving);
+  RUN_TEST(test_manual_fraction_writes_once);
+  RUN_TEST(test_batches_only_changed_channels);
+  RUN_TEST(test_pca9685_timing);
+  RUN_TEST(test_bench_heads);
+  return UNITY_END();
+}
@@ -0,0 +1,138 @@
+// Конвейер вольтметра (передискретизация, фильтры, окно): pio test -e native
+#include <unity.h>
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "AdcPipeline.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static const AdcPipelineConfig RAW_CFG = {1, ADC_FILTER_NONE, 1.0};
+
+void test_oversample_and_calibration(void) {
+  AdcPipelineConfig c = {4, ADC_FILTER_NONE, 1.0};
+  AdcPipeline p(c);
+  uint16_t raw[] = {4095, 4095, 4095, 4095, 0, 0, 0};
+  p.push(raw, 7);
+  VoltageWindow w = p.window();
+  TEST_ASSERT_EQUAL(1, w.total); // неполная группа не публикуется
+  TEST_ASSERT_FLOAT_WITHIN(0.5, 3300.0, p.pinMilliVolts());
+
+  // Калибровка eFuse: наклон и смещение
+  AdcCalibration cal = {65536, 100}; // 1 мВ на отсчёт + 100 мВ
+  p.configure(RAW_CFG, cal);
+  uint16_t one[] = {1000};
+  p.push(one, 1);
+  TEST_ASSERT_FLOAT_WITHIN(0.01, 1100.0, p.pinMilliVolts());
+}
+
+void test_median_rejects_spikes(void) {
+  AdcPipeline p({1, ADC_FILTER_MEDIAN, 1.0}, {65536, 0});
+  uint16_t raw[] = {1000, 1000, 4095, 1000, 1000, 0, 1000};
+  for (uint16_t r : raw) {
+    p.push(&r, 1);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 1000.0, p.pinMilliVolts());
+  }
+}
+
+void test_iir_smoothing(void) {
+  AdcPipeline p({1, ADC_FILTER_IIR, 0.5}, {65536, 0});
+  uint16_t a = 1000, b = 2000;
+  p.push(&a, 1);
+  p.push(&b, 1);
+  TEST_ASSERT_FLOAT_WITHIN(0.01, 1500.0, p.pinMilliVolts());
+  p.push(&b, 1);
+  TEST_ASSERT_FLOAT_WITHIN(0.01, 1750.0, p.pinMilliVolts());
+}
+
+// min/max/mean окна против полного перебора
+void test_window_stats_match_bruteforce(void) {
+  AdcPipeline p(RAW_CFG, {65536, 0});
+  static float hist[5000];
+  srand(42);
+  for (int i = 0; i < 5000; i++) {
+    uint16_t r = rand() % 4096;
+    hist[i] = r;
+    p.push(&r, 1);
+    if (i % 37)
+      continue;
+    int from = i + 1 > ADC_WINDOW ? i + 1 - ADC_WINDOW : 0;
+    float mn = 1e9, mx = -1e9;
+    double sum = 0;
+    for (int j = from; j <= i; j++) {
+      mn = fminf(mn, hist[j]);
+      mx = fmaxf(mx, hist[j]);
+      sum += hist[j];
+    }
+    VoltageWindow w = p.window();
+    TEST_ASSERT_EQUAL(i + 1 - from, w.count);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, mn, w.min);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, mx, w.max);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, sum / (i + 1 - from), w.mean);
+  }
+}
+
+// Месяцы работы в ускоренном виде: миллионы дробных значений, затем
+// окно постоянного — среднее ровно это значение, без накопленной ошибки
+void test_long_run_does_not_drift(void) {
+  AdcPipeline p({3, ADC_FILTER_NONE, 1.0}, {52813, 7});
+  uint16_t raw[3];
+  srand(3);
+  const uint32_t N = 3000000;
+  for (uint32_t i = 0; i < N; i++) {
+    for (uint16_t &r : raw)
+      r = rand() % 4096;
+    p.push(raw, 3);
+  }
+  raw[0] = raw[1] = raw[2] = 1234;
+  for (int i = 0; i < ADC_WINDOW; i++)
+    p.push(raw, 3);
+  VoltageWindow w = p.window();
+  TEST_ASSERT_EQUAL(N + ADC_WINDOW, w.total);
+  TEST_ASSERT_EQUAL(ADC_WINDOW, w.count);
+  TEST_ASSERT_EQUAL_FLOAT(w.latest, w.min);
+  TEST_ASSERT_EQUAL_FLOAT(w.latest, w.max);
+  TEST_ASSERT_FLOAT_WITHIN(0.0005, w.latest, w.mean); // округление до 1 мкВ
+}
+
+void test_bench_push_and_read(void) {
+  AdcPipeline p;
+  static uint16_t frame[1000];
+  for (int i = 0; i < 1000; i++)
+    frame[i] = 2000 + (i * 7919) % 97;
+  const int FRAMES = 2000;
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < FRAMES; i++)
+    p.push(frame, 1000);
+  auto t1 = std::chrono::steady_clock::now();
+  volatile float sink = 0;
+  for (int i = 0; i < 1000000; i++)
+    sink = sink + p.pinMilliVolts();
+  auto t2 = std::chrono::steady_clock::now();
+
+  double pushNs = std::chrono::duration<double, std::nano>(t1 - t0).count() /
+                  (FRAMES * 1000.0);
+  double readNs =
+      std::chrono::duration<double, std::nano>(t2 - t1).count() / 1e6;
+  char msg[96];
+  snprintf(msg, sizeof(msg), "push %.2f ns/raw sample, latest() %.1f ns",
+           pushNs, readNs);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_EQUAL(FRAMES * 1000 / DEFAULT_ADC_PIPELINE.oversample,
+                    p.window().total);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_oversample_and_calibration);
+  RUN_TEST(test_median_rejects_spikes);
+  RUN_TEST(test_iir_smoothing);
+  RUN_TEST(test_window_stats_match_bruteforce);
+  RUN_TEST(test_long_run_does_not_drift);
+  RUN_TEST(test_bench_push_and_read);
+  return UNITY_END();
+}
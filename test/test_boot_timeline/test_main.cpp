@@ -0,0 +1,39 @@
+// Время этапов загрузки: pio test -e native
+#include <unity.h>
+
+#include <string.h>
+
+#include "BootTimeline.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_first_mark_wins(void) {
+  BootTimeline boot;
+  TEST_ASSERT_FALSE(boot.done(BOOT_FIRST_MOVE));
+  boot.mark(BOOT_FIRST_MOVE, 420);
+  boot.mark(BOOT_FIRST_MOVE, 9000);
+  TEST_ASSERT_TRUE(boot.done(BOOT_FIRST_MOVE));
+  TEST_ASSERT_EQUAL(420, boot.ms(BOOT_FIRST_MOVE));
+  boot.mark(BOOT_SETUP, 0); // ноль — тоже отметка
+  TEST_ASSERT_TRUE(boot.done(BOOT_SETUP));
+}
+
+void test_json_lists_passed_phases(void) {
+  BootTimeline boot;
+  boot.mark(BOOT_SETUP, 31);
+  boot.mark(BOOT_TASKS, 140);
+  boot.mark(BOOT_FIRST_MOVE, 162);
+  char buf[128];
+  JsonWriter w(buf, sizeof(buf));
+  boot.write(w);
+  TEST_ASSERT_EQUAL_STRING("{\"setup\":31,\"tasks\":140,\"firstMove\":162}",
+                           w.c_str());
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_first_mark_wins);
+  RUN_TEST(test_json_lists_passed_phases);
+  return UNITY_END();
+}
@@ -0,0 +1,188 @@
+// Почтовый ящик команд "последнее побеждает": pio test -e native
+#include <unity.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+#include "CommandMailbox.h"
+#include "FakeHal.h"
+#include "TrackerCore.h"
+
+using Clock = std::chrono::steady_clock;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+struct Rig {
+  Config cfg = defaultConfig();
+  FakeClock clk{1782026100};
+  FakeAdc adc{4095};
+  FakeServos servos;
+  NoaaSun sun;
+  TrackerCore core{cfg, clk, adc, servos, sun};
+};
+
+void test_latest_value_wins(void) {
+  CommandMailbox box;
+  int v = -1;
+  TEST_ASSERT_FALSE(box.take(CMD_HOR, v));
+  box.post(CMD_HOR, 10);
+  box.post(CMD_HOR, 20);
+  box.post(CMD_HOR, -30);
+  box.post(CMD_VER, 100000); // ограничивается int16
+  TEST_ASSERT_TRUE(box.take(CMD_HOR, v));
+  TEST_ASSERT_EQUAL_INT(-30, v);
+  TEST_ASSERT_FALSE(box.take(CMD_HOR, v));
+  TEST_ASSERT_TRUE(box.take(CMD_VER, v));
+  TEST_ASSERT_EQUAL_INT(INT16_MAX, v);
+  TEST_ASSERT_FALSE(box.take(CMD_MODE, v));
+  TEST_ASSERT_EQUAL_UINT32(4, box.posted.load());
+  TEST_ASSERT_EQUAL_UINT32(2, box.superseded.load());
+}
+
+// Ручные углы вне ручного режима отбрасываются; смена режима в той же
+// пачке применяется раньше углов. Углы — 1/ANGLE_SCALE градуса
+void test_tracker_applies_mode_then_axes(void) {
+  Rig r;
+  r.core.mode = MODE_AUTO;
+  r.core.commands.post(CMD_HOR, degToAngle(30));
+  r.core.commands.post(CMD_VER, degToAngle(40));
+  TEST_ASSERT_FALSE(r.core.applyCommands());
+  TEST_ASSERT_EQUAL_INT(degToAngle(90), r.core.currentHor);
+
+  r.core.commands.post(CMD_MODE, MODE_MANUAL);
+  for (int i = 0; i <= 50; ++i) {
+    r.core.commands.post(CMD_HOR, degToAngle(100) + i * 5);
+    r.core.commands.post(CMD_VER, degToAngle(20 + i));
+  }
+  TEST_ASSERT_TRUE(r.core.applyCommands());
+  TEST_ASSERT_EQUAL_INT(MODE_MANUAL, r.core.mode);
+  TEST_ASSERT_EQUAL_INT(10250, r.core.currentHor); // 102.5°
+  TEST_ASSERT_EQUAL_INT(degToAngle(clampInt(70, r.cfg.verMin, r.cfg.verMax)),
+                        r.core.currentVer);
+  TEST_ASSERT_FALSE(r.core.applyCommands());
+  TEST_ASSERT_EQUAL_UINT32(1, r.core.commandsApplied.load());
+
+  // Демо запускается командой режима, как раньше из обработчика
+  r.core.commands.post(CMD_MODE, MODE_DEMO);
+  r.core.cycle();
+  TEST_ASSERT_EQUAL_INT(MODE_DEMO, r.core.mode);
+}
+
+// Поток "веба" шлёт поток команд ползунка, поток трекера просыпается и
+// забирает их под мьютексом (как dataMutex), поток движения шагает
+// планировщик. Сравнение с прежней схемой: обработчик сам берёт мьютекс
+// и вызывает setServos()
+struct FloodResult {
+  double meanNs = 0, p99Ns = 0, maxNs = 0;
+  long applied = 0; // вызовов setServos()
+  long writes = 0;  // записей в серво
+  int lastHor = 0, lastVer = 0; // последняя отправленная команда
+  int finalHor = 0, finalVer = 0;
+};
+
+static FloodResult flood(bool mailbox, int commands) {
+  Rig r;
+  r.core.mode = MODE_MANUAL;
+  std::mutex dataMutex;
+  std::atomic<bool> done{false};
+  std::atomic<long> applied{0};
+
+  // Трекер: цикл каждые ~200 мкс (команды будят его сильно раньше
+  // штатных 2 с) и заметная работа под мьютексом
+  std::thread tracker([&] {
+    while (!done) {
+      {
+        std::lock_guard<std::mutex> g(dataMutex);
+        if (r.core.applyCommands())
+          applied++;
+        r.core.control();
+        r.core.publish();
+        std::this_thread::sleep_for(std::chrono::microseconds(20));
+      }
+      std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+  });
+  std::thread motion([&] {
+    while (!done) {
+      r.core.motion.step(MOTION_PERIOD_MS);
+      std::this_thread::sleep_for(std::chrono::microseconds(500));
+    }
+  });
+
+  std::vector<double> ns;
+  ns.reserve(commands);
+  int lastH = 0, lastV = 0;
+  for (int i = 0; i < commands; ++i) {
+    lastH = i * 37 % (degToAngle(180) + 1); // доли градуса
+    lastV = degToAngle(r.cfg.verMin) +
+            i * 13 % (degToAngle(r.cfg.verMax - r.cfg.verMin) + 1);
+    auto t0 = Clock::now();
+    if (mailbox) {
+      r.core.commands.post(CMD_HOR, lastH);
+      r.core.commands.post(CMD_VER, lastV);
+    } else {
+      std::lock_guard<std::mutex> g(dataMutex);
+      r.core.setServos(lastH, lastV);
+      r.core.publish();
+      applied++;
+    }
+    ns.push_back(
+        std::chrono::duration<double, std::nano>(Clock::now() - t0).count());
+    if (i % 16 == 0) // запросы ползунка идут не сплошь
+      std::this_thread::sleep_for(std::chrono::microseconds(10));
+  }
+  // Дождаться, пока трекер заберёт последнее
+  for (int i = 0; i < 1000 && r.core.currentHor != lastH; ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  done = true;
+  tracker.join();
+  motion.join();
+
+  FloodResult f;
+  std::sort(ns.begin(), ns.end());
+  for (double x : ns)
+    f.meanNs += x / ns.size();
+  f.p99Ns = ns[ns.size() * 99 / 100];
+  f.maxNs = ns.back();
+  f.applied = applied;
+  f.writes = r.core.motion.writes;
+  f.finalHor = r.core.currentHor;
+  f.finalVer = r.core.currentVer;
+  f.lastHor = lastH;
+  f.lastVer = lastV;
+  return f;
+}
+
+void test_flood_manual_commands(void) {
+  const int N = 20000;
+  FloodResult direct = flood(false, N);
+  FloodResult box = flood(true, N);
+  printf("[commands] %d setManual: mutex+setServos mean %.0f ns, p99 %.0f "
+         "ns, max %.0f ns, %ld setServos, %ld servo writes\n",
+         N, direct.meanNs, direct.p99Ns, direct.maxNs, direct.applied,
+         direct.writes);
+  printf("[commands] %d setManual: mailbox        mean %.0f ns, p99 %.0f "
+         "ns, max %.0f ns, %ld setServos, %ld servo writes\n",
+         N, box.meanNs, box.p99Ns, box.maxNs, box.applied, box.writes);
+
+  TEST_ASSERT_EQUAL(N, direct.applied);
+  // Промежуточные положения схлопнулись, последнее применено
+  TEST_ASSERT_EQUAL_INT(box.lastHor, box.finalHor);
+  TEST_ASSERT_EQUAL_INT(box.lastVer, box.finalVer);
+  TEST_ASSERT_TRUE(box.applied > 0 && box.applied < N / 4);
+  TEST_ASSERT_TRUE(box.p99Ns < direct.p99Ns);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_latest_value_wins);
+  RUN_TEST(test_tracker_applies_mode_then_axes);
+  RUN_TEST(test_flood_manual_commands);
+  return UNITY_END();
+}
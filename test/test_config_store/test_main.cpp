@@ -0,0 +1,143 @@
+// Хранилище настроек в NVS: pio test -e native
+#include <unity.h>
+
+#include <string.h>
+
+#include "ConfigStore.h"
+#include "FakeHal.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static Config sample() {
+  Config c = defaultConfig();
+  strcpy(c.ssid, "dacha");
+  strcpy(c.pass, "secret12");
+  c.hOff = -4;
+  c.vOff = 3;
+  return c;
+}
+
+void test_roundtrip(void) {
+  FakeKeyValue kv;
+  ConfigStore store(kv);
+  Config c;
+  TEST_ASSERT_FALSE(store.load(c)); // пусто — значения по умолчанию
+  TEST_ASSERT_EQUAL(0, ConfigStore::diff(c, defaultConfig()));
+
+  Config a = sample();
+  TEST_ASSERT_EQUAL(CFG_ALL & ~(cfgBit(CFG_GMT) | cfgBit(CFG_LAT) |
+                                cfgBit(CFG_LON) | cfgBit(CFG_VER_MIN) |
+                                cfgBit(CFG_VER_MAX)),
+                    store.save(a));
+
+  ConfigStore again(kv);
+  Config b;
+  TEST_ASSERT_TRUE(again.load(b));
+  TEST_ASSERT_EQUAL(0, ConfigStore::diff(a, b));
+  TEST_ASSERT_EQUAL_STRING("dacha", b.ssid);
+  TEST_ASSERT_EQUAL(-4, b.hOff);
+}
+
+void test_saves_only_changed_fields(void) {
+  FakeKeyValue kv;
+  ConfigStore store(kv);
+  Config c = sample();
+  store.migrate(c, c);
+  long before = kv.puts;
+  TEST_ASSERT_EQUAL(CFG_FIELDS, before);
+
+  TEST_ASSERT_EQUAL(0, store.save(c)); // повторное сохранение — без записи
+  c.hOff = 7;
+  c.verMax = 80;
+  TEST_ASSERT_EQUAL(cfgBit(CFG_H_OFF) | cfgBit(CFG_VER_MAX), store.save(c));
+  TEST_ASSERT_EQUAL(before + 2, kv.puts);
+  // Мусор после нуля в строке — не изменение
+  c.pass[20] = 'x';
+  TEST_ASSERT_EQUAL(0, store.save(c) & CFG_CREDENTIALS);
+}
+
+void test_corrupted_record_falls_back_to_default(void) {
+  FakeKeyValue kv;
+  ConfigStore store(kv);
+  Config c = sample();
+  c.lat = 43.25f;
+  store.migrate(c, c);
+
+  kv.values["lat"][3] ^= 0x40;              // бит во флоате
+  kv.values["hOff"].push_back(0);           // лишний байт
+  kv.values["ssid"][0] = CONFIG_SCHEMA + 1; // запись будущей версии
+
+  ConfigStore again(kv);
+  Config b;
+  TEST_ASSERT_TRUE(again.load(b));
+  TEST_ASSERT_EQUAL(3, again.corrupted);
+  TEST_ASSERT_EQUAL_FLOAT(defaultConfig().lat, b.lat);
+  TEST_ASSERT_EQUAL(0, b.hOff);
+  TEST_ASSERT_EQUAL_STRING("", b.ssid);
+  TEST_ASSERT_EQUAL_STRING("secret12", b.pass);
+  TEST_ASSERT_EQUAL(3, b.vOff);
+
+  // Следующее сохранение перезаписывает только испорченные записи
+  long puts = kv.puts;
+  TEST_ASSERT_EQUAL(cfgBit(CFG_LAT) | cfgBit(CFG_H_OFF) | cfgBit(CFG_SSID),
+                    again.save(b));
+  TEST_ASSERT_EQUAL(3, again.writes);
+  TEST_ASSERT_EQUAL(puts + 3, kv.puts);
+  TEST_ASSERT_EQUAL(0, again.save(b));
+  ConfigStore third(kv);
+  third.load(b);
+  TEST_ASSERT_EQUAL(0, third.corrupted);
+}
+
+// Одна испорченная запись — одна перезапись, а не все девять полей
+void test_one_corrupt_record_one_write(void) {
+  FakeKeyValue kv;
+  ConfigStore store(kv);
+  Config c = sample();
+  store.migrate(c, c);
+  kv.values["verMax"][2] ^= 0x01;
+
+  ConfigStore again(kv);
+  Config b;
+  again.load(b);
+  TEST_ASSERT_EQUAL(1, again.corrupted);
+  TEST_ASSERT_EQUAL(0, again.writes);
+  TEST_ASSERT_EQUAL(cfgBit(CFG_VER_MAX), again.save(b));
+  TEST_ASSERT_EQUAL(1, again.writes);
+}
+
+void test_migrates_legacy_eeprom_image(void) {
+  FakeKeyValue kv;
+  ConfigStore store(kv);
+  Config legacy = sample();
+  memset(legacy.ssid, 'A', sizeof(legacy.ssid)); // без нуля в конце
+  Config c;
+  TEST_ASSERT_FALSE(store.load(c));
+  store.migrate(c, legacy);
+  TEST_ASSERT_EQUAL(31, strlen(c.ssid));
+  TEST_ASSERT_EQUAL(-4, c.hOff);
+
+  ConfigStore again(kv);
+  Config b;
+  TEST_ASSERT_TRUE(again.load(b));
+  TEST_ASSERT_EQUAL(0, ConfigStore::diff(c, b));
+
+  // Чистая EEPROM (magic не совпал) — значения по умолчанию
+  FakeKeyValue kv2;
+  ConfigStore fresh(kv2);
+  Config blank;
+  memset(&blank, 0xFF, sizeof(blank));
+  fresh.migrate(c, blank);
+  TEST_ASSERT_EQUAL(0, ConfigStore::diff(c, defaultConfig()));
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_roundtrip);
+  RUN_TEST(test_saves_only_changed_fields);
+  RUN_TEST(test_corrupted_record_falls_back_to_default);
+  RUN_TEST(test_one_corrupt_record_one_write);
+  RUN_TEST(test_migrates_legacy_eeprom_image);
+  return UNITY_END();
+}
@@ -0,0 +1,159 @@
+// Агрегаты выработки по минутам/часам/суткам: pio test -e native
+#include <unity.h>
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "EnergyStats.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static const uint32_t T0 = 1718236800; // 2024-06-13 00:00 UTC
+
+void test_constant_power_energy(void) {
+  EnergyStats e; // 10 Ом: 10 В -> 10 Вт
+  for (uint32_t s = 0; s <= 3600; ++s)
+    e.add(T0 + s, 10.0f, true, 180.0f, 90.0f);
+
+  // Час ровно: 10 Вт * 1 ч (последний отсчёт открыл следующий час)
+  const EnergyBucket &h = e.bucket(ENERGY_HOUR, 1);
+  TEST_ASSERT_EQUAL(T0, h.start);
+  TEST_ASSERT_EQUAL(3600, h.samples);
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 10.0f - 10.0f / 3600, h.wh);
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 10.0f, e.bucket(ENERGY_DAY).wh);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 10.0f, h.vMean());
+  TEST_ASSERT_EQUAL(3600, e.bucket(ENERGY_DAY).trackedSec);
+  TEST_ASSERT_EQUAL(0, e.bucket(ENERGY_DAY).idleSec);
+}
+
+void test_levels_agree_on_rollover(void) {
+  EnergyStats e;
+  float vMin = 100, vMax = 0;
+  for (uint32_t s = 0; s < 2 * 3600; s += 5) {
+    float v = 6.0f + 4.0f * sinf(s / 500.0f);
+    vMin = fminf(vMin, v);
+    vMax = fmaxf(vMax, v);
+    e.add(T0 + s, v, s % 1800 < 1200, 120.0f, 40.0f);
+  }
+
+  // Сумма закрытых минут первого часа = часовая корзина
+  TEST_ASSERT_EQUAL(ENERGY_MINUTES, e.count(ENERGY_MINUTE));
+  TEST_ASSERT_EQUAL(2, e.count(ENERGY_HOUR));
+  float minuteWh = 0;
+  uint32_t minuteSamples = 0;
+  for (int ago = 0; ago < ENERGY_MINUTES; ++ago) {
+    minuteWh += e.bucket(ENERGY_MINUTE, ago).wh;
+    minuteSamples += e.bucket(ENERGY_MINUTE, ago).samples;
+    TEST_ASSERT_EQUAL(T0 + 7200 - 60 * (ago + 1),
+                      e.bucket(ENERGY_MINUTE, ago).start);
+  }
+  const EnergyBucket &h1 = e.bucket(ENERGY_HOUR, 0);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3f, h1.wh, minuteWh);
+  TEST_ASSERT_EQUAL(h1.samples, minuteSamples);
+
+  // Сутки = оба часа
+  const EnergyBucket &h0 = e.bucket(ENERGY_HOUR, 1);
+  const EnergyBucket &d = e.bucket(ENERGY_DAY);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3f, h0.wh + h1.wh, d.wh);
+  TEST_ASSERT_FLOAT_WITHIN(1e-3f, h0.fixedWh + h1.fixedWh, d.fixedWh);
+  TEST_ASSERT_EQUAL(h0.trackedSec + h1.trackedSec, d.trackedSec);
+  TEST_ASSERT_EQUAL(7200 - 5, d.trackedSec + d.idleSec);
+  TEST_ASSERT_EQUAL_FLOAT(vMin, d.vMin);
+  TEST_ASSERT_EQUAL_FLOAT(vMax, d.vMax);
+}
+
+void test_day_starts_at_local_midnight(void) {
+  EnergyModel m = DEFAULT_ENERGY_MODEL;
+  m.tzOffsetSec = 5 * 3600; // UTC+5
+  EnergyStats e(m);
+  // 18:00..20:00 UTC = 23:00..01:00 местного
+  for (uint32_t s = 18 * 3600; s <= 20 * 3600; s += 10)
+    e.add(T0 + s, 5.0f, false, 0.0f, -10.0f);
+
+  TEST_ASSERT_EQUAL(2, e.count(ENERGY_DAY));
+  TEST_ASSERT_EQUAL(T0 + 19 * 3600, e.bucket(ENERGY_DAY).start);
+  TEST_ASSERT_EQUAL(T0 - 5 * 3600, e.bucket(ENERGY_DAY, 1).start);
+  TEST_ASSERT_EQUAL(3610, e.bucket(ENERGY_DAY).idleSec); // 361 отсчёт
+}
+
+void test_gaps_are_not_integrated(void) {
+  EnergyStats e;
+  e.add(T0, 10.0f, true, 180.0f, 90.0f);
+  e.add(T0 + 30, 10.0f, true, 180.0f, 90.0f);    // 30 с
+  e.add(T0 + 3000, 10.0f, true, 180.0f, 90.0f);  // разрыв: не считаем
+  e.add(T0 + 3010, 10.0f, true, 180.0f, 90.0f);  // 10 с
+  e.add(T0 + 2990, 10.0f, true, 180.0f, 90.0f);  // время назад
+  const EnergyBucket &d = e.bucket(ENERGY_DAY);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 10.0f * 40 / 3600, d.wh);
+  TEST_ASSERT_EQUAL(40, d.trackedSec);
+  TEST_ASSERT_EQUAL(5, d.samples);
+}
+
+void test_tracking_gain_over_fixed_tilt(void) {
+  EnergyModel m = DEFAULT_ENERGY_MODEL;
+  m.fixedTiltDeg = 30;
+  m.fixedAzDeg = 180;
+  EnergyStats e(m);
+  // Солнце точно по нормали неподвижной панели — выигрыша нет
+  TEST_ASSERT_FLOAT_WITHIN(1e-5f, 1.0f, e.fixedFactor(180.0f, 60.0f));
+  TEST_ASSERT_EQUAL_FLOAT(0.0f, e.fixedFactor(180.0f, -1.0f));
+
+  // День: азимут 90..270, высота по синусу
+  for (uint32_t s = 0; s <= 12 * 3600; s += 10) {
+    float k = s / (12.0f * 3600);
+    e.add(T0 + 6 * 3600 + s, 12.0f, true, 90.0f + 180.0f * k,
+          55.0f * sinf(k * M_PI));
+  }
+  const EnergyBucket &d = e.bucket(ENERGY_DAY);
+  float gain = d.wh / d.fixedWh;
+  char msg[96];
+  snprintf(msg, sizeof(msg), "tracked %.1f Wh, fixed %.1f Wh, gain %.2f",
+           d.wh, d.fixedWh, gain);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_TRUE(gain > 1.2f && gain < 3.0f);
+
+  // Ручной режим: сравнивать не с чем
+  EnergyStats manual(m);
+  manual.add(T0, 12.0f, false, 90.0f, 5.0f);
+  manual.add(T0 + 10, 12.0f, false, 90.0f, 5.0f);
+  TEST_ASSERT_EQUAL_FLOAT(manual.bucket(ENERGY_DAY).wh,
+                          manual.bucket(ENERGY_DAY).fixedWh);
+}
+
+void test_json_and_add_cost(void) {
+  EnergyStats e;
+  const uint32_t N = 40 * 86400; // больше, чем кольцо суток
+  auto t0 = std::chrono::steady_clock::now();
+  for (uint32_t s = 0; s < N; s += 1)
+    e.add(T0 + s, (s % 86400) / 8640.0f, true, 180.0f, 45.0f);
+  double ns = std::chrono::duration<double, std::nano>(
+                  std::chrono::steady_clock::now() - t0)
+                  .count() /
+              N;
+  char msg[64];
+  snprintf(msg, sizeof(msg), "add(): %.1f ns/sample", ns);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_EQUAL(ENERGY_DAYS, e.count(ENERGY_DAY));
+
+  char buf[2048];
+  JsonWriter w(buf, sizeof(buf));
+  e.write(w, ENERGY_DAY, 2);
+  TEST_ASSERT_FALSE(w.overflow());
+  TEST_ASSERT_NOT_NULL(strstr(w.c_str(), "\"period\":\"day\""));
+  TEST_ASSERT_NOT_NULL(strstr(w.c_str(), "\"data\":[[1721520000,86400,"));
+  TEST_ASSERT_NOT_NULL(strstr(w.c_str(), "\"today\":{\"wh\":"));
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_constant_power_energy);
+  RUN_TEST(test_levels_agree_on_rollover);
+  RUN_TEST(test_day_starts_at_local_midnight);
+  RUN_TEST(test_gaps_are_not_integrated);
+  RUN_TEST(test_tracking_gain_over_fixed_tilt);
+  RUN_TEST(test_json_and_add_cost);
+  return UNITY_END();
+}
@@ -0,0 +1,125 @@
+// Точность и стоимость суточного кэша эфемерид: pio test -e native
+#include <unity.h>
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+
+#include "FakeHal.h"
+#include "SolarEphemeris.h"
+#include "TrackerCore.h"
+
+static const time_t YEAR_START = 1767225600; // 2026-01-01 00:00 UTC
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// Худшая ошибка кэша относительно источника за год (днём, шаг step секунд)
+static float yearMaxError(const Config &cfg, int step, long &builds) {
+  NoaaSun ref;
+  SolarEphemeris eph(ref);
+  float worst = 0;
+  for (time_t t = YEAR_START; t < YEAR_START + 365 * 86400L; t += step) {
+    float az, alt, refAz, refAlt;
+    eph.position(cfg, t, az, alt);
+    ref.position(cfg, t, refAz, refAlt);
+    if (refAlt <= 0)
+      continue;
+    float e = pointingError(az, alt, refAz, refAlt);
+    if (e > worst)
+      worst = e;
+  }
+  builds = eph.builds;
+  return worst;
+}
+
+void test_solar_day_start(void) {
+  // Астана: солнечная полночь около 19:14 UTC
+  time_t d = solarDayStart(71.4333, YEAR_START + 3600);
+  TEST_ASSERT_EQUAL(0, (d + 17144) % 86400);
+  TEST_ASSERT_LESS_OR_EQUAL(YEAR_START + 3600, d);
+  TEST_ASSERT_GREATER_THAN(YEAR_START + 3600 - 86400, d);
+}
+
+void test_year_accuracy_home(void) {
+  Config cfg = defaultConfig();
+  long builds = 0;
+  float worst = yearMaxError(cfg, 419, builds);
+  char msg[96];
+  snprintf(msg, sizeof(msg), "lat %.2f: max error %.4f deg, %ld builds/year",
+           cfg.lat, worst, builds);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_LESS_OR_EQUAL(EPH_MAX_ERR_DEG, worst);
+  TEST_ASSERT_LESS_OR_EQUAL(366, builds);
+}
+
+void test_year_accuracy_tropics(void) {
+  // Солнце проходит через зенит — часть отрезков уходит в прямой расчёт
+  Config cfg = defaultConfig();
+  cfg.lat = 10.0;
+  cfg.lon = -75.0;
+  long builds = 0;
+  float worst = yearMaxError(cfg, 601, builds);
+  char msg[96];
+  snprintf(msg, sizeof(msg), "lat %.2f: max error %.4f deg", cfg.lat, worst);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_LESS_OR_EQUAL(EPH_MAX_ERR_DEG * 2, worst);
+}
+
+void test_rebuild_on_config_change(void) {
+  Config cfg = defaultConfig();
+  NoaaSun ref;
+  SolarEphemeris eph(ref);
+  float az, alt;
+  eph.position(cfg, YEAR_START, az, alt);
+  eph.position(cfg, YEAR_START + 600, az, alt);
+  TEST_ASSERT_EQUAL(1, eph.builds);
+  cfg.lon = 72.0;
+  eph.position(cfg, YEAR_START + 1200, az, alt);
+  TEST_ASSERT_EQUAL(2, eph.builds);
+  eph.invalidate();
+  eph.position(cfg, YEAR_START + 1800, az, alt);
+  TEST_ASSERT_EQUAL(3, eph.builds);
+}
+
+// Стоимость цикла трекера: SunPosition каждый цикл против кэша
+static double cycleNs(HalSun &sun, int n) {
+  Config cfg = defaultConfig();
+  FakeClock clk(YEAR_START + 172 * 86400L);
+  FakeAdc adc;
+  FakeServos servos;
+  TrackerCore core(cfg, clk, adc, servos, sun);
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < n; i++) {
+    core.cycle();
+    clk.advance(2);
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+}
+
+void test_bench_cached_vs_direct(void) {
+  const int N = 43200; // сутки циклов по 2 с
+  NoaaSun direct;
+  NoaaSun ref;
+  SolarEphemeris cached(ref);
+  double directNs = cycleNs(direct, N);
+  double cachedNs = cycleNs(cached, N);
+  char msg[128];
+  snprintf(msg, sizeof(msg),
+           "cycle: direct %.1f ns, cached %.1f ns (x%.2f), source calls "
+           "%ld vs %ld per day",
+           directNs, cachedNs, directNs / cachedNs, direct.calls, ref.calls);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_LESS_THAN(direct.calls / 10, ref.calls);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_solar_day_start);
+  RUN_TEST(test_year_accuracy_home);
+  RUN_TEST(test_year_accuracy_tropics);
+  RUN_TEST(test_rebuild_on_config_change);
+  RUN_TEST(test_bench_cached_vs_direct);
+  return UNITY_END();
+}
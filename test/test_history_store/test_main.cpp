@@ -0,0 +1,246 @@
+// История телеметрии: кольцо в RAM + блоки на flash: pio test -e native
+#include <unity.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+
+#include "FakeHal.h"
+#include "HistoryStore.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static const uint32_t T0 = 1718236800; // 2024-06-13 00:00 UTC
+
+// Точка "как днём": плавное напряжение, азимут и высота, углы серво
+static HistorySample sample(uint32_t i) {
+  uint32_t t = T0 + i * HISTORY_PERIOD_S;
+  float day = (t % 86400) / 86400.0f;
+  TrackerSnapshot s = {};
+  s.panelVolts = fmaxf(0.0f, 8.0f * sinf(day * 2 * M_PI - 1.2f)) +
+                 0.01f * (i % 5);
+  s.sunAz = fmodf(day * 360.0f + 90.0f, 360.0f);
+  s.sunAlt = 60.0f * sinf(day * 2 * M_PI - 1.2f);
+  return makeHistorySample(t, s, (int)(s.sunAz / 2) % 181,
+                           s.sunAlt > 15 ? (int)s.sunAlt : 15);
+}
+
+static void collect(const HistorySample &s, void *ctx) {
+  ((std::vector<HistorySample> *)ctx)->push_back(s);
+}
+
+static std::vector<HistorySample> queryAll(HistoryStore &h, uint32_t from,
+                                           uint32_t to, uint32_t step) {
+  std::vector<HistorySample> out;
+  h.query(from, to, step, collect, &out);
+  return out;
+}
+
+static bool sameSample(const HistorySample &a, const HistorySample &b) {
+  return a.t == b.t && a.voltsCenti == b.voltsCenti &&
+         a.sunAzDeci == b.sunAzDeci && a.sunAltDeci == b.sunAltDeci &&
+         a.hor == b.hor && a.ver == b.ver;
+}
+
+void test_roundtrip_through_flash_blocks(void) {
+  FakeStorage fs;
+  HistoryStore h(&fs);
+  h.begin();
+  const uint32_t N = 1000; // 15 блоков + хвост в RAM
+  for (uint32_t i = 0; i < N; ++i)
+    h.record(sample(i));
+
+  std::vector<HistorySample> got = queryAll(h, T0, T0 + N * 10, 1);
+  TEST_ASSERT_EQUAL(N, got.size());
+  for (uint32_t i = 0; i < N; ++i)
+    TEST_ASSERT_TRUE(sameSample(sample(i), got[i]));
+  TEST_ASSERT_EQUAL(N / HISTORY_BATCH, h.blocks);
+  TEST_ASSERT_EQUAL(T0, h.oldest());
+  TEST_ASSERT_EQUAL(sample(N - 1).t, h.newest());
+
+  // Поддиапазон посреди блока
+  got = queryAll(h, sample(100).t, sample(199).t, 1);
+  TEST_ASSERT_EQUAL(100, got.size());
+  TEST_ASSERT_TRUE(sameSample(sample(100), got[0]));
+}
+
+void test_downsampling_matches_brute_force(void) {
+  FakeStorage fs;
+  HistoryStore h(&fs);
+  h.begin();
+  const uint32_t N = 3 * 8640; // трое суток
+  for (uint32_t i = 0; i < N; ++i)
+    h.record(sample(i));
+
+  const uint32_t from = T0 + 5000, to = T0 + 2 * 86400 + 777, step = 3600;
+  std::vector<HistorySample> got = queryAll(h, from, to, step);
+  TEST_ASSERT_EQUAL((to - from) / step + 1, got.size());
+  for (const HistorySample &p : got) {
+    double sum = 0;
+    int n = 0;
+    for (uint32_t i = 0; i < N; ++i) {
+      HistorySample s = sample(i);
+      if (s.t >= p.t && s.t < p.t + step && s.t <= to) {
+        sum += s.voltsCenti;
+        ++n;
+      }
+    }
+    TEST_ASSERT_TRUE(n > 0);
+    TEST_ASSERT_INT_WITHIN(1, lround(sum / n), p.voltsCenti);
+  }
+}
+
+void test_batched_flash_writes_and_size(void) {
+  FakeStorage fs;
+  HistoryStore h(&fs);
+  h.begin();
+  const uint32_t N = 8640; // сутки при записи раз в 10 с
+  for (uint32_t i = 0; i < N; ++i)
+    h.record(sample(i));
+
+  // Одна запись во flash на пачку, а не на точку
+  TEST_ASSERT_EQUAL(N / HISTORY_BATCH, fs.appends);
+  double perSample =
+      (double)fs.bytesWritten / (N / HISTORY_BATCH * HISTORY_BATCH);
+  char msg[128];
+  snprintf(msg, sizeof(msg),
+           "per day: %ld flash writes, %.1f KB (%.2f B/sample vs %d raw)",
+           fs.appends, fs.bytesWritten / 1024.0, perSample,
+           (int)sizeof(HistorySample));
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_TRUE(perSample < 6.0);
+}
+
+void test_segments_rotate_keeping_latest(void) {
+  FakeStorage fs;
+  HistoryStore h(&fs);
+  h.begin();
+  const uint32_t N = 12 * 8640; // больше, чем вмещают сегменты
+  for (uint32_t i = 0; i < N; ++i)
+    h.record(sample(i));
+
+  TEST_ASSERT_TRUE(fs.files.size() <= (size_t)HISTORY_SEGMENTS);
+  for (auto &f : fs.files)
+    TEST_ASSERT_TRUE(f.second.size() <= HISTORY_SEGMENT_BYTES);
+  TEST_ASSERT_TRUE(h.oldest() > T0);
+  TEST_ASSERT_EQUAL(sample(N - 1).t, h.newest());
+
+  // Всё от oldest() до конца на месте и без пропусков
+  std::vector<HistorySample> got = queryAll(h, h.oldest(), h.newest(), 1);
+  uint32_t first = (h.oldest() - T0) / HISTORY_PERIOD_S;
+  TEST_ASSERT_EQUAL(N - first, got.size());
+  TEST_ASSERT_TRUE(sameSample(sample(N - 1), got.back()));
+}
+
+void test_reboot_recovers_and_skips_torn_block(void) {
+  FakeStorage fs;
+  {
+    HistoryStore h(&fs);
+    h.begin();
+    for (uint32_t i = 0; i < 500; ++i)
+      h.record(sample(i));
+    h.flush(); // перед перезагрузкой
+  }
+  HistoryStore h2(&fs);
+  h2.begin();
+  TEST_ASSERT_EQUAL(T0, h2.oldest());
+  TEST_ASSERT_EQUAL(sample(499).t, h2.newest());
+
+  // Питание пропало посреди записи блока
+  fs.files["/hist0.bin"].push_back(0xB5);
+  fs.files["/hist0.bin"].push_back(40);
+  HistoryStore h3(&fs);
+  h3.begin();
+  for (uint32_t i = 500; i < 700; ++i)
+    h3.record(sample(i));
+  h3.flush();
+
+  std::vector<HistorySample> got = queryAll(h3, T0, T0 + 700 * 10, 1);
+  TEST_ASSERT_EQUAL(700, got.size());
+  for (uint32_t i = 0; i < 700; ++i)
+    TEST_ASSERT_TRUE(sameSample(sample(i), got[i]));
+  TEST_ASSERT_EQUAL(1, fs.size("/hist1.bin") > 0); // продолжили в новом
+}
+
+void test_ram_only_and_flash_failure(void) {
+  HistoryStore ramOnly;
+  for (uint32_t i = 0; i < 1000; ++i)
+    ramOnly.record(sample(i));
+  std::vector<HistorySample> got = queryAll(ramOnly, T0, T0 + 100000, 1);
+  TEST_ASSERT_EQUAL(HISTORY_RAM, got.size());
+  TEST_ASSERT_TRUE(sameSample(sample(1000 - HISTORY_RAM), got[0]));
+  TEST_ASSERT_EQUAL(0, ramOnly.dropped);
+
+  FakeStorage fs;
+  fs.failWrites = true;
+  HistoryStore h(&fs);
+  h.begin();
+  for (uint32_t i = 0; i < 300; ++i)
+    h.record(sample(i));
+  TEST_ASSERT_EQUAL(300 - HISTORY_RAM, h.dropped);
+  fs.failWrites = false;
+  h.flush(); // flash вернулась — кольцо сбрасывается целиком
+  got = queryAll(h, T0, T0 + 100000, 1);
+  TEST_ASSERT_EQUAL(HISTORY_RAM, got.size());
+  TEST_ASSERT_TRUE(sameSample(sample(299), got.back()));
+}
+
+// Часы шагнули на час назад: точки до уже записанных отбрасываются,
+// история остаётся по возрастанию и переживает перезагрузку
+void test_clock_step_back_drops_stale(void) {
+  FakeStorage fs;
+  HistoryStore h(&fs);
+  h.begin();
+  for (uint32_t i = 0; i < 360; ++i)
+    h.record(sample(i));
+  for (uint32_t i = 0; i < 400; ++i) // час заново, потом 40 новых точек
+    h.record(sample(i));
+  h.record(sample(399)); // то же время
+  TEST_ASSERT_EQUAL(361, h.stale);
+  TEST_ASSERT_EQUAL(400, h.recorded);
+  TEST_ASSERT_EQUAL(sample(399).t, h.newest());
+  h.flush();
+
+  HistoryStore again(&fs);
+  again.begin();
+  std::vector<HistorySample> got = queryAll(again, T0, T0 + 100000, 1);
+  TEST_ASSERT_EQUAL(400, got.size());
+  for (size_t i = 1; i < got.size(); ++i)
+    TEST_ASSERT_TRUE(got[i - 1].t < got[i].t);
+  TEST_ASSERT_TRUE(sameSample(sample(0), got[0]));
+  TEST_ASSERT_TRUE(sameSample(sample(399), got.back()));
+}
+
+// Интервал через север: 359° и 1° в среднем — 0°, а не 180°
+void test_azimuth_mean_wraps_through_north(void) {
+  HistoryStore h;
+  const uint16_t az[] = {3590, 10, 3590, 10, 3580, 0};
+  for (int i = 0; i < 6; ++i) {
+    HistorySample s = {};
+    s.t = T0 + i * HISTORY_PERIOD_S;
+    s.sunAzDeci = az[i];
+    h.record(s);
+  }
+  std::vector<HistorySample> got = queryAll(h, T0, T0 + 100, 20);
+  TEST_ASSERT_EQUAL(3, got.size());
+  TEST_ASSERT_EQUAL(0, got[0].sunAzDeci); // 359.0° и 1.0°
+  TEST_ASSERT_EQUAL(0, got[1].sunAzDeci);
+  TEST_ASSERT_EQUAL(3590, got[2].sunAzDeci); // 358.0° и 0.0°
+  got = queryAll(h, T0, T0 + 100, 60);
+  TEST_ASSERT_EQUAL(1, got.size());
+  TEST_ASSERT_EQUAL(3597, got[0].sunAzDeci); // -0.33°
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_roundtrip_through_flash_blocks);
+  RUN_TEST(test_downsampling_matches_brute_force);
+  RUN_TEST(test_batched_flash_writes_and_size);
+  RUN_TEST(test_segments_rotate_keeping_latest);
+  RUN_TEST(test_reboot_recovers_and_skips_torn_block);
+  RUN_TEST(test_ram_only_and_flash_failure);
+  RUN_TEST(test_clock_step_back_drops_stale);
+  RUN_TEST(test_azimuth_mean_wraps_through_north);
+  return UNITY_END();
+}
@@ -0,0 +1,563 @@
+// Событийный HTTP-сервер на сокетах ПК + нагрузочный тест: pio test -e native
+#include <unity.h>
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "HttpServer.h"
+
+using Clock = std::chrono::steady_clock;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static double msSince(Clock::time_point t0) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+// ---------- Маршруты ----------
+static void handleEcho(HttpRequest &req, HttpResponse &res) {
+  char body[128];
+  snprintf(body, sizeof(body), "%s|%s|%s", req.arg("a"), req.arg("b"),
+           req.header("X-Test"));
+  res.respond(200, "text/plain", body);
+}
+
+static void handleBig(HttpRequest &, HttpResponse &res) {
+  res.start(200, "text/plain");
+  char line[100];
+  memset(line, 'x', sizeof(line));
+  for (int i = 0; i < 50; ++i) // 5000 байт — больше буфера передачи
+    res.append(line, sizeof(line));
+}
+
+// 64 МБ генератором: курсор — сколько осталось
+static bool fillFlood(HttpResponse &res, void *state) {
+  uint32_t &left = *(uint32_t *)state;
+  char line[1000];
+  memset(line, 'y', sizeof(line));
+  while (left && res.append(line, sizeof(line)))
+    left -= sizeof(line);
+  return left > 0;
+}
+
+static void handleFlood(HttpRequest &, HttpResponse &res) {
+  uint32_t left = 64000u * 1000u;
+  res.produce(200, "text/plain", fillFlood, &left, sizeof(left));
+}
+
+// Те же 64 МБ через append() — как /api/metrics, если клиент не читает
+static void handleFloodAppend(HttpRequest &, HttpResponse &res) {
+  res.start(200, "text/plain");
+  char line[1000];
+  memset(line, 'z', sizeof(line));
+  for (int i = 0; i < 64000 && res.append(line, sizeof(line)); ++i) {
+  }
+}
+
+static void handleEvents(HttpRequest &, HttpResponse &res) {
+  res.start(200, "text/event-stream");
+  res.keepOpen();
+}
+
+static const uint8_t STATIC_BODY[] = "static page";
+
+static void handleStatic(HttpRequest &, HttpResponse &res) {
+  res.respondStatic(200, "text/html", STATIC_BODY, sizeof(STATIC_BODY) - 1);
+}
+
+// Потоковое тело: считает байты и куски, ключ — в заголовке
+struct CountingUpload : HttpUploadHandler {
+  size_t bytes = 0, maxChunk = 0;
+  uint32_t sum = 0;
+  int chunks = 0;
+  std::atomic<int> aborts{0};
+
+  void begin(HttpRequest &req, size_t, HttpResponse &res) override {
+    bytes = maxChunk = sum = chunks = 0;
+    if (strcmp(req.header("X-Key"), "ok") != 0)
+      res.respond(401, "text/plain", "key");
+  }
+  bool data(const uint8_t *chunk, size_t len) override {
+    for (size_t i = 0; i < len; ++i)
+      sum = sum * 31 + chunk[i];
+    bytes += len;
+    maxChunk = std::max(maxChunk, len);
+    ++chunks;
+    return true;
+  }
+  void end(HttpResponse &res) override {
+    char body[64];
+    snprintf(body, sizeof(body), "%zu %u", bytes, (unsigned)sum);
+    res.respond(200, "text/plain", body);
+  }
+  void abort() override { ++aborts; }
+};
+static CountingUpload countingUpload;
+
+// Сервер в отдельном потоке — как TaskWeb
+struct ServerThread {
+  HttpServer srv;
+  std::thread th;
+  std::atomic<bool> stop{false};
+  std::atomic<int> broadcasts{0};
+
+  explicit ServerThread(const HttpServerConfig &cfg) : srv(cfg) {
+    srv.on(HTTP_METHOD_GET, "/echo", handleEcho);
+    srv.on(HTTP_METHOD_GET, "/big", handleBig);
+    srv.on(HTTP_METHOD_GET, "/events", handleEvents);
+    srv.on(HTTP_METHOD_GET, "/flood", handleFlood);
+    srv.on(HTTP_METHOD_GET, "/flood-append", handleFloodAppend);
+    srv.on(HTTP_METHOD_GET, "/static", handleStatic);
+    srv.onUpload("/upload", countingUpload);
+  }
+  bool start() {
+    if (!srv.begin())
+      return false;
+    th = std::thread([this] {
+      while (!stop) {
+        srv.loop(5);
+        if (broadcasts.exchange(0))
+          srv.broadcast("data: x\n\n", 9);
+      }
+    });
+    return true;
+  }
+  ~ServerThread() {
+    stop = true;
+    if (th.joinable())
+      th.join();
+  }
+};
+
+static HttpServerConfig testConfig() {
+  HttpServerConfig cfg = DEFAULT_HTTP_SERVER;
+  cfg.port = 0; // свободный порт
+  return cfg;
+}
+
+// ---------- Клиент ----------
+struct Client {
+  int fd = -1;
+  char buf[16384];
+  size_t len = 0;
+  char body[8192];
+  size_t bodyLen = 0;
+
+  bool open(uint16_t port) {
+    if (fd < 0)
+      fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in a{};
+    a.sin_family = AF_INET;
+    a.sin_port = htons(port);
+    a.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    timeval tv = {1, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    return connect(fd, (sockaddr *)&a, sizeof(a)) == 0;
+  }
+  ~Client() {
+    if (fd >= 0)
+      close(fd);
+  }
+  void put(const char *s) { ::send(fd, s, strlen(s), MSG_NOSIGNAL); }
+  // Маленький приёмный буфер — до connect(), чтобы окно было узким
+  void smallWindow() {
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    int rcv = 4096;
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcv, sizeof(rcv));
+  }
+  // Дочитать хотя бы до want байт; false — закрыто или таймаут
+  bool fill(size_t want) {
+    while (len < want) {
+      ssize_t n = recv(fd, buf + len, sizeof(buf) - len, 0);
+      if (n <= 0)
+        return false;
+      len += n;
+    }
+    return true;
+  }
+  bool closedByPeer() {
+    char c;
+    return recv(fd, &c, 1, 0) == 0;
+  }
+  // Один ответ: статус или -1; тело — в body
+  int response() {
+    char *end;
+    while (!(end = (char *)memmem(buf, len, "\r\n\r\n", 4)))
+      if (!fill(len + 1))
+        return -1;
+    size_t hdr = end + 4 - buf;
+    int status = atoi(buf + 9);
+    long clen = -1;
+    for (char *p = buf; p < end; ++p)
+      if (strncasecmp(p, "\ncontent-length:", 16) == 0)
+        clen = atol(p + 16);
+    if (clen < 0) { // тело до закрытия
+      while (fill(len + 1)) {
+      }
+      clen = len - hdr;
+    } else if (!fill(hdr + clen)) {
+      return -1;
+    }
+    bodyLen = std::min((size_t)clen, sizeof(body) - 1);
+    memcpy(body, buf + hdr, bodyLen);
+    body[bodyLen] = 0;
+    len -= hdr + clen;
+    memmove(buf, buf + hdr + clen, len);
+    return status;
+  }
+  int get(const char *path) {
+    char req[256];
+    snprintf(req, sizeof(req), "GET %s HTTP/1.1\r\nHost: t\r\n\r\n", path);
+    put(req);
+    return response();
+  }
+};
+
+struct LoadResult {
+  double rps;
+  double p99;
+};
+
+static LoadResult summarize(std::vector<double> &lat, double totalMs) {
+  std::sort(lat.begin(), lat.end());
+  return {lat.size() * 1000.0 / totalMs, lat[lat.size() * 99 / 100]};
+}
+
+// ---------- Тесты ----------
+void test_routes_args_and_headers(void) {
+  ServerThread s(testConfig());
+  TEST_ASSERT_TRUE(s.start());
+  Client c;
+  TEST_ASSERT_TRUE(c.open(s.srv.port()));
+
+  c.put("GET /echo?a=1&b=x%20y+z HTTP/1.1\r\nx-test: hi\r\n\r\n");
+  TEST_ASSERT_EQUAL(200, c.response());
+  TEST_ASSERT_EQUAL_STRING("1|x y z|hi", c.body);
+
+  TEST_ASSERT_EQUAL(404, c.get("/nope"));
+  c.put("POST /echo HTTP/1.1\r\nContent-Length: 3\r\n\r\nabc");
+  TEST_ASSERT_EQUAL(405, c.response());
+  TEST_ASSERT_EQUAL(200, c.get("/static"));
+  TEST_ASSERT_EQUAL_STRING("static page", c.body);
+}
+
+void test_keep_alive_and_pipelining(void) {
+  ServerThread s(testConfig());
+  TEST_ASSERT_TRUE(s.start());
+  Client c;
+  TEST_ASSERT_TRUE(c.open(s.srv.port()));
+
+  // Два запроса одним пакетом — два ответа по порядку
+  c.put("GET /echo?a=1 HTTP/1.1\r\n\r\nGET /echo?a=2 HTTP/1.1\r\n\r\n");
+  TEST_ASSERT_EQUAL(200, c.response());
+  TEST_ASSERT_EQUAL_STRING("1||", c.body);
+  TEST_ASSERT_EQUAL(200, c.response());
+  TEST_ASSERT_EQUAL_STRING("2||", c.body);
+  TEST_ASSERT_EQUAL(200, c.get("/echo?a=3"));
+
+  c.put("GET /echo HTTP/1.1\r\nConnection: close\r\n\r\n");
+  TEST_ASSERT_EQUAL(200, c.response());
+  TEST_ASSERT_TRUE(c.closedByPeer());
+}
+
+void test_slow_client_does_not_block_others(void) {
+  ServerThread s(testConfig());
+  TEST_ASSERT_TRUE(s.start());
+  Client slow, fast;
+  TEST_ASSERT_TRUE(slow.open(s.srv.port()));
+  slow.put("GET /ec"); // запрос не дописан
+  TEST_ASSERT_TRUE(fast.open(s.srv.port()));
+
+  Clock::time_point t0 = Clock::now();
+  TEST_ASSERT_EQUAL(200, fast.get("/echo?a=ok"));
+  TEST_ASSERT_LESS_THAN(50, (int)msSince(t0));
+
+  slow.put("ho?a=late HTTP/1.1\r\n\r\n");
+  TEST_ASSERT_EQUAL(200, slow.response());
+  TEST_ASSERT_EQUAL_STRING("late||", slow.body);
+}
+
+void test_timeouts_close_idle_and_partial(void) {
+  HttpServerConfig cfg = testConfig();
+  cfg.idleTimeoutMs = 100;
+  cfg.requestTimeoutMs = 100;
+  ServerThread s(cfg);
+  TEST_ASSERT_TRUE(s.start());
+  Client idle, partial;
+  TEST_ASSERT_TRUE(idle.open(s.srv.port()));
+  TEST_ASSERT_EQUAL(200, idle.get("/echo")); // дальше молчит
+  TEST_ASSERT_TRUE(partial.open(s.srv.port()));
+  partial.put("GET /echo HTTP/1.1\r\nHost");
+
+  TEST_ASSERT_TRUE(idle.closedByPeer());
+  TEST_ASSERT_TRUE(partial.closedByPeer());
+  s.stop = true;
+  s.th.join();
+  TEST_ASSERT_EQUAL(2, s.srv.timeouts);
+}
+
+void test_stream_broadcast_and_long_body(void) {
+  ServerThread s(testConfig());
+  TEST_ASSERT_TRUE(s.start());
+  Client ev, big;
+  TEST_ASSERT_TRUE(ev.open(s.srv.port()));
+  ev.put("GET /events HTTP/1.1\r\n\r\n");
+  TEST_ASSERT_TRUE(ev.fill(1));
+  while (!memmem(ev.buf, ev.len, "\r\n\r\n", 4))
+    TEST_ASSERT_TRUE(ev.fill(ev.len + 1));
+  TEST_ASSERT_NOT_NULL(strstr(ev.buf, "text/event-stream"));
+  ev.len = 0;
+
+  s.broadcasts = 1;
+  TEST_ASSERT_TRUE(ev.fill(9));
+  TEST_ASSERT_EQUAL_MEMORY("data: x\n\n", ev.buf, 9);
+
+  // Тело больше буфера передачи — append() ждёт отправки
+  TEST_ASSERT_TRUE(big.open(s.srv.port()));
+  TEST_ASSERT_EQUAL(200, big.get("/big"));
+  TEST_ASSERT_EQUAL(5000, (int)big.len + (int)big.bodyLen);
+}
+
+// Генератор отдаёт 64 МБ порциями по мере чтения
+void test_producer_streams_long_body(void) {
+  ServerThread s(testConfig());
+  TEST_ASSERT_TRUE(s.start());
+  Client c;
+  TEST_ASSERT_TRUE(c.open(s.srv.port()));
+  c.put("GET /flood HTTP/1.1\r\n\r\n");
+  TEST_ASSERT_TRUE(c.fill(1));
+  char *end;
+  while (!(end = (char *)memmem(c.buf, c.len, "\r\n\r\n", 4)))
+    TEST_ASSERT_TRUE(c.fill(c.len + 1));
+  size_t body = c.buf + c.len - (end + 4);
+  bool onlyY = true;
+  for (char *p = end + 4; p < c.buf + c.len; ++p)
+    onlyY &= *p == 'y';
+  while (true) {
+    ssize_t n = recv(c.fd, c.buf, sizeof(c.buf), 0);
+    if (n <= 0)
+      break;
+    for (ssize_t i = 0; i < n; ++i)
+      onlyY &= c.buf[i] == 'y';
+    body += n;
+  }
+  TEST_ASSERT_TRUE(onlyY);
+  TEST_ASSERT_EQUAL(64000u * 1000u, (unsigned)body);
+}
+
+// Два клиента запросили по 64 МБ и не читают: генератор стоит, append()
+// ждёт не дольше HTTP_APPEND_WAIT_MS и закрывает соединение — остальные
+// запросы идут без задержек; застрявший генератор закрывается по таймауту
+void test_slow_reader_does_not_stall_loop(void) {
+  HttpServerConfig cfg = testConfig();
+  cfg.requestTimeoutMs = 300;
+  ServerThread s(cfg);
+  TEST_ASSERT_TRUE(s.start());
+  Client stuck, stuckAppend, fast;
+  stuck.smallWindow();
+  stuckAppend.smallWindow();
+  TEST_ASSERT_TRUE(stuck.open(s.srv.port()));
+  TEST_ASSERT_TRUE(stuckAppend.open(s.srv.port()));
+  stuck.put("GET /flood HTTP/1.1\r\n\r\n");
+  stuckAppend.put("GET /flood-append HTTP/1.1\r\n\r\n");
+  TEST_ASSERT_TRUE(fast.open(s.srv.port()));
+
+  std::vector<double> lat;
+  Clock::time_point t0 = Clock::now();
+  for (int i = 0; i < 500; ++i) {
+    Clock::time_point r0 = Clock::now();
+    TEST_ASSERT_EQUAL(200, fast.get("/echo?a=1"));
+    lat.push_back(msSince(r0));
+  }
+  LoadResult r = summarize(lat, msSince(t0));
+  char msg[96];
+  snprintf(msg, sizeof(msg), "next to 2 stuck readers: p99 %.2f ms, max %.2f",
+           r.p99, lat.back());
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_TRUE(r.p99 < 3);
+  TEST_ASSERT_TRUE(lat.back() < HTTP_APPEND_WAIT_MS + 20);
+
+  // Ядро изредка принимает ещё немного данных генератора, и отсчёт паузы
+  // начинается заново — на loopback до закрытия проходит до ~2 с
+  for (int i = 0; i < 1000 && s.srv.timeouts < 2; ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  TEST_ASSERT_EQUAL(2, s.srv.timeouts);
+  TEST_ASSERT_EQUAL(1, s.srv.connectionCount());
+}
+
+// Тело в 100 раз больше буфера приёма доходит кусками, следующий запрос
+// в том же пакете обслуживается; отказ в begin() — без чтения тела;
+// обрыв посреди тела — abort()
+void test_upload_streams_body(void) {
+  ServerThread s(testConfig());
+  TEST_ASSERT_TRUE(s.start());
+  Client c;
+  TEST_ASSERT_TRUE(c.open(s.srv.port()));
+
+  const size_t N = 100 * HTTP_RX_BUF;
+  std::vector<uint8_t> body(N);
+  uint32_t sum = 0;
+  for (size_t i = 0; i < N; ++i) {
+    body[i] = (uint8_t)(i * 7 + i / 251);
+    sum = sum * 31 + body[i];
+  }
+  char head[128];
+  snprintf(head, sizeof(head),
+           "POST /upload HTTP/1.1\r\nX-Key: ok\r\nContent-Length: %zu"
+           "\r\n\r\n",
+           N);
+  c.put(head);
+  for (size_t off = 0; off < N - 100; off += 4000)
+    ::send(c.fd, body.data() + off, std::min<size_t>(4000, N - 100 - off),
+           MSG_NOSIGNAL);
+  std::string tail((const char *)body.data() + N - 100, 100);
+  tail += "GET /echo?a=7 HTTP/1.1\r\n\r\n";
+  ::send(c.fd, tail.data(), tail.size(), MSG_NOSIGNAL);
+
+  TEST_ASSERT_EQUAL(200, c.response());
+  char expect[64];
+  snprintf(expect, sizeof(expect), "%zu %u", N, (unsigned)sum);
+  TEST_ASSERT_EQUAL_STRING(expect, c.body);
+  TEST_ASSERT_TRUE(countingUpload.chunks > 1);
+  TEST_ASSERT_TRUE(countingUpload.maxChunk < HTTP_RX_BUF);
+  TEST_ASSERT_EQUAL(200, c.response());
+  TEST_ASSERT_EQUAL_STRING("7||", c.body);
+
+  Client bad;
+  TEST_ASSERT_TRUE(bad.open(s.srv.port()));
+  bad.put("POST /upload HTTP/1.1\r\nX-Key: no\r\nContent-Length: 5000"
+          "\r\n\r\n");
+  TEST_ASSERT_EQUAL(401, bad.response());
+  TEST_ASSERT_TRUE(bad.closedByPeer());
+  TEST_ASSERT_EQUAL(0, (int)countingUpload.bytes);
+
+  {
+    Client cut;
+    TEST_ASSERT_TRUE(cut.open(s.srv.port()));
+    cut.put("POST /upload HTTP/1.1\r\nX-Key: ok\r\nContent-Length: 5000"
+            "\r\n\r\npartial");
+  }
+  for (int i = 0; i < 200 && !countingUpload.aborts; ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  TEST_ASSERT_EQUAL(1, countingUpload.aborts.load());
+}
+
+// ---------- Нагрузка: событийный сервер против прежней схемы ----------
+
+// Модель WebServer + TaskWeb: handleClient() обслуживает одного клиента
+// (Connection: close), затем vTaskDelay(10)
+static void legacyServer(int lfd, std::atomic<bool> &stop) {
+  while (!stop) {
+    int fd = accept(lfd, nullptr, nullptr);
+    if (fd >= 0) {
+      char req[1024];
+      size_t len = 0;
+      while (len < sizeof(req) && !memmem(req, len, "\r\n\r\n", 4)) {
+        ssize_t n = recv(fd, req + len, sizeof(req) - len, 0);
+        if (n <= 0)
+          break;
+        len += n;
+      }
+      const char reply[] = "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\n"
+                           "Content-Length: 3\r\nConnection: close\r\n\r\n"
+                           "1||";
+      send(fd, reply, sizeof(reply) - 1, MSG_NOSIGNAL);
+      close(fd);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+}
+
+static LoadResult runClients(uint16_t port, int clients, int perClient,
+                             bool keepAlive) {
+  std::vector<std::vector<double>> lat(clients);
+  std::vector<std::thread> th;
+  Clock::time_point t0 = Clock::now();
+  for (int i = 0; i < clients; ++i)
+    th.emplace_back([&, i] {
+      Client *c = nullptr;
+      for (int k = 0; k < perClient; ++k) {
+        Clock::time_point r0 = Clock::now();
+        if (!c) {
+          c = new Client;
+          c->open(port);
+        }
+        c->get("/echo?a=1");
+        lat[i].push_back(msSince(r0));
+        if (!keepAlive) {
+          delete c;
+          c = nullptr;
+        }
+      }
+      delete c;
+    });
+  for (std::thread &t : th)
+    t.join();
+  double total = msSince(t0);
+  std::vector<double> all;
+  for (std::vector<double> &v : lat)
+    all.insert(all.end(), v.begin(), v.end());
+  return summarize(all, total);
+}
+
+void test_bench_load_vs_polling_server(void) {
+  const int CLIENTS = 4; // одновременных вкладок/телефонов
+
+  std::atomic<bool> stop{false};
+  int lfd = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in a{};
+  a.sin_family = AF_INET;
+  a.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t alen = sizeof(a);
+  bind(lfd, (sockaddr *)&a, sizeof(a));
+  listen(lfd, 16);
+  getsockname(lfd, (sockaddr *)&a, &alen);
+  timeval tv = {0, 1000};
+  setsockopt(lfd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+  std::thread legacy(legacyServer, lfd, std::ref(stop));
+  LoadResult old = runClients(ntohs(a.sin_port), CLIENTS, 15, false);
+  stop = true;
+  legacy.join();
+  close(lfd);
+
+  ServerThread s(testConfig());
+  TEST_ASSERT_TRUE(s.start());
+  LoadResult now = runClients(s.srv.port(), CLIENTS, 500, true);
+
+  char msg[160];
+  snprintf(msg, sizeof(msg),
+           "%d clients: polling %.0f req/s p99 %.1f ms | event-driven "
+           "%.0f req/s p99 %.2f ms",
+           CLIENTS, old.rps, old.p99, now.rps, now.p99);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_TRUE(now.rps > old.rps * 10);
+  TEST_ASSERT_TRUE(now.p99 < old.p99);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_routes_args_and_headers);
+  RUN_TEST(test_keep_alive_and_pipelining);
+  RUN_TEST(test_slow_client_does_not_block_others);
+  RUN_TEST(test_timeouts_close_idle_and_partial);
+  RUN_TEST(test_stream_broadcast_and_long_body);
+  RUN_TEST(test_producer_streams_long_body);
+  RUN_TEST(test_slow_reader_does_not_stall_loop);
+  RUN_TEST(test_upload_streams_body);
+  RUN_TEST(test_bench_load_vs_polling_server);
+  return UNITY_END();
+}
@@ -0,0 +1,398 @@
+// JSON без выделения памяти + модель фрагментации кучи: pio test -e native
+#include <unity.h>
+
+#include <map>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+#include "JsonWriter.h"
+#include "ScanCache.h"
+#include "StatusFrame.h"
+
+// Счётчик выделений вне арены (см. ниже)
+static long heapAllocs = 0;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// Ответ /api/status; возвращает длину или 0 при переполнении
+static size_t renderStatus(char *buf, size_t cap, int i) {
+  JsonWriter w(buf, cap);
+  w.beginObject()
+      .field("time", "12:34:56")
+      .field("volts", 5.25f + i % 7)
+      .field("sunAz", 181.4f)
+      .field("sunAlt", 42.1f)
+      .field("curHor", 90 + i % 3)
+      .field("curVer", 45)
+      .field("mode", 0)
+      .field("isAP", false)
+      .field("isNight", false)
+      .field("lat", 51.1333f, 4)
+      .field("lon", 71.4333f, 4)
+      .field("gmt", 5)
+      .field("verMin", 15)
+      .field("verMax", 90)
+      .field("hOff", 0)
+      .field("vOff", 0)
+      .field("ssid", "MyHome \"WiFi\"")
+      .endObject();
+  return w.overflow() ? 0 : w.length();
+}
+
+void test_object_and_escaping(void) {
+  char buf[128];
+  JsonWriter w(buf, sizeof(buf));
+  w.beginObject().field("a", 1).key("b").beginArray().value("x\n").value(
+      2.5f, 1);
+  w.value(true).endArray().field("c", "q\"\\").endObject();
+  TEST_ASSERT_EQUAL_STRING(
+      "{\"a\":1,\"b\":[\"x\\u000a\",2.5,true],\"c\":\"q\\\"\\\\\"}", w.c_str());
+}
+
+void test_overflow_is_flagged(void) {
+  char buf[16];
+  JsonWriter w(buf, sizeof(buf));
+  w.beginObject().field("long_key_name", "long value").endObject();
+  TEST_ASSERT_TRUE(w.overflow());
+  TEST_ASSERT_EQUAL(15, strlen(w.c_str()));
+}
+
+// Длинные числа целиком: раньше всё, что длиннее 23 символов, обрезалось
+void test_long_numbers_are_not_truncated(void) {
+  char buf[256];
+  JsonWriter w(buf, sizeof(buf));
+  w.beginArray()
+      .value(-3.4e38f, 20)
+      .value(-9223372036854775807LL - 1)
+      .value(18446744073709551615ULL)
+      .endArray();
+  TEST_ASSERT_FALSE(w.overflow());
+  char want[256];
+  snprintf(want, sizeof(want), "[%.9f,-9223372036854775808,"
+           "18446744073709551615]", (double)-3.4e38f);
+  TEST_ASSERT_EQUAL_STRING(want, w.c_str());
+  TEST_ASSERT_EQUAL(50, strchr(w.c_str(), ',') - w.c_str() - 1);
+}
+
+static void collect(const char *data, size_t len, void *ctx) {
+  static_cast<std::string *>(ctx)->append(data, len);
+}
+
+void test_chunked_equals_whole(void) {
+  char whole[512];
+  size_t n = renderStatus(whole, sizeof(whole), 3);
+  TEST_ASSERT_GREATER_THAN(0, n);
+
+  std::string out;
+  char small[24];
+  JsonWriter w(small, sizeof(small), collect, &out);
+  w.beginObject()
+      .field("time", "12:34:56")
+      .field("volts", 5.25f + 3)
+      .field("sunAz", 181.4f)
+      .field("sunAlt", 42.1f)
+      .field("curHor", 90)
+      .field("curVer", 45)
+      .field("mode", 0)
+      .field("isAP", false)
+      .field("isNight", false)
+      .field("lat", 51.1333f, 4)
+      .field("lon", 71.4333f, 4)
+      .field("gmt", 5)
+      .field("verMin", 15)
+      .field("verMax", 90)
+      .field("hOff", 0)
+      .field("vOff", 0)
+      .field("ssid", "MyHome \"WiFi\"")
+      .endObject();
+  w.finish();
+  TEST_ASSERT_EQUAL(n, out.size());
+  TEST_ASSERT_EQUAL(n, w.written());
+  TEST_ASSERT_EQUAL_STRING(whole, out.c_str());
+}
+
+void test_zero_allocations(void) {
+  char buf[512];
+  long before = heapAllocs;
+  for (int i = 0; i < 20000; i++)
+    renderStatus(buf, sizeof(buf), i);
+  TEST_ASSERT_EQUAL(0, heapAllocs - before);
+}
+
+// ---- Куча под наблюдением: first-fit со слиянием свободных блоков ----
+// Пока heap не nullptr, operator new берёт память из арены фиксированного
+// размера (как куча ESP32): через неё проходят и std::string старого
+// кода, и настоящие обработчики на JsonWriter
+struct Arena {
+  explicit Arena(size_t size) : size(size), mem((char *)malloc(size)) {
+    freeBlocks[0] = size;
+  }
+  ~Arena() { free(mem); }
+
+  void *alloc(size_t n) {
+    n = (n + 7) & ~(size_t)7;
+    for (auto it = freeBlocks.begin(); it != freeBlocks.end(); ++it) {
+      if (it->second < n)
+        continue;
+      size_t off = it->first, sz = it->second;
+      freeBlocks.erase(it);
+      if (sz > n)
+        freeBlocks[off + n] = sz - n;
+      used[off] = n;
+      allocs++;
+      return mem + off;
+    }
+    return nullptr;
+  }
+
+  void release(void *p) {
+    size_t off = (char *)p - mem;
+    size_t n = used[off];
+    used.erase(off);
+    auto it = freeBlocks.emplace(off, n).first;
+    auto next = std::next(it);
+    if (next != freeBlocks.end() && it->first + it->second == next->first) {
+      it->second += next->second;
+      freeBlocks.erase(next);
+    }
+    if (it != freeBlocks.begin()) {
+      auto prev = std::prev(it);
+      if (prev->first + prev->second == it->first) {
+        prev->second += it->second;
+        freeBlocks.erase(it);
+      }
+    }
+  }
+
+  bool owns(const void *p) const {
+    return p >= (const void *)mem && p < (const void *)(mem + size);
+  }
+  size_t totalFree() const {
+    size_t t = 0;
+    for (auto &b : freeBlocks)
+      t += b.second;
+    return t;
+  }
+  size_t largestFree() const {
+    size_t m = 0;
+    for (auto &b : freeBlocks)
+      m = b.second > m ? b.second : m;
+    return m;
+  }
+
+  size_t size;
+  char *mem;
+  long allocs = 0;
+  std::map<size_t, size_t> freeBlocks;
+  std::map<size_t, size_t> used;
+};
+
+static Arena *heap = nullptr;
+static bool inArena = false; // узлы std::map самой арены — из malloc
+
+static void *heapAlloc(size_t n) {
+  inArena = true;
+  void *p = heap->alloc(n);
+  inArena = false;
+  if (!p)
+    throw std::bad_alloc();
+  return p;
+}
+
+void *operator new(size_t n) {
+  if (heap && !inArena)
+    return heapAlloc(n);
+  heapAllocs++;
+  void *p = malloc(n ? n : 1);
+  if (!p)
+    throw std::bad_alloc();
+  return p;
+}
+void operator delete(void *p) noexcept {
+  if (heap && heap->owns(p)) {
+    inArena = true;
+    heap->release(p);
+    inArena = false;
+  } else {
+    free(p);
+  }
+}
+void operator delete(void *p, size_t) noexcept { operator delete(p); }
+
+// Сетевой стек при отправке берёт буферы (pbuf), живущие дольше запроса;
+// в старом коде тело ответа в этот момент ещё лежит в куче
+static void (*onSend)() = nullptr;
+
+// Старые обработчики: String-конкатенация, как до JsonWriter
+static std::string str(float v) {
+  char t[16];
+  snprintf(t, sizeof(t), "%.2f", v); // String(float) — два знака
+  return t;
+}
+static std::string str(int v) { return std::to_string(v); }
+
+static size_t legacySend(const std::string &json) {
+  // WebServer::send собирает заголовки в String
+  std::string head = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n"
+                     "Content-Length: " +
+                     str((int)json.size()) + "\r\nConnection: close\r\n\r\n";
+  onSend();
+  return head.size() + json.size();
+}
+
+static size_t legacyStatus(const TrackerSnapshot &snap, int i) {
+  std::string json = "{";
+  json += "\"time\":\"" + std::string("12:34:56") + "\",";
+  json += "\"volts\":" + str(snap.panelVolts) + ",";
+  json += "\"sunAz\":" + str(snap.sunAz) + ",";
+  json += "\"sunAlt\":" + str(snap.sunAlt) + ",";
+  json += "\"curHor\":" + str(90 + i % 3) + ",";
+  json += "\"curVer\":" + str(45) + ",";
+  json += "\"mode\":" + str(snap.mode) + ",";
+  json += "\"isAP\":" + std::string("false") + ",";
+  json += "\"isNight\":" + std::string("false") + ",";
+  json += "\"lat\":" + str(51.1333f) + ",\"lon\":" + str(71.4333f) + ",";
+  json += "\"gmt\":" + str(5) + ",\"verMin\":" + str(15) + ",";
+  json += "\"verMax\":" + str(90) + ",\"hOff\":" + str(0) + ",";
+  json += "\"vOff\":" + str(0) + ",\"ssid\":\"" + std::string("MyHome") +
+          "\"}";
+  return legacySend(json);
+}
+
+static size_t legacyScan(const ScanCache &scan) {
+  std::string json = "[";
+  for (int i = 0; i < scan.size(); ++i) {
+    if (i > 0)
+      json += ",";
+    json += "{\"ssid\":\"" + std::string(scan[i].ssid) +
+            "\",\"rssi\":" + str(scan[i].rssi) + "}";
+  }
+  json += "]";
+  return legacySend(json);
+}
+
+// Нынешние обработчики /api/status и /api/scan из main.cpp
+static void sink(const char *, size_t, void *) {} // статический буфер сервера
+
+static size_t writerStatus(const TrackerSnapshot &snap, int i) {
+  char buf[512];
+  JsonWriter w(buf, sizeof(buf));
+  writeStatusDelta(w, nullptr,
+                   makeStatusFrame(snap, 90 + i % 3, 45, false, 45296 + i));
+  onSend();
+  return w.length();
+}
+
+static size_t writerScan(const ScanCache &scan) {
+  char buf[256];
+  JsonWriter w(buf, sizeof(buf), sink);
+  scan.write(w, 1000);
+  w.finish();
+  onSend();
+  return w.written();
+}
+
+struct SoakResult {
+  double avgFrag;     // 1 - largest/free, среднее по запросам
+  size_t minLargest;  // худший наибольший свободный блок
+  size_t largest;     // в конце прогона
+  size_t total;       // свободно всего в конце прогона
+  long allocs;        // выделений в арене
+  long handlerAllocs; // из них — в обработчиках
+  size_t bytes;       // отдано клиентам
+};
+
+// Запросы /api/status (и каждый десятый — /api/scan) на фоне
+// "долгоживущих" блоков сетевого стека (сокеты, lwIP)
+static SoakResult soak(bool legacyString, int requests) {
+  ScanCache scan;
+  scan.started(0);
+  for (int i = 0; i < 12; i++) {
+    char ssid[24];
+    snprintf(ssid, sizeof(ssid), "Neighbour-%d", i);
+    scan.add(ssid, -40 - i * 4, 1 + i, i % 4 == 0);
+  }
+  scan.done(0);
+  TrackerSnapshot snap = {};
+  snap.sunAz = 181.4f;
+  snap.sunAlt = 42.1f;
+
+  Arena arena(48 * 1024);
+  heap = &arena;
+  srand(7);
+  const int SLOTS = 24; // ~18 КБ долгоживущих буферов из 48 КБ
+  static void *longLived[SLOTS];
+  static int ttl[SLOTS], slot;
+  static long stackAllocs;
+  stackAllocs = 0;
+  memset(longLived, 0, sizeof(longLived));
+  memset(ttl, 0, sizeof(ttl));
+  onSend = []() {
+    slot = (slot + 1) % SLOTS;
+    if (--ttl[slot] > 0)
+      return;
+    operator delete(longLived[slot]);
+    longLived[slot] = operator new(64 + rand() % 1400);
+    ttl[slot] = 10 + rand() % 200;
+    stackAllocs++;
+  };
+  SoakResult r = {0, arena.size, 0, 0, 0, 0, 0};
+  for (int q = 0; q < requests; q++) {
+    snap.panelVolts = 5.25f + q % 7;
+    long before = arena.allocs - stackAllocs;
+    if (legacyString)
+      r.bytes += legacyStatus(snap, q) + (q % 10 ? 0 : legacyScan(scan));
+    else
+      r.bytes += writerStatus(snap, q) + (q % 10 ? 0 : writerScan(scan));
+    r.handlerAllocs += arena.allocs - stackAllocs - before;
+
+    r.avgFrag += 1.0 - (double)arena.largestFree() / arena.totalFree();
+    if (arena.largestFree() < r.minLargest)
+      r.minLargest = arena.largestFree();
+  }
+  r.avgFrag /= requests;
+  r.allocs = arena.allocs;
+  r.largest = arena.largestFree();
+  r.total = arena.totalFree();
+  for (void *p : longLived)
+    operator delete(p);
+  heap = nullptr;
+  return r;
+}
+
+static void report(const char *name, const SoakResult &r) {
+  char msg[160];
+  snprintf(msg, sizeof(msg),
+           "%s: frag %.3f, min largest %zu B, now %zu of %zu B free, "
+           "%ld allocs (%ld in handlers)",
+           name, r.avgFrag, r.minLargest, r.largest, r.total, r.allocs,
+           r.handlerAllocs);
+  TEST_MESSAGE(msg);
+}
+
+void test_soak_fragmentation(void) {
+  const int N = 20000;
+  SoakResult legacy = soak(true, N);
+  SoakResult writer = soak(false, N);
+  report("String", legacy);
+  report("JsonWriter", writer);
+  TEST_ASSERT_EQUAL(0, writer.handlerAllocs);
+  TEST_ASSERT_GREATER_THAN(N * 100, writer.bytes);
+  TEST_ASSERT_GREATER_THAN(N, legacy.handlerAllocs);
+  TEST_ASSERT_LESS_THAN(legacy.avgFrag, writer.avgFrag);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_object_and_escaping);
+  RUN_TEST(test_overflow_is_flagged);
+  RUN_TEST(test_long_numbers_are_not_truncated);
+  RUN_TEST(test_chunked_equals_whole);
+  RUN_TEST(test_zero_allocations);
+  RUN_TEST(test_soak_fragmentation);
+  return UNITY_END();
+}
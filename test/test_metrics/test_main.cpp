@@ -0,0 +1,105 @@
+// Метрики в формате Prometheus: pio test -e native
+#include <unity.h>
+
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+#include "HttpServer.h"
+#include "Metrics.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static void collect(const char *data, size_t len, void *ctx) {
+  ((std::string *)ctx)->append(data, len);
+}
+
+void test_histogram_buckets_sum_count(void) {
+  LatencyHistogram h;
+  h.record(40);      // <= 50 мкс
+  h.record(50);      // граница включительно
+  h.record(700);     // <= 1 мс
+  h.record(2000000); // +Inf
+  TEST_ASSERT_EQUAL(4, h.count());
+  TEST_ASSERT_EQUAL(2000000, h.max());
+  TEST_ASSERT_FLOAT_WITHIN(1e-9, 2.00079, h.sumSeconds());
+
+  char buf[2048];
+  PromWriter w(buf, sizeof(buf));
+  h.write(w, "x_seconds", "task=\"t\"");
+  const char *out = w.c_str();
+  auto has = [&](const char *line) { return strstr(out, line) != nullptr; };
+  TEST_ASSERT_FALSE(w.overflow());
+  TEST_ASSERT_TRUE(has("x_seconds_bucket{task=\"t\",le=\"5e-05\"} 2\n"));
+  TEST_ASSERT_TRUE(has("x_seconds_bucket{task=\"t\",le=\"0.0005\"} 2\n"));
+  TEST_ASSERT_TRUE(has("x_seconds_bucket{task=\"t\",le=\"0.001\"} 3\n"));
+  TEST_ASSERT_TRUE(has("x_seconds_bucket{task=\"t\",le=\"0.1\"} 3\n"));
+  TEST_ASSERT_TRUE(has("x_seconds_bucket{task=\"t\",le=\"+Inf\"} 4\n"));
+  TEST_ASSERT_TRUE(has("x_seconds_sum{task=\"t\"} 2.00079\n"));
+  TEST_ASSERT_TRUE(has("x_seconds_count{task=\"t\"} 4\n"));
+}
+
+void test_sum_does_not_wrap(void) {
+  LatencyHistogram h;
+  for (int i = 0; i < 5000; ++i)
+    h.record(1000000); // 5000 с > 2^32 мкс
+  TEST_ASSERT_FLOAT_WITHIN(1e-6, 5000.0, h.sumSeconds());
+}
+
+void test_writer_flushes_in_chunks(void) {
+  std::string out;
+  char buf[64]; // меньше всего ответа
+  PromWriter w(buf, sizeof(buf), collect, &out);
+  w.family("heap_free_bytes", "gauge", "Free heap");
+  w.sample("heap_free_bytes", "", (uint32_t)123456);
+  w.sample("uptime_seconds", "", 1.5);
+  w.finish();
+  TEST_ASSERT_FALSE(w.overflow());
+  TEST_ASSERT_EQUAL_STRING("# HELP heap_free_bytes Free heap\n"
+                           "# TYPE heap_free_bytes gauge\n"
+                           "heap_free_bytes 123456\n"
+                           "uptime_seconds 1.5\n",
+                           out.c_str());
+}
+
+void test_http_routes_listed(void) {
+  HttpServer srv;
+  srv.on(HTTP_METHOD_GET, "/api/status", [](HttpRequest &, HttpResponse &) {});
+  std::string out;
+  char buf[256];
+  PromWriter w(buf, sizeof(buf), collect, &out);
+  srv.writeMetrics(w);
+  w.finish();
+  TEST_ASSERT_NOT_NULL(strstr(out.c_str(),
+                              "http_request_duration_seconds_count{method="
+                              "\"GET\",path=\"/api/status\"} 0\n"));
+  TEST_ASSERT_NOT_NULL(strstr(out.c_str(), "http_requests_total 0\n"));
+}
+
+// Цена замера на горячем пути
+void test_bench_timer_overhead(void) {
+  LatencyHistogram h;
+  const int N = 1000000;
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < N; ++i) {
+    LatencyTimer t(h);
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / N;
+  char msg[64];
+  snprintf(msg, sizeof(msg), "LatencyTimer: %.1f ns per scope", ns);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_EQUAL(N, h.count());
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_histogram_buckets_sum_count);
+  RUN_TEST(test_sum_does_not_wrap);
+  RUN_TEST(test_writer_flushes_in_chunks);
+  RUN_TEST(test_http_routes_listed);
+  RUN_TEST(test_bench_timer_overhead);
+  return UNITY_END();
+}
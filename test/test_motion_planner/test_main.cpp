@@ -0,0 +1,149 @@
+// Планировщик движения серво: pio test -e native
+#include <unity.h>
+
+#include <math.h>
+#include <stdio.h>
+
+#include "FakeHal.h"
+#include "MotionPlanner.h"
+
+static FakeServos servos;
+
+void setUp(void) { servos = FakeServos(); }
+void tearDown(void) {}
+
+// Шаги до остановки; peakVel — наибольшая наблюдаемая скорость оси
+static int runToStop(MotionPlanner &mp, float &peakVel) {
+  const float dt = MOTION_PERIOD_MS / 1000.0f;
+  int prev[AXIS_COUNT] = {mp.hor(), mp.ver()};
+  int steps = 0;
+  peakVel = 0;
+  do {
+    mp.step(MOTION_PERIOD_MS);
+    int p[AXIS_COUNT] = {mp.hor(), mp.ver()};
+    for (int i = 0; i < AXIS_COUNT; i++) {
+      peakVel = fmaxf(peakVel, fabsf((p[i] - prev[i]) / dt));
+      prev[i] = p[i];
+    }
+    steps++;
+  } while (mp.moving() && steps < 100000);
+  return steps;
+}
+
+void test_move_to_returns_immediately(void) {
+  MotionPlanner mp(servos);
+  mp.power(true);
+  mp.moveTo(degToAngle(0), degToAngle(15));
+  TEST_ASSERT_TRUE(mp.moving());
+  TEST_ASSERT_EQUAL(0, servos.writes);
+  TEST_ASSERT_EQUAL_INT(90, mp.hor());
+}
+
+void test_full_sweep_trapezoid(void) {
+  MotionPlanner mp(servos, degToAngle(0), degToAngle(15));
+  mp.power(true);
+  mp.moveTo(degToAngle(180), degToAngle(90));
+  float peak;
+  int steps = runToStop(mp, peak);
+  TEST_ASSERT_EQUAL_INT(180, mp.hor());
+  TEST_ASSERT_EQUAL_INT(90, mp.ver());
+  TEST_ASSERT_EQUAL_INT(180, servos.hor);
+
+  // 180° при 30°/с и 60°/с^2: 0.5 с разгона + 5.5 с + 0.5 с торможения
+  float seconds = steps * MOTION_PERIOD_MS / 1000.0f;
+  char msg[80];
+  snprintf(msg, sizeof(msg), "180 deg: %.2f s, %ld writes, peak %.1f deg/s",
+           seconds, servos.writes, peak);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_FLOAT_WITHIN(0.3, 6.5, seconds);
+  // Позиции целые — допускаем 1° округления за шаг
+  TEST_ASSERT_LESS_OR_EQUAL(30.0f + 1000.0f / MOTION_PERIOD_MS, peak);
+}
+
+void test_axes_move_concurrently(void) {
+  MotionPlanner mp(servos, degToAngle(90), degToAngle(90));
+  mp.power(true);
+  mp.moveTo(degToAngle(120), degToAngle(60));
+  for (int i = 0; i < 25; i++)
+    mp.step(MOTION_PERIOD_MS);
+  TEST_ASSERT_GREATER_THAN(90, mp.hor());
+  TEST_ASSERT_LESS_THAN(90, mp.ver());
+}
+
+void test_retarget_mid_move(void) {
+  MotionPlanner mp(servos, degToAngle(0), degToAngle(45));
+  mp.power(true);
+  mp.moveTo(degToAngle(180), degToAngle(45));
+  for (int i = 0; i < 100; i++)
+    mp.step(MOTION_PERIOD_MS);
+  int mid = mp.hor();
+  TEST_ASSERT_GREATER_THAN(20, mid);
+  mp.moveTo(degToAngle(10), degToAngle(45));
+  float peak;
+  runToStop(mp, peak);
+  TEST_ASSERT_EQUAL_INT(10, mp.hor());
+}
+
+void test_power_off_suppresses_writes(void) {
+  MotionPlanner mp(servos);
+  mp.power(true);
+  mp.step(MOTION_PERIOD_MS);
+  TEST_ASSERT_TRUE(servos.isAttached);
+  TEST_ASSERT_EQUAL(1, servos.writes); // возврат в позицию после attach
+
+  mp.power(false);
+  mp.moveTo(degToAngle(100), degToAngle(90));
+  float peak;
+  runToStop(mp, peak);
+  TEST_ASSERT_FALSE(servos.isAttached);
+  TEST_ASSERT_EQUAL(1, servos.writes);
+}
+
+void test_reset_keeps_position(void) {
+  MotionPlanner mp(servos);
+  mp.reset(degToAngle(37), degToAngle(52)); // положение серво до deep sleep
+  mp.power(true);
+  mp.step(MOTION_PERIOD_MS);
+  TEST_ASSERT_FALSE(mp.moving());
+  TEST_ASSERT_EQUAL(37, servos.hor);
+  TEST_ASSERT_EQUAL(52, servos.ver);
+  mp.moveTo(degToAngle(40), degToAngle(52));
+  mp.step(MOTION_PERIOD_MS);
+  TEST_ASSERT_TRUE(servos.hor >= 37 && servos.hor < 40); // плавно
+}
+
+// Каждый сменившийся шаг уходит в исполнительный слой, в том числе доли
+// градуса; остановка — точно в цели. Зону нечувствительности держит
+// ActuatorArray (test_actuator_array)
+void test_fractions_reach_actuator(void) {
+  MotionPlanner mp(servos, degToAngle(0), degToAngle(45));
+  mp.power(true);
+  mp.moveTo(degToAngle(180), 4525);
+  bool fraction = false;
+  for (int i = 0; i < 100; i++) {
+    mp.step(MOTION_PERIOD_MS);
+    fraction |= servos.horFine % ANGLE_SCALE != 0;
+  }
+  TEST_ASSERT_TRUE(fraction);
+  TEST_ASSERT_EQUAL(100, servos.writes);
+
+  float peak;
+  runToStop(mp, peak);
+  TEST_ASSERT_EQUAL(degToAngle(180), servos.horFine);
+  TEST_ASSERT_EQUAL(4525, servos.verFine);
+  long writes = servos.writes;
+  mp.step(MOTION_PERIOD_MS); // стоим — не пишем
+  TEST_ASSERT_EQUAL(writes, servos.writes);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_move_to_returns_immediately);
+  RUN_TEST(test_full_sweep_trapezoid);
+  RUN_TEST(test_axes_move_concurrently);
+  RUN_TEST(test_retarget_mid_move);
+  RUN_TEST(test_power_off_suppresses_writes);
+  RUN_TEST(test_reset_keeps_position);
+  RUN_TEST(test_fractions_reach_actuator);
+  return UNITY_END();
+}
@@ -0,0 +1,344 @@
+// MQTT: пачки, буфер на время обрыва, вытеснение: pio test -e native
+// Брокер-заглушка в отдельном потоке (CONNECT/PUBLISH QoS 1/PINGREQ).
+// Настоящий брокер: MQTT_BROKER=127.0.0.1[:1883] (например, mosquitto)
+#include <unity.h>
+
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "MqttPublisher.h"
+
+using Clock = std::chrono::steady_clock;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static const uint32_t T0 = 1718236800; // 2024-06-13 00:00 UTC
+
+static MqttRecord record(uint32_t i) {
+  MqttRecord r = {};
+  r.s.t = T0 + i * HISTORY_PERIOD_S;
+  r.s.voltsCenti = 500 + i % 100;
+  r.s.sunAzDeci = 1800;
+  r.s.sunAltDeci = 450;
+  r.s.hor = 90;
+  r.s.ver = 45;
+  r.whDeci = i;
+  return r;
+}
+
+// ---------- Брокер-заглушка ----------
+struct Broker {
+  int lfd = -1;
+  uint16_t port = 0;
+  std::thread th;
+  std::atomic<bool> stop{false};
+  std::atomic<bool> down{false}; // обрыв: соединения сразу закрываются
+  std::atomic<int> connects{0};
+  std::mutex m;
+  std::vector<uint32_t> times; // t записей в порядке прихода
+  std::vector<int> batches;    // записей в каждом PUBLISH
+  std::string willTopic;
+
+  Broker() {
+    lfd = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(lfd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in a{};
+    a.sin_family = AF_INET;
+    a.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    bind(lfd, (sockaddr *)&a, sizeof(a));
+    listen(lfd, 4);
+    socklen_t len = sizeof(a);
+    getsockname(lfd, (sockaddr *)&a, &len);
+    port = ntohs(a.sin_port);
+    th = std::thread([this] { run(); });
+  }
+  ~Broker() {
+    stop = true;
+    th.join();
+    close(lfd);
+  }
+
+  static bool wait(int fd, int ms) {
+    pollfd p = {fd, POLLIN, 0};
+    return poll(&p, 1, ms) > 0;
+  }
+
+  void run() {
+    while (!stop) {
+      if (!wait(lfd, 5))
+        continue;
+      int fd = accept(lfd, nullptr, nullptr);
+      if (fd < 0)
+        continue;
+      if (!down)
+        serve(fd);
+      close(fd);
+    }
+  }
+
+  void serve(int fd) {
+    uint8_t buf[8192];
+    size_t len = 0;
+    while (!stop && !down) {
+      if (!wait(fd, 5))
+        continue;
+      ssize_t n = recv(fd, buf + len, sizeof(buf) - len, 0);
+      if (n <= 0)
+        return;
+      len += n;
+      size_t pos = 0;
+      while (len - pos >= 2) {
+        size_t rem = 0, h = 1;
+        int shift = 0;
+        uint8_t b;
+        do {
+          if (pos + h >= len)
+            goto more;
+          b = buf[pos + h++];
+          rem |= (size_t)(b & 0x7F) << shift;
+          shift += 7;
+        } while (b & 0x80);
+        if (pos + h + rem > len)
+          break;
+        if (!packet(fd, buf[pos], buf + pos + h, rem))
+          return;
+        pos += h + rem;
+      }
+    more:
+      len -= pos;
+      memmove(buf, buf + pos, len);
+    }
+  }
+
+  static uint16_t u16(const uint8_t *p) { return p[0] << 8 | p[1]; }
+
+  bool packet(int fd, uint8_t type, const uint8_t *d, size_t n) {
+    switch (type & 0xF0) {
+    case 0x10: { // CONNECT: "MQTT", 4, flags, keepalive, id, will
+      uint8_t flags = d[7];
+      size_t p = 10;
+      p += 2 + u16(d + p); // client id
+      if (flags & 0x04) {
+        std::lock_guard<std::mutex> g(m);
+        willTopic.assign((const char *)d + p + 2, u16(d + p));
+      }
+      const uint8_t ack[] = {0x20, 2, 0, 0};
+      send(fd, ack, sizeof(ack), MSG_NOSIGNAL);
+      ++connects;
+      return true;
+    }
+    case 0x30: { // PUBLISH
+      size_t p = 2 + u16(d);
+      uint16_t id = 0;
+      if (type & 0x06) {
+        id = u16(d + p);
+        p += 2;
+      }
+      collect((const char *)d + p, n - p);
+      if (id) {
+        const uint8_t ack[] = {0x40, 2, (uint8_t)(id >> 8),
+                               (uint8_t)(id & 0xFF)};
+        send(fd, ack, sizeof(ack), MSG_NOSIGNAL);
+      }
+      return true;
+    }
+    case 0xC0: { // PINGREQ
+      const uint8_t resp[] = {0xD0, 0};
+      send(fd, resp, sizeof(resp), MSG_NOSIGNAL);
+      return true;
+    }
+    case 0xE0: // DISCONNECT
+      return false;
+    }
+    return true;
+  }
+
+  // t — первое число каждой записи в "data":[[..],[..]]
+  void collect(const char *json, size_t n) {
+    std::string s(json, n);
+    size_t at = s.find("\"data\":[");
+    if (at == std::string::npos)
+      return;
+    std::lock_guard<std::mutex> g(m);
+    int count = 0;
+    for (size_t i = at + 8; (i = s.find('[', i)) != std::string::npos; ++i) {
+      times.push_back(strtoul(s.c_str() + i + 1, nullptr, 10));
+      ++count;
+    }
+    batches.push_back(count);
+  }
+
+  size_t received() {
+    std::lock_guard<std::mutex> g(m);
+    return times.size();
+  }
+};
+
+// ---------- Издатель ----------
+struct Device {
+  MqttClient client;
+  MqttPublisher pub{client, "solar/test/telemetry", "test"};
+  uint32_t now = 0; // виртуальные миллисекунды
+
+  void start(const char *host, uint16_t port) {
+    client.begin({host, port, "solar-test", "solar/test/status", "offline"},
+                 now);
+  }
+  // Виртуальное время идёт шагами step, сеть — настоящая
+  template <typename Pred> bool run(uint32_t ms, uint32_t step, Pred done) {
+    for (uint32_t end = now + ms; now < end; now += step) {
+      pub.poll(now);
+      if (done())
+        return true;
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    return done();
+  }
+};
+
+static void checkInOrder(Broker &b, uint32_t first, uint32_t count) {
+  std::lock_guard<std::mutex> g(b.m);
+  // Повторы после обрыва допустимы, пропуски и перестановки — нет
+  uint32_t expect = 0;
+  for (uint32_t t : b.times) {
+    uint32_t i = (t - T0) / HISTORY_PERIOD_S;
+    TEST_ASSERT_TRUE(i <= first + expect);
+    if (i == first + expect)
+      ++expect;
+  }
+  TEST_ASSERT_EQUAL_UINT32(count, expect);
+}
+
+void test_batches_in_order(void) {
+  Broker b;
+  Device d;
+  d.start("127.0.0.1", b.port);
+  TEST_ASSERT_TRUE(d.run(5000, 10, [&] { return d.client.online(); }));
+  for (uint32_t i = 0; i < 95; ++i)
+    d.pub.push(record(i));
+  // Три полные пачки сразу, хвост — по MQTT_FLUSH_MS
+  TEST_ASSERT_TRUE(d.run(5000, 10, [&] { return d.pub.sent == 90; }));
+  TEST_ASSERT_EQUAL_UINT32(5, d.pub.depth());
+  TEST_ASSERT_TRUE(d.run(MQTT_FLUSH_MS + 5000, 100,
+                         [&] { return d.pub.depth() == 0; }));
+
+  TEST_ASSERT_EQUAL_UINT32(95, d.pub.sent);
+  TEST_ASSERT_EQUAL_UINT32(4, d.pub.batches);
+  TEST_ASSERT_EQUAL_UINT32(95, b.received());
+  checkInOrder(b, 0, 95);
+  std::lock_guard<std::mutex> g(b.m);
+  TEST_ASSERT_EQUAL_INT(MQTT_BATCH, b.batches[0]);
+  TEST_ASSERT_EQUAL_INT(5, b.batches[3]);
+  TEST_ASSERT_EQUAL_STRING("solar/test/status", b.willTopic.c_str());
+}
+
+// Запись каждые 10 с, обрыв на 30 мин: очередь растёт, после
+// восстановления сливается по порядку без потерь
+void test_outage_store_and_forward(void) {
+  Broker b;
+  Device d;
+  d.start("127.0.0.1", b.port);
+  TEST_ASSERT_TRUE(d.run(5000, 10, [&] { return d.client.online(); }));
+
+  uint32_t pushed = 0;
+  auto period = [&](bool outage) {
+    b.down = outage;
+    d.pub.push(record(pushed++));
+    d.run(HISTORY_PERIOD_S * 1000, 500, [] { return false; });
+  };
+  for (int i = 0; i < 60; ++i) // 10 мин связи
+    period(false);
+  for (int i = 0; i < 180; ++i) // 30 мин обрыва
+    period(true);
+  uint32_t depthAtReturn = d.pub.depth();
+  b.down = false;
+
+  auto t0 = Clock::now();
+  TEST_ASSERT_TRUE(d.run(120000, 10, [&] { return d.pub.depth() == 0; }));
+  double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0)
+                  .count();
+
+  TEST_ASSERT_TRUE(depthAtReturn >= 170);
+  TEST_ASSERT_EQUAL_UINT32(0, d.pub.dropped);
+  TEST_ASSERT_TRUE(d.client.drops >= 1);
+  TEST_ASSERT_TRUE(b.connects >= 2);
+  checkInOrder(b, 0, pushed);
+  printf("[mqtt] outage 30 min: depth %u (max %u), drained in %.0f ms "
+         "incl. reconnect, %u batches, %u resent\n",
+         (unsigned)depthAtReturn, (unsigned)d.pub.maxDepth, ms,
+         (unsigned)d.pub.batches, (unsigned)d.pub.resent);
+}
+
+// Полное кольцо теряет самые старые записи; слив полной очереди —
+// пропускная способность одного соединения с подтверждением каждой пачки
+void test_full_queue_drops_oldest(void) {
+  Device d;
+  const uint32_t extra = 88;
+  for (uint32_t i = 0; i < MQTT_QUEUE + extra; ++i)
+    d.pub.push(record(i));
+  d.pub.poll(0); // клиент не настроен — ничего не уходит
+  TEST_ASSERT_EQUAL_UINT32(MQTT_QUEUE, d.pub.depth());
+  TEST_ASSERT_EQUAL_UINT32(extra, d.pub.dropped);
+
+  Broker b;
+  d.now = MQTT_FLUSH_MS; // записи копились минуту — хвост тоже уходит сразу
+  d.start("127.0.0.1", b.port);
+  TEST_ASSERT_TRUE(d.run(5000, 10, [&] { return d.client.online(); }));
+  auto t0 = Clock::now();
+  size_t peak = d.pub.depth();
+  TEST_ASSERT_TRUE(d.run(60000, 1, [&] { return d.pub.depth() == 0; }));
+  double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0)
+                  .count();
+
+  TEST_ASSERT_EQUAL_UINT32(MQTT_QUEUE, d.pub.sent);
+  checkInOrder(b, extra, MQTT_QUEUE);
+  printf("[mqtt] drain %u records in %.1f ms: %.0f records/s, "
+         "%u batches\n",
+         (unsigned)peak, ms, peak * 1000.0 / ms, (unsigned)d.pub.batches);
+}
+
+// Живой брокер (mosquitto и т.п.), если задан MQTT_BROKER
+void test_real_broker(void) {
+  const char *env = getenv("MQTT_BROKER");
+  if (!env || !*env)
+    TEST_IGNORE_MESSAGE("MQTT_BROKER не задан");
+  static char host[64];
+  snprintf(host, sizeof(host), "%s", env);
+  uint16_t port = 1883;
+  if (char *colon = strchr(host, ':')) {
+    *colon = 0;
+    port = atoi(colon + 1);
+  }
+
+  Device d;
+  d.start(host, port);
+  TEST_ASSERT_TRUE(d.run(10000, 10, [&] { return d.client.online(); }));
+  for (uint32_t i = 0; i < 2 * MQTT_BATCH; ++i)
+    d.pub.push(record(i));
+  TEST_ASSERT_TRUE(d.run(10000, 10, [&] { return d.pub.depth() == 0; }));
+  TEST_ASSERT_EQUAL_UINT32(2 * MQTT_BATCH, d.pub.sent);
+  d.client.end();
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_batches_in_order);
+  RUN_TEST(test_outage_store_and_forward);
+  RUN_TEST(test_full_queue_drops_oldest);
+  RUN_TEST(test_real_broker);
+  return UNITY_END();
+}
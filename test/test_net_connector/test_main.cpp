@@ -0,0 +1,113 @@
+// Фоновое подключение к Wi-Fi: pio test -e native
+#include <unity.h>
+
+#include <stdio.h>
+
+#include "NetConnector.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// Прогон автомата с шагом цикла веб-задачи; link(t) — доступна ли сеть
+// (связь появляется только во время попытки подключения)
+template <typename Link>
+static uint32_t run(NetConnector &net, uint32_t from, uint32_t to, Link link,
+                    int *actions) {
+  uint32_t onlineAt = 0;
+  for (uint32_t t = from; t < to; t += 250) {
+    NetAction a = net.poll(t, link(t) && net.state() != NET_OFF);
+    actions[a]++;
+    if (a == NET_CONNECTED && !onlineAt)
+      onlineAt = t;
+  }
+  return onlineAt;
+}
+
+void test_connects_in_background(void) {
+  NetConnector net;
+  net.begin(0, true);
+  int actions[5] = {0};
+  // Роутер отвечает через 3 с после первой попытки
+  uint32_t online =
+      run(net, 0, 20000, [](uint32_t t) { return t >= 3000; }, actions);
+  TEST_ASSERT_EQUAL(3000, online);
+  TEST_ASSERT_EQUAL(1, actions[NET_BEGIN]);
+  TEST_ASSERT_EQUAL(1, actions[NET_CONNECTED]);
+  TEST_ASSERT_EQUAL(0, actions[NET_START_AP]);
+  TEST_ASSERT_EQUAL(NET_ONLINE, net.state());
+}
+
+void test_backoff_then_ap_fallback_keeps_trying(void) {
+  NetConnector net;
+  net.begin(0, true);
+  int actions[5] = {0};
+  const uint32_t routerUp = 10 * 60 * 1000; // роутер включили через 10 мин
+  uint32_t online = run(net, 0, routerUp + 120000,
+                        [&](uint32_t t) { return t >= routerUp; }, actions);
+
+  // Точка доступа — один раз, после NET_AP_AFTER_FAILS неудач
+  TEST_ASSERT_EQUAL(1, actions[NET_START_AP]);
+  TEST_ASSERT_EQUAL(1, actions[NET_STOP_AP]);
+  TEST_ASSERT_FALSE(net.apActive());
+  // Пауза растёт до предела: попыток за 10 мин немного, но подключились
+  // не позже чем через паузу + таймаут после появления сети
+  char msg[96];
+  snprintf(msg, sizeof(msg), "%u attempts in 10 min, online %u ms after "
+           "the router came up",
+           (unsigned)net.attempts, (unsigned)(online - routerUp));
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_TRUE(net.attempts < 20);
+  TEST_ASSERT_TRUE(online >= routerUp &&
+                   online - routerUp <=
+                       NET_BACKOFF_MAX_MS + NET_CONNECT_TIMEOUT_MS);
+}
+
+void test_no_credentials_starts_ap_only(void) {
+  NetConnector net;
+  net.begin(0, false);
+  int actions[5] = {0};
+  run(net, 0, 60000, [](uint32_t) { return false; }, actions);
+  TEST_ASSERT_EQUAL(1, actions[NET_START_AP]);
+  TEST_ASSERT_EQUAL(0, actions[NET_BEGIN]);
+  TEST_ASSERT_TRUE(net.apActive());
+}
+
+void test_reconnects_after_drop(void) {
+  NetConnector net;
+  net.begin(0, true);
+  int actions[5] = {0};
+  // Связь есть, пропадает на 40-й секунде на 5 с
+  run(net, 0, 60000,
+      [](uint32_t t) { return t >= 1000 && (t < 40000 || t >= 45000); },
+      actions);
+  TEST_ASSERT_EQUAL(1, net.drops);
+  TEST_ASSERT_EQUAL(2, actions[NET_CONNECTED]);
+  TEST_ASSERT_EQUAL(2, actions[NET_BEGIN]);
+  TEST_ASSERT_EQUAL(0, actions[NET_START_AP]);
+}
+
+void test_new_credentials_leave_ap_after_connect(void) {
+  NetConnector net;
+  net.begin(0, false);
+  int actions[5] = {0};
+  run(net, 0, 5000, [](uint32_t) { return false; }, actions);
+  TEST_ASSERT_TRUE(net.apActive());
+
+  // SSID введён через страницу точки доступа — без перезагрузки
+  net.begin(5000, true);
+  run(net, 5000, 20000, [](uint32_t t) { return t >= 7000; }, actions);
+  TEST_ASSERT_EQUAL(1, actions[NET_START_AP]);
+  TEST_ASSERT_EQUAL(1, actions[NET_CONNECTED]);
+  TEST_ASSERT_EQUAL(1, actions[NET_STOP_AP]);
+  TEST_ASSERT_FALSE(net.apActive());
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_connects_in_background);
+  RUN_TEST(test_backoff_then_ap_fallback_keeps_trying);
+  RUN_TEST(test_no_credentials_starts_ap_only);
+  RUN_TEST(test_reconnects_after_drop);
+  RUN_TEST(test_new_credentials_leave_ap_after_connect);
+  return UNITY_END();
+}
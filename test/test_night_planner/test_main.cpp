@@ -0,0 +1,144 @@
+// Ночной сон: поиск восхода, расписание пробуждений, бюджет энергии:
+// pio test -e native
+#include <unity.h>
+
+#include <stdio.h>
+
+#include "FakeHal.h"
+#include "NightPlanner.h"
+#include "TrackerCore.h"
+
+static const time_t SUMMER_NIGHT = 1782068400; // 2026-06-21 19:00 UTC
+static const time_t YEAR_START = 1767225600;   // 2026-01-01 00:00 UTC
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_sunrise_to_the_second(void) {
+  Config cfg = defaultConfig();
+  NoaaSun sun;
+  time_t rise = nextSunrise(sun, cfg, SUMMER_NIGHT);
+  TEST_ASSERT_TRUE(rise > SUMMER_NIGHT && rise < SUMMER_NIGHT + 86400);
+  double az, alt;
+  noaaSunPosition(cfg.lat, cfg.lon, rise - 1, az, alt);
+  TEST_ASSERT_TRUE(alt <= 0);
+  noaaSunPosition(cfg.lat, cfg.lon, rise, az, alt);
+  TEST_ASSERT_TRUE(alt > 0);
+  TEST_ASSERT_TRUE(sun.calls < 200);
+
+  // Днём — "уже взошло"; полярная ночь — восхода нет
+  TEST_ASSERT_EQUAL(SUMMER_NIGHT - 12 * 3600,
+                    nextSunrise(sun, cfg, SUMMER_NIGHT - 12 * 3600));
+  cfg.lat = 78.2; // Шпицберген, декабрь
+  cfg.lon = 15.6;
+  TEST_ASSERT_EQUAL(0, nextSunrise(sun, cfg, YEAR_START - 10 * 86400));
+}
+
+void test_sleep_chunks(void) {
+  const time_t now = SUMMER_NIGHT;
+  const uint32_t full = NIGHT_MAX_SLEEP_S * (100 - NIGHT_RTC_DRIFT_PCT) / 100;
+  TEST_ASSERT_EQUAL(full, nightSleepSeconds(now, now + 6 * 3600));
+  TEST_ASSERT_EQUAL(full, nightSleepSeconds(now, 0)); // полярная ночь
+  uint32_t last = nightSleepSeconds(now, now + 3600);
+  TEST_ASSERT_TRUE(last > 0 && now + last < now + 3600 - NIGHT_WAKE_LEAD_S);
+  // До восхода меньше запаса — не засыпаем
+  TEST_ASSERT_EQUAL(0, nightSleepSeconds(now, now + NIGHT_WAKE_LEAD_S +
+                                                  NIGHT_MIN_SLEEP_S - 1));
+  TEST_ASSERT_EQUAL(0, nightSleepSeconds(now, now - 10));
+}
+
+// Ток модуля ESP32-WROOM (без LDO и светодиода платы), мА, и время
+// активной работы на одно пробуждение (Wi-Fi, NTP), с
+struct PowerProfile {
+  float awakeMa; // оба ядра, Wi-Fi в modem sleep
+  float sleepMa;
+  float wakeS;
+};
+
+static const PowerProfile AWAKE = {45.0f, 45.0f, 0};
+static const PowerProfile LIGHT = {45.0f, 0.8f, 2.0f};
+static const PowerProfile DEEP = {45.0f, 0.01f, 5.0f};
+
+struct NightRun {
+  double nightH;  // длительность ночей
+  long wakes;     // пробуждений по RTC
+  double awakeH;  // без сна
+  double mAh;
+  long late;      // худшее опоздание к восходу, с
+};
+
+// Год ночей: трекер в авто-режиме, сон по nightSleepSeconds(), RTC уходит
+// попеременно на ±NIGHT_RTC_DRIFT_PCT
+static NightRun runYear(const PowerProfile &p, bool sleep) {
+  Config cfg = defaultConfig();
+  FakeClock clk;
+  FakeAdc adc;
+  FakeServos servos;
+  NoaaSun sun;
+  NightRun r = {0, 0, 0, 0, 0};
+  for (int day = 0; day < 365; ++day) {
+    clk.set(YEAR_START + day * 86400 + 9 * 3600); // ~14:00 местного
+    TrackerCore core(cfg, clk, adc, servos, sun);
+    while (core.cycle(), !core.isNight)
+      clk.advance(core.cycleDelayMs() / 1000);
+    time_t sunset = clk.now(), rise = core.sunrise;
+    int drift = (int)NIGHT_RTC_DRIFT_PCT * (day % 2 ? 1 : -1);
+
+    double awakeS = 0, sleptS = 0;
+    while (core.isNight) {
+      uint32_t s = sleep ? nightSleepSeconds(clk.now(), core.sunrise) : 0;
+      if (s) {
+        uint32_t real = s * (100 + drift) / 100;
+        clk.advance(real);
+        sleptS += real;
+        awakeS += p.wakeS;
+        clk.advance(p.wakeS);
+        ++r.wakes;
+      } else {
+        uint32_t d = core.cycleDelayMs() / 1000;
+        clk.advance(d);
+        awakeS += d;
+      }
+      core.cycle();
+    }
+    if (clk.now() - rise > r.late)
+      r.late = clk.now() - rise;
+    r.nightH += (rise - sunset) / 3600.0;
+    r.awakeH += awakeS / 3600.0;
+    r.mAh += (awakeS * p.awakeMa + sleptS * p.sleepMa) / 3600.0;
+  }
+  return r;
+}
+
+void test_year_of_nights_energy_budget(void) {
+  NightRun off = runYear(AWAKE, false);
+  NightRun light = runYear(LIGHT, true);
+  NightRun deep = runYear(DEEP, true);
+  const NightRun *runs[] = {&off, &light, &deep};
+  const char *names[] = {"awake", "light sleep", "deep sleep"};
+  char msg[160];
+  snprintf(msg, sizeof(msg), "nights: %.1f h average", off.nightH / 365);
+  TEST_MESSAGE(msg);
+  for (int i = 0; i < 3; ++i) {
+    snprintf(msg, sizeof(msg),
+             "%-11s: %.1f wakeups/night, awake %.2f h/night, "
+             "%.1f mAh/night, 10 Ah = %.0f nights, late <= %ld s",
+             names[i], runs[i]->wakes / 365.0, runs[i]->awakeH / 365,
+             runs[i]->mAh / 365, 10000.0 / (runs[i]->mAh / 365),
+             runs[i]->late);
+    TEST_MESSAGE(msg);
+  }
+  // Сон не опаздывает к восходу сильнее, чем бодрствующий трекер
+  TEST_ASSERT_TRUE(light.late <= off.late + 1);
+  TEST_ASSERT_TRUE(deep.late <= off.late + 1);
+  TEST_ASSERT_TRUE(light.mAh * 10 < off.mAh);
+  TEST_ASSERT_TRUE(deep.mAh < light.mAh);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_sunrise_to_the_second);
+  RUN_TEST(test_sleep_chunks);
+  RUN_TEST(test_year_of_nights_energy_budget);
+  return UNITY_END();
+}
@@ -0,0 +1,336 @@
+// OTA: потоковая запись образа в раздел-файл, подпись, откат: pio test -e
+// native
+#include <unity.h>
+
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <netinet/in.h>
+#include <random>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "FakeHal.h"
+#include "HttpServer.h"
+#include "OtaUpdater.h"
+#include "Sha256.h"
+
+using Clock = std::chrono::steady_clock;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static const uint8_t KEY[] = "tracker-ota-key";
+static const size_t KEY_LEN = sizeof(KEY) - 1;
+static const size_t PART_SIZE = 1536 * 1024; // как app-раздел min_spiffs
+
+static double msSince(Clock::time_point t0) {
+  return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+// Образ приложения: магический байт и псевдослучайное содержимое
+static std::vector<uint8_t> makeImage(size_t n, unsigned seed = 1) {
+  std::vector<uint8_t> img(n);
+  std::mt19937 rnd(seed);
+  for (uint8_t &b : img)
+    b = (uint8_t)rnd();
+  img[0] = OTA_IMAGE_MAGIC;
+  return img;
+}
+
+// Заголовки, как у tools/ota_upload.py
+struct Signed {
+  char sha[65];
+  char sig[65];
+};
+
+static Signed sign(const std::vector<uint8_t> &img, const uint8_t *key,
+                   size_t keyLen) {
+  Signed s;
+  uint8_t d[SHA256_SIZE], mac[SHA256_SIZE];
+  Sha256 h;
+  h.update(img.data(), img.size());
+  h.finish(d);
+  hmacSha256(key, keyLen, d, SHA256_SIZE, mac);
+  sha256ToHex(d, s.sha);
+  sha256ToHex(mac, s.sig);
+  return s;
+}
+
+static bool partitionHolds(FileOtaPartition &p,
+                           const std::vector<uint8_t> &img) {
+  std::vector<uint8_t> got(img.size());
+  return p.read(0, got.data(), got.size()) && got == img;
+}
+
+void test_sha256_and_hmac_vectors(void) {
+  char hex[65];
+  uint8_t d[SHA256_SIZE];
+  Sha256 h;
+  h.finish(d);
+  sha256ToHex(d, hex);
+  TEST_ASSERT_EQUAL_STRING(
+      "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", hex);
+  // Тот же результат при подаче по байту
+  for (const char *p = "abc"; *p; ++p)
+    h.update(p, 1);
+  h.finish(d);
+  sha256ToHex(d, hex);
+  TEST_ASSERT_EQUAL_STRING(
+      "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad", hex);
+
+  // RFC 4231, тест 2
+  const char *msg = "what do ya want for nothing?";
+  hmacSha256((const uint8_t *)"Jefe", 4, msg, strlen(msg), d);
+  sha256ToHex(d, hex);
+  TEST_ASSERT_EQUAL_STRING(
+      "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843", hex);
+
+  uint8_t back[SHA256_SIZE];
+  TEST_ASSERT_TRUE(sha256FromHex(hex, back));
+  TEST_ASSERT_EQUAL_MEMORY(d, back, SHA256_SIZE);
+  TEST_ASSERT_FALSE(sha256FromHex("5bdc", back));
+  hex[3] = 'g';
+  TEST_ASSERT_FALSE(sha256FromHex(hex, back));
+}
+
+// Куски произвольного размера (как их режет TCP) — на flash ровно образ,
+// стирание по сектору на каждые 4 КБ
+void test_streams_image_in_sectors(void) {
+  FileOtaPartition part(PART_SIZE);
+  OtaUpdater ota(part, KEY, KEY_LEN);
+  std::vector<uint8_t> img = makeImage(1000003);
+  Signed s = sign(img, KEY, KEY_LEN);
+
+  std::mt19937 rnd(7);
+  auto t0 = Clock::now();
+  TEST_ASSERT_EQUAL(OTA_OK, ota.begin(img.size(), s.sha, s.sig));
+  for (size_t off = 0; off < img.size();) {
+    size_t n = std::min<size_t>(1 + rnd() % 3000, img.size() - off);
+    TEST_ASSERT_EQUAL(OTA_OK, ota.write(img.data() + off, n));
+    off += n;
+  }
+  TEST_ASSERT_EQUAL(OTA_OK, ota.finish());
+  double ms = msSince(t0);
+  printf("[ota] %zu bytes into file partition: %.1f ms, %.1f MB/s, "
+         "%ld sectors erased\n",
+         img.size(), ms, img.size() / 1e3 / ms, part.erases);
+
+  size_t sectors = (img.size() + OTA_SECTOR - 1) / OTA_SECTOR;
+  TEST_ASSERT_EQUAL(sectors, part.erases);
+  TEST_ASSERT_EQUAL(sectors, ota.sectors);
+  TEST_ASSERT_EQUAL(img.size(), part.written);
+  TEST_ASSERT_EQUAL(1, part.activations);
+  TEST_ASSERT_EQUAL(1, ota.updates);
+  TEST_ASSERT_FALSE(ota.active());
+  TEST_ASSERT_TRUE(partitionHolds(part, img));
+}
+
+// Подпись и заголовки проверяются до первого стирания
+void test_rejects_before_touching_flash(void) {
+  FileOtaPartition part(PART_SIZE);
+  OtaUpdater ota(part, KEY, KEY_LEN);
+  std::vector<uint8_t> img = makeImage(10000);
+  Signed good = sign(img, KEY, KEY_LEN);
+  Signed foreign = sign(img, (const uint8_t *)"other", 5);
+
+  TEST_ASSERT_EQUAL(OTA_UNAUTHORIZED,
+                    ota.begin(img.size(), good.sha, foreign.sig));
+  TEST_ASSERT_EQUAL(OTA_BAD_REQUEST, ota.begin(img.size(), good.sha, ""));
+  TEST_ASSERT_EQUAL(OTA_BAD_REQUEST, ota.begin(0, good.sha, good.sig));
+  TEST_ASSERT_EQUAL(OTA_TOO_LARGE,
+                    ota.begin(PART_SIZE + 1, good.sha, good.sig));
+  OtaUpdater disabled(part, KEY, 0);
+  TEST_ASSERT_EQUAL(OTA_UNAUTHORIZED,
+                    disabled.begin(img.size(), good.sha, good.sig));
+  TEST_ASSERT_EQUAL(0, part.erases);
+
+  // Не образ приложения — отказ на первом куске, тоже без стирания
+  img[0] = 'P';
+  Signed notApp = sign(img, KEY, KEY_LEN);
+  TEST_ASSERT_EQUAL(OTA_OK, ota.begin(img.size(), notApp.sha, notApp.sig));
+  TEST_ASSERT_EQUAL(OTA_BUSY, ota.begin(img.size(), notApp.sha, notApp.sig));
+  TEST_ASSERT_EQUAL(OTA_BAD_IMAGE, ota.write(img.data(), img.size()));
+  TEST_ASSERT_FALSE(ota.active());
+  TEST_ASSERT_EQUAL(0, part.erases);
+  TEST_ASSERT_EQUAL(0, part.activations);
+}
+
+// Подписан правильно, но на flash не то (или не всё) — не активируется
+void test_bad_write_is_not_activated(void) {
+  FileOtaPartition part(PART_SIZE);
+  OtaUpdater ota(part, KEY, KEY_LEN);
+  std::vector<uint8_t> img = makeImage(50000);
+  Signed s = sign(img, KEY, KEY_LEN);
+
+  TEST_ASSERT_EQUAL(OTA_OK, ota.begin(img.size(), s.sha, s.sig));
+  TEST_ASSERT_EQUAL(OTA_OK, ota.write(img.data(), 20000));
+  part.corrupt(12345);
+  TEST_ASSERT_EQUAL(OTA_OK, ota.write(img.data() + 20000, 30000));
+  TEST_ASSERT_EQUAL(OTA_CHECKSUM, ota.finish());
+
+  TEST_ASSERT_EQUAL(OTA_OK, ota.begin(img.size(), s.sha, s.sig));
+  TEST_ASSERT_EQUAL(OTA_OK, ota.write(img.data(), 40000));
+  TEST_ASSERT_EQUAL(OTA_INCOMPLETE, ota.finish());
+
+  TEST_ASSERT_EQUAL(OTA_OK, ota.begin(img.size(), s.sha, s.sig));
+  part.failWrites = true;
+  TEST_ASSERT_EQUAL(OTA_FLASH_ERROR, ota.write(img.data(), 5000));
+  part.failWrites = false;
+
+  TEST_ASSERT_EQUAL(OTA_OK, ota.begin(img.size(), s.sha, s.sig));
+  TEST_ASSERT_EQUAL(OTA_OK, ota.write(img.data(), 100));
+  ota.abort();
+  TEST_ASSERT_FALSE(ota.active());
+  TEST_ASSERT_EQUAL(0, part.activations);
+  TEST_ASSERT_EQUAL(0, ota.updates);
+
+  // После всех сбоев следующая загрузка проходит
+  TEST_ASSERT_EQUAL(OTA_OK, ota.begin(img.size(), s.sha, s.sig));
+  TEST_ASSERT_EQUAL(OTA_OK, ota.write(img.data(), img.size()));
+  TEST_ASSERT_EQUAL(OTA_OK, ota.finish());
+  TEST_ASSERT_EQUAL(1, part.activations);
+  TEST_ASSERT_TRUE(partitionHolds(part, img));
+}
+
+// ---------- Через HttpServer, как POST /api/ota ----------
+static int connectLoopback(uint16_t port) {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in a{};
+  a.sin_family = AF_INET;
+  a.sin_port = htons(port);
+  a.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  timeval tv = {2, 0};
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+  if (connect(fd, (sockaddr *)&a, sizeof(a))) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+// Отправить образ, вернуть статус; ответ — в reply
+static int upload(uint16_t port, const std::vector<uint8_t> &img,
+                  const Signed &s, char *reply, size_t cap) {
+  int fd = connectLoopback(port);
+  if (fd < 0)
+    return -1;
+  char head[320];
+  int n = snprintf(head, sizeof(head),
+                   "POST /api/ota HTTP/1.1\r\nContent-Length: %zu\r\n"
+                   "X-Firmware-SHA256: %s\r\nX-Firmware-Signature: %s"
+                   "\r\n\r\n",
+                   img.size(), s.sha, s.sig);
+  send(fd, head, n, MSG_NOSIGNAL);
+  for (size_t off = 0; off < img.size();) {
+    ssize_t k = send(fd, img.data() + off,
+                     std::min<size_t>(16384, img.size() - off), MSG_NOSIGNAL);
+    if (k <= 0)
+      break; // отказ: сервер закрыл соединение
+    off += k;
+  }
+  // Ответ целиком: заголовки и Content-Length байт тела (keep-alive)
+  size_t len = 0;
+  for (ssize_t k; len + 1 < cap &&
+                  (k = recv(fd, reply + len, cap - 1 - len, 0)) > 0;) {
+    len += k;
+    reply[len] = 0;
+    const char *end = strstr(reply, "\r\n\r\n");
+    const char *cl = strcasestr(reply, "content-length:");
+    if (end && cl && end + 4 + atol(cl + 15) <= reply + len)
+      break;
+  }
+  reply[len] = 0;
+  close(fd);
+  return len > 9 ? atoi(reply + 9) : -1;
+}
+
+void test_http_upload_end_to_end(void) {
+  FileOtaPartition part(PART_SIZE);
+  OtaUpdater ota(part, KEY, KEY_LEN);
+  OtaUploadHandler handler(ota);
+  HttpServerConfig cfg = DEFAULT_HTTP_SERVER;
+  cfg.port = 0;
+  HttpServer srv(cfg);
+  srv.onUpload("/api/ota", handler);
+  TEST_ASSERT_TRUE(srv.begin());
+  std::atomic<bool> stop{false};
+  std::thread th([&] {
+    while (!stop)
+      srv.loop(5);
+  });
+
+  std::vector<uint8_t> img = makeImage(1200000, 3);
+  Signed s = sign(img, KEY, KEY_LEN);
+  char reply[512];
+
+  Signed forged = s;
+  forged.sig[0] = forged.sig[0] == '0' ? '1' : '0';
+  TEST_ASSERT_EQUAL(401, upload(srv.port(), img, forged, reply, sizeof(reply)));
+  TEST_ASSERT_NOT_NULL(strstr(reply, "\"status\":\"unauthorized\""));
+  TEST_ASSERT_EQUAL(0, part.erases);
+
+  auto t0 = Clock::now();
+  TEST_ASSERT_EQUAL(200, upload(srv.port(), img, s, reply, sizeof(reply)));
+  double ms = msSince(t0);
+  printf("[ota] %zu bytes over HTTP loopback: %.1f ms, %.1f MB/s\n",
+         img.size(), ms, img.size() / 1e3 / ms);
+  TEST_ASSERT_NOT_NULL(strstr(reply, "\"ok\":true"));
+  TEST_ASSERT_TRUE(handler.done);
+  TEST_ASSERT_EQUAL(1, part.activations);
+  TEST_ASSERT_TRUE(partitionHolds(part, img));
+
+  stop = true;
+  th.join();
+}
+
+// Новая прошивка, не подтвердившая работу за OTA_TRIAL_BOOTS запусков,
+// откатывается; подтверждённая остаётся
+void test_boot_guard_rolls_back(void) {
+  FakeKeyValue kv;
+  {
+    OtaBootGuard g(kv);
+    TEST_ASSERT_EQUAL(OTA_BOOT_NORMAL, g.boot());
+    g.armed();
+  }
+  for (int i = 1; i <= OTA_TRIAL_BOOTS; ++i) {
+    OtaBootGuard g(kv); // каждый запуск — с чистой RAM
+    TEST_ASSERT_EQUAL(OTA_BOOT_TRIAL, g.boot());
+    TEST_ASSERT_EQUAL(i, g.attempts());
+  }
+  {
+    OtaBootGuard g(kv);
+    TEST_ASSERT_EQUAL(OTA_BOOT_ROLLBACK, g.boot());
+    TEST_ASSERT_FALSE(g.pending());
+  }
+  {
+    OtaBootGuard g(kv); // прежняя прошивка грузится как обычно
+    TEST_ASSERT_EQUAL(OTA_BOOT_NORMAL, g.boot());
+    g.armed();
+  }
+  {
+    OtaBootGuard g(kv);
+    TEST_ASSERT_EQUAL(OTA_BOOT_TRIAL, g.boot());
+    g.confirm();
+    long puts = kv.puts;
+    g.confirm(); // повторно NVS не трогает
+    TEST_ASSERT_EQUAL(puts, kv.puts);
+  }
+  OtaBootGuard g(kv);
+  TEST_ASSERT_EQUAL(OTA_BOOT_NORMAL, g.boot());
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_sha256_and_hmac_vectors);
+  RUN_TEST(test_streams_image_in_sectors);
+  RUN_TEST(test_rejects_before_touching_flash);
+  RUN_TEST(test_bad_write_is_not_activated);
+  RUN_TEST(test_http_upload_end_to_end);
+  RUN_TEST(test_boot_guard_rolls_back);
+  return UNITY_END();
+}
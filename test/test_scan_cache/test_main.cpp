@@ -0,0 +1,104 @@
+// Кэш фонового сканирования Wi-Fi: pio test -e native
+#include <unity.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ScanCache.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_dedup_sort_and_hidden(void) {
+  ScanCache c;
+  c.clear();
+  c.add("Home", -70, 1, false);
+  c.add("Office", -50, 6, false);
+  c.add("", -30, 11, true); // скрытая
+  c.add("Home", -40, 6, false); // вторая точка mesh — сильнее
+  c.add("Office", -80, 1, false);
+  c.add("Cafe", -60, 11, true);
+  c.done(0);
+
+  TEST_ASSERT_EQUAL(3, c.size());
+  TEST_ASSERT_EQUAL_STRING("Home", c[0].ssid);
+  TEST_ASSERT_EQUAL(-40, c[0].rssi);
+  TEST_ASSERT_EQUAL(6, c[0].channel);
+  TEST_ASSERT_EQUAL_STRING("Office", c[1].ssid);
+  TEST_ASSERT_EQUAL_STRING("Cafe", c[2].ssid);
+  TEST_ASSERT_TRUE(c[2].open);
+}
+
+void test_capacity_keeps_strongest(void) {
+  const int N = SCAN_MAX_NETWORKS + 10;
+  ScanCache c;
+  c.clear();
+  char name[16];
+  for (int i = 0; i < N; ++i) {
+    snprintf(name, sizeof(name), "net%d", i);
+    c.add(name, -95 + (i * 7) % N, 1, false); // все разные, вперемешку
+  }
+  TEST_ASSERT_EQUAL(SCAN_MAX_NETWORKS, c.size());
+  // Остались ровно SCAN_MAX_NETWORKS сильнейших, по убыванию
+  for (int i = 0; i < c.size(); ++i)
+    TEST_ASSERT_EQUAL(-95 + N - 1 - i, c[i].rssi);
+}
+
+void test_ttl_and_states(void) {
+  ScanCache c(30000);
+  TEST_ASSERT_EQUAL(SCAN_IDLE, c.state());
+  TEST_ASSERT_TRUE(c.needsScan(0));
+
+  c.started(0);
+  TEST_ASSERT_EQUAL(SCAN_RUNNING, c.state());
+  TEST_ASSERT_FALSE(c.needsScan(100, true)); // второй не запускаем
+  TEST_ASSERT_TRUE(c.needsScan(SCAN_TIMEOUT_MS)); // кроме зависшего
+
+  c.failed(3000);
+  TEST_ASSERT_EQUAL(SCAN_FAILED, c.state());
+  TEST_ASSERT_TRUE(c.needsScan(3100));
+
+  c.started(3100);
+  c.clear();
+  c.add("Home", -50, 1, false);
+  c.done(6000);
+  TEST_ASSERT_EQUAL(SCAN_READY, c.state());
+  TEST_ASSERT_FALSE(c.needsScan(20000));
+  TEST_ASSERT_TRUE(c.needsScan(20000, true));
+  TEST_ASSERT_TRUE(c.needsScan(36000));
+
+  // Неудача после успешного сканирования не теряет прошлый результат
+  c.started(36000);
+  c.failed(39000);
+  TEST_ASSERT_EQUAL(SCAN_READY, c.state());
+  TEST_ASSERT_EQUAL(1, c.size());
+}
+
+void test_json(void) {
+  ScanCache c;
+  char buf[256];
+  JsonWriter w(buf, sizeof(buf));
+  c.write(w, 0);
+  TEST_ASSERT_EQUAL_STRING("{\"state\":\"idle\",\"age\":-1,\"networks\":[]}",
+                           w.c_str());
+
+  c.started(0);
+  c.add("A\"B", -48, 3, true);
+  c.done(1000);
+  c.started(20000);
+  JsonWriter w2(buf, sizeof(buf));
+  c.write(w2, 13500);
+  TEST_ASSERT_EQUAL_STRING(
+      "{\"state\":\"running\",\"age\":12,\"networks\":"
+      "[{\"ssid\":\"A\\\"B\",\"rssi\":-48,\"ch\":3,\"open\":true}]}",
+      w2.c_str());
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_dedup_sort_and_hidden);
+  RUN_TEST(test_capacity_keeps_strongest);
+  RUN_TEST(test_ttl_and_states);
+  RUN_TEST(test_json);
+  return UNITY_END();
+}
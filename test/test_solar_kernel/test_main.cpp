@@ -0,0 +1,88 @@
+// Точность и скорость float-расчёта Солнца: pio test -e native
+#include <unity.h>
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+
+#include "FakeHal.h"
+#include "SolarEphemeris.h"
+#include "SolarKernel.h"
+
+static const time_t YEAR_START = 1767225600; // 2026-01-01 00:00 UTC
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_fast_trig(void) {
+  float worst = 0;
+  for (float d = -720; d <= 720; d += 0.37f) {
+    worst = fmaxf(worst, fabsf(fastSin(d) - (float)sin(d * M_PI / 180)));
+    worst = fmaxf(worst, fabsf(fastCos(d) - (float)cos(d * M_PI / 180)));
+  }
+  TEST_ASSERT_LESS_THAN(3e-5f, worst);
+
+  for (float x = -1; x <= 1; x += 0.001f)
+    TEST_ASSERT_FLOAT_WITHIN(0.005, asin(x) * 180 / M_PI, fastAsin(x));
+  TEST_ASSERT_FLOAT_WITHIN(0.001, 135.0, fastAtan2(1, -1));
+  TEST_ASSERT_FLOAT_WITHIN(0.001, -45.0, fastAtan2(-1, 1));
+  TEST_ASSERT_FLOAT_WITHIN(0.001, 90.0, fastAtan2(3, 0));
+}
+
+// Год с шагом 5 минут при cfg.lat/cfg.lon по умолчанию
+void test_year_sweep_error(void) {
+  Config cfg = defaultConfig();
+  float worst = 0;
+  long samples = 0;
+  for (time_t t = YEAR_START; t < YEAR_START + 365 * 86400L; t += 300) {
+    double refAz, refAlt;
+    noaaSunPosition(cfg.lat, cfg.lon, t, refAz, refAlt);
+    if (refAlt <= 0)
+      continue;
+    float az, alt;
+    solarPosition(cfg.lat, cfg.lon, t, az, alt);
+    worst = fmaxf(worst, pointingError(az, alt, refAz, refAlt));
+    samples++;
+  }
+  char msg[96];
+  snprintf(msg, sizeof(msg), "year sweep: %ld daylight samples, max error %.4f deg",
+           samples, worst);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_LESS_THAN(0.05f, worst);
+}
+
+void test_bench_speedup(void) {
+  Config cfg = defaultConfig();
+  const int N = 500000;
+  volatile float sink = 0;
+
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < N; i++) {
+    double az, alt;
+    noaaSunPosition(cfg.lat, cfg.lon, YEAR_START + i * 60L, az, alt);
+    sink = sink + (float)(az + alt);
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  for (int i = 0; i < N; i++) {
+    float az, alt;
+    solarPosition(cfg.lat, cfg.lon, YEAR_START + i * 60L, az, alt);
+    sink = sink + az + alt;
+  }
+  auto t2 = std::chrono::steady_clock::now();
+
+  double refNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / N;
+  double fastNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / N;
+  char msg[96];
+  snprintf(msg, sizeof(msg), "double NOAA %.1f ns, float kernel %.1f ns (x%.2f)",
+           refNs, fastNs, refNs / fastNs);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_GREATER_THAN(0, fastNs);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_fast_trig);
+  RUN_TEST(test_year_sweep_error);
+  RUN_TEST(test_bench_speedup);
+  return UNITY_END();
+}
@@ -0,0 +1,97 @@
+// Дельты телеметрии для push-канала: pio test -e native
+#include <unity.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include "StatusFrame.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static TrackerSnapshot snapshot(float volts, float az, float alt) {
+  TrackerSnapshot s = {};
+  s.panelVolts = volts;
+  s.sunAz = az;
+  s.sunAlt = alt;
+  s.mode = MODE_AUTO;
+  return s;
+}
+
+void test_full_frame(void) {
+  StatusFrame f = makeStatusFrame(snapshot(5.257f, 181.44f, 42.06f), 91, 42,
+                                  false, 12 * 3600 + 34 * 60 + 56);
+  char buf[256];
+  JsonWriter w(buf, sizeof(buf));
+  TEST_ASSERT_TRUE(writeStatusDelta(w, nullptr, f));
+  TEST_ASSERT_EQUAL_STRING(
+      "{\"time\":\"12:34:56\",\"volts\":5.26,\"sunAz\":181.4,\"sunAlt\":42.1,"
+      "\"curHor\":91,\"curVer\":42,\"mode\":0,\"isNight\":false,"
+      "\"isAP\":false}",
+      w.c_str());
+}
+
+// Шум ниже точности экрана и ход часов не порождают сообщений
+void test_noise_and_clock_are_dropped(void) {
+  StatusFrame a = makeStatusFrame(snapshot(5.251f, 181.44f, 42.06f), 91, 42,
+                                  false, 100);
+  StatusFrame b = makeStatusFrame(snapshot(5.254f, 181.41f, 42.08f), 91, 42,
+                                  false, 107);
+  char buf[64];
+  JsonWriter w(buf, sizeof(buf));
+  TEST_ASSERT_FALSE(writeStatusDelta(w, &a, b));
+  TEST_ASSERT_EQUAL(0, w.length());
+}
+
+void test_delta_contains_only_changes(void) {
+  StatusFrame a = makeStatusFrame(snapshot(5.25f, 181.4f, 42.1f), 91, 42,
+                                  false, 100);
+  StatusFrame b = a;
+  b.curHor = 92;
+  b.timeSec = 101;
+  char buf[64];
+  JsonWriter w(buf, sizeof(buf));
+  TEST_ASSERT_TRUE(writeStatusDelta(w, &a, b));
+  TEST_ASSERT_EQUAL_STRING("{\"time\":\"00:01:41\",\"curHor\":92}", w.c_str());
+}
+
+// Сутки трекинга с опросом раз в 250 мс: сколько байт уходит клиенту
+void test_bytes_push_vs_poll(void) {
+  long pushBytes = 0, pushMsgs = 0;
+  StatusFrame prev = {};
+  bool have = false;
+  char buf[256];
+  for (long t = 0; t < 86400L * 4; t++) {
+    long sec = t / 4;
+    float volts = sec > 20000 && sec < 70000 ? 5.0f + (sec % 600) / 600.0f : 0;
+    StatusFrame cur = makeStatusFrame(snapshot(volts, 90 + sec / 480.0f,
+                                               sec / 2000.0f),
+                                      sec / 480, 15 + sec / 4000, false, sec);
+    JsonWriter w(buf, sizeof(buf));
+    if (writeStatusDelta(w, have ? &prev : nullptr, cur)) {
+      pushBytes += w.length() + 8; // "data: " + "\n\n"
+      pushMsgs++;
+    }
+    prev = cur;
+    have = true;
+  }
+  // Опрос: полный /api/status (~330 байт с настройками) + ~150 байт
+  // заголовков каждые 2 с
+  long pollBytes = 86400L / 2 * (330 + 150);
+  char msg[128];
+  snprintf(msg, sizeof(msg),
+           "per day: push %ld msgs / %ld KB, poll %ld KB (x%.1f less)",
+           pushMsgs, pushBytes / 1024, pollBytes / 1024,
+           (double)pollBytes / pushBytes);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_LESS_THAN(pollBytes, pushBytes);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_full_frame);
+  RUN_TEST(test_noise_and_clock_are_dropped);
+  RUN_TEST(test_delta_contains_only_changes);
+  RUN_TEST(test_bytes_push_vs_poll);
+  return UNITY_END();
+}
@@ -0,0 +1,156 @@
+// Снимок телеметрии (seqlock) против мьютекса: pio test -e native
+#include <unity.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+#include "FakeHal.h"
+#include "SeqLock.h"
+#include "TrackerCore.h"
+
+using Clock = std::chrono::steady_clock;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+// Снимок, все поля которого выводятся из одного счётчика
+static TrackerSnapshot makeSnap(int i) {
+  TrackerSnapshot s = {};
+  s.panelVolts = i;
+  s.sunAz = i * 2;
+  s.sunAlt = i * 3;
+  s.currentHor = i;
+  s.currentVer = -i;
+  s.mode = i & 3;
+  s.isNight = i & 1;
+  return s;
+}
+
+static bool consistent(const TrackerSnapshot &s) {
+  int i = s.currentHor;
+  return s.panelVolts == i && s.sunAz == i * 2 && s.sunAlt == i * 3 &&
+         s.currentVer == -i && s.mode == (i & 3) && s.isNight == (bool)(i & 1);
+}
+
+void test_tracker_publishes_snapshot(void) {
+  Config cfg = defaultConfig();
+  FakeClock clk(1782026100);
+  FakeAdc adc(4095);
+  FakeServos servos;
+  NoaaSun sun;
+  TrackerCore core(cfg, clk, adc, servos, sun);
+  uint32_t v0 = core.telemetry.version();
+  core.cycle();
+  TrackerSnapshot s = core.telemetry.load();
+  TEST_ASSERT_EQUAL(v0 + 2, core.telemetry.version());
+  TEST_ASSERT_FLOAT_WITHIN(0.01, core.panelVolts, s.panelVolts);
+  TEST_ASSERT_FLOAT_WITHIN(0.001, core.sunAz, s.sunAz);
+  TEST_ASSERT_EQUAL_INT(angleToDeg(core.currentHor), s.currentHor);
+  TEST_ASSERT_EQUAL_INT(MODE_AUTO, s.mode);
+  TEST_ASSERT_FALSE(s.isNight);
+}
+
+struct Result {
+  double writerNs;   // средняя стоимость публикации
+  double writerMaxUs; // худшая публикация
+  double readerNs;   // среднее чтение
+  long reads;
+  long torn;
+};
+
+// Писатель публикует N снимков, READERS потоков непрерывно читают
+template <typename Publish, typename Read>
+static Result contend(int n, int readers, Publish publish, Read read) {
+  std::atomic<bool> stop{false};
+  std::atomic<long> reads{0}, torn{0};
+  std::atomic<long long> readNs{0};
+  std::vector<std::thread> pool;
+  for (int r = 0; r < readers; r++)
+    pool.emplace_back([&]() {
+      long local = 0, bad = 0;
+      auto t0 = Clock::now();
+      while (!stop.load(std::memory_order_relaxed)) {
+        if (!consistent(read()))
+          bad++;
+        local++;
+      }
+      auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    Clock::now() - t0)
+                    .count();
+      reads += local;
+      torn += bad;
+      readNs += ns;
+    });
+
+  double worst = 0;
+  auto t0 = Clock::now();
+  for (int i = 1; i <= n; i++) {
+    auto a = Clock::now();
+    publish(makeSnap(i));
+    double us = std::chrono::duration<double, std::micro>(Clock::now() - a)
+                    .count();
+    if (us > worst)
+      worst = us;
+  }
+  double total = std::chrono::duration<double, std::nano>(Clock::now() - t0)
+                     .count();
+  stop = true;
+  for (auto &t : pool)
+    t.join();
+
+  Result res;
+  res.writerNs = total / n;
+  res.writerMaxUs = worst;
+  res.reads = reads.load();
+  res.torn = torn.load();
+  res.readerNs = res.reads ? (double)readNs.load() / res.reads : 0;
+  return res;
+}
+
+void test_contention_seqlock_vs_mutex(void) {
+  const int N = 200000;
+  const int READERS = 2;
+
+  SeqLock<TrackerSnapshot> seq;
+  seq.store(makeSnap(0));
+  Result a = contend(
+      N, READERS, [&](const TrackerSnapshot &s) { seq.store(s); },
+      [&]() { return seq.load(); });
+
+  std::mutex mtx;
+  TrackerSnapshot shared = makeSnap(0);
+  Result b = contend(
+      N, READERS,
+      [&](const TrackerSnapshot &s) {
+        std::lock_guard<std::mutex> lock(mtx);
+        shared = s;
+      },
+      [&]() {
+        std::lock_guard<std::mutex> lock(mtx);
+        return shared;
+      });
+
+  char msg[160];
+  snprintf(msg, sizeof(msg),
+           "seqlock: write %.0f ns (max %.1f us), read %.0f ns, %ld reads",
+           a.writerNs, a.writerMaxUs, a.readerNs, a.reads);
+  TEST_MESSAGE(msg);
+  snprintf(msg, sizeof(msg),
+           "mutex:   write %.0f ns (max %.1f us), read %.0f ns, %ld reads",
+           b.writerNs, b.writerMaxUs, b.readerNs, b.reads);
+  TEST_MESSAGE(msg);
+
+  TEST_ASSERT_EQUAL(0, a.torn);
+  TEST_ASSERT_EQUAL(0, b.torn);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_tracker_publishes_snapshot);
+  RUN_TEST(test_contention_seqlock_vs_mutex);
+  return UNITY_END();
+}
@@ -0,0 +1,290 @@
+// Тесты и бенчмарк ядра трекера на хосте: pio test -e native
+#include <unity.h>
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FakeHal.h"
+#include "TrackerCore.h"
+
+static const time_t SUMMER_NOON = 1782026100; // 2026-06-21 07:15 UTC (Астана)
+static const time_t SUMMER_NIGHT = 1782068400; // 2026-06-21 19:00 UTC
+
+static Config cfg;
+static FakeClock clk;
+static FakeAdc adc;
+static FakeServos servos;
+static NoaaSun sun;
+
+void setUp(void) {
+  cfg = defaultConfig();
+  clk = FakeClock(SUMMER_NOON);
+  adc = FakeAdc();
+  servos = FakeServos();
+  sun = NoaaSun();
+}
+
+void tearDown(void) {}
+
+// Прогон задачи движения до остановки серво
+static int settle(TrackerCore &core) {
+  int steps = 0;
+  do {
+    core.motion.step(MOTION_PERIOD_MS);
+    steps++;
+  } while (core.motion.moving() && steps < 100000);
+  return steps;
+}
+
+void test_azimuth_mapping(void) {
+  TEST_ASSERT_EQUAL_INT(0, azimuthToHor(90, 0));
+  TEST_ASSERT_EQUAL_INT(9070, azimuthToHor(180.7f, 0));
+  TEST_ASSERT_EQUAL_INT(18000, azimuthToHor(270, 0));
+  TEST_ASSERT_EQUAL_INT(9500, azimuthToHor(180, 5));
+  TEST_ASSERT_EQUAL_INT(4290, altitudeToVer(40.9f, 2));
+  TEST_ASSERT_EQUAL_INT(-1234, altitudeToVer(-12.344f, 0));
+}
+
+void test_voltage_from_pipeline(void) {
+  TrackerCore core(cfg, clk, adc, servos, sun);
+  adc.raw = 4095;
+  core.measureVoltage();
+  TEST_ASSERT_EQUAL(1, adc.reads);
+  TEST_ASSERT_FLOAT_WITHIN(0.01, 3.3 * (15100.0 / 5100.0), core.panelVolts);
+  TEST_ASSERT_EQUAL(0, clk.delayed); // без ожидания АЦП
+}
+
+void test_auto_tracks_sun(void) {
+  TrackerCore core(cfg, clk, adc, servos, sun);
+  core.cycle();
+  settle(core);
+  TEST_ASSERT_FALSE(core.isNight);
+  TEST_ASSERT_TRUE(servos.isAttached);
+  // Шаг цели по умолчанию — 1°: отображение от целого градуса
+  TEST_ASSERT_EQUAL_INT(azimuthToHor(floorf(core.sunAz), 0), core.currentHor);
+  TEST_ASSERT_EQUAL_INT(clampInt(altitudeToVer(floorf(core.sunAlt), 0),
+                                 degToAngle(15), degToAngle(90)),
+                        core.currentVer);
+  TEST_ASSERT_EQUAL_INT(core.currentHor, servos.horFine);
+  TEST_ASSERT_EQUAL_INT(angleToDeg(core.currentVer), core.motion.ver());
+}
+
+void test_night_detach_and_smooth_wake(void) {
+  TrackerCore core(cfg, clk, adc, servos, sun);
+  core.ensureServosAttached();
+  clk.set(SUMMER_NIGHT);
+  core.cycle();
+  settle(core);
+  TEST_ASSERT_TRUE(core.isNight);
+  TEST_ASSERT_FALSE(servos.isAttached);
+
+  // Выход из ночи не блокирует цикл: только публикует цель
+  long writesBefore = servos.writes;
+  uint64_t delayedBefore = clk.delayed;
+  clk.set(SUMMER_NOON);
+  core.cycle();
+  TEST_ASSERT_FALSE(core.isNight);
+  TEST_ASSERT_EQUAL(writesBefore, servos.writes);
+  TEST_ASSERT_EQUAL(0, clk.delayed - delayedBefore);
+
+  // Плавный поворот выполняет задача движения
+  settle(core);
+  TEST_ASSERT_TRUE(servos.isAttached);
+  TEST_ASSERT_GREATER_THAN(10, servos.writes - writesBefore);
+  TEST_ASSERT_EQUAL_INT(core.currentHor, servos.horFine);
+}
+
+void test_live_config_change(void) {
+  TrackerCore core(cfg, clk, adc, servos, sun);
+  core.cycle();
+  int hor = core.currentHor;
+  cfg.hOff = 7;
+  cfg.verMax = 40;
+  core.configChanged();
+  core.cycle();
+  TEST_ASSERT_EQUAL_INT(hor + degToAngle(7), core.currentHor);
+  TEST_ASSERT_EQUAL_INT(degToAngle(40), core.currentVer);
+
+  // Ночью восход пересчитывается для новых координат
+  clk.set(SUMMER_NIGHT);
+  core.cycle();
+  time_t astana = core.sunrise;
+  cfg.lon = 76.9f; // Алматы
+  cfg.lat = 43.25f;
+  core.configChanged();
+  core.cycle();
+  TEST_ASSERT_TRUE(core.isNight);
+  TEST_ASSERT_TRUE(core.sunrise > 0 && labs(astana - core.sunrise) > 600);
+}
+
+void test_no_tracking_without_time(void) {
+  TrackerCore core(cfg, clk, adc, servos, sun);
+  clk.set(50);
+  core.cycle();
+  TEST_ASSERT_EQUAL(0, sun.calls);
+  TEST_ASSERT_EQUAL(0, servos.writes);
+}
+
+void test_demo_sweep_bounces(void) {
+  TrackerCore core(cfg, clk, adc, servos, sun);
+  core.mode = MODE_DEMO;
+  core.startDemo();
+  TEST_ASSERT_EQUAL_INT(100, core.cycleDelayMs());
+  int maxHor = 0;
+  for (int i = 0; i < 90; i++) {
+    core.demoStep();
+    if (core.currentHor > maxHor)
+      maxHor = core.currentHor;
+  }
+  TEST_ASSERT_EQUAL_INT(degToAngle(180), maxHor);
+  TEST_ASSERT_EQUAL_INT(-1, core.demoDirHor);
+  TEST_ASSERT_EQUAL_INT(degToAngle(cfg.verMin), core.currentVer);
+  core.demoHor = 88;
+  core.demoDirHor = 1;
+  core.demoStep();
+  TEST_ASSERT_EQUAL_INT(degToAngle(cfg.verMax), core.currentVer);
+}
+
+void test_next_step_prediction(void) {
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 2.5f, secondsToNextStep(10.75f, 0.1f));
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 7.5f, secondsToNextStep(10.75f, -0.1f));
+  TEST_ASSERT_TRUE(isinf(secondsToNextStep(10.75f, 0)));
+  // Шаг 0.1° и 0.2°: до 10.8 и до 10.6
+  TEST_ASSERT_FLOAT_WITHIN(1e-3f, 0.5f, secondsToNextStep(10.75f, 0.1f, 0.1f));
+  TEST_ASSERT_FLOAT_WITHIN(1e-3f, 1.5f,
+                           secondsToNextStep(10.75f, -0.1f, 0.2f));
+
+  // Днём сон до смены цели, но не дольше предела
+  TrackerCore core(cfg, clk, adc, servos, sun);
+  core.cycle();
+  uint32_t d = core.cycleDelayMs();
+  TEST_ASSERT_TRUE(d >= TRACK_MIN_SLEEP_MS && d <= TRACK_MAX_SLEEP_MS);
+  int hor = core.currentHor, ver = core.currentVer;
+  clk.advance(d / 1000 - 1);
+  core.cycle();
+  TEST_ASSERT_TRUE(hor == core.currentHor && ver == core.currentVer);
+  clk.advance(1);
+  core.cycle();
+  TEST_ASSERT_TRUE(hor != core.currentHor || ver != core.currentVer);
+
+  // Ночью — максимальный сон, в ручном режиме — прежние 2 с
+  clk.set(SUMMER_NIGHT);
+  core.cycle();
+  TEST_ASSERT_EQUAL(TRACK_MAX_SLEEP_MS, core.cycleDelayMs());
+  core.mode = MODE_MANUAL;
+  core.cycle();
+  TEST_ASSERT_EQUAL(TRACK_IDLE_MS, core.cycleDelayMs());
+}
+
+struct DayRun {
+  long wakes;
+  double cpuMs;  // время хоста на все циклы
+  double meanErr; // средняя ошибка цели по осям, градусы
+};
+
+// Сутки с шагом 1 с: цикл вызывается, когда истекла его задержка
+// (fixedMs — старый цикл с постоянным периодом)
+static DayRun runDay(bool aimAhead, uint32_t fixedMs,
+                     int quantum = TRACK_QUANTUM) {
+  clk = FakeClock(SUMMER_NOON - 12 * 3600);
+  TrackerCore core(cfg, clk, adc, servos, sun);
+  core.aimAhead = aimAhead;
+  core.trackQuantum = quantum;
+  NoaaSun ideal;
+  DayRun r = {0, 0, 0};
+  double errSum = 0;
+  long errN = 0;
+  uint64_t wakeAt = clk.ms;
+  for (int s = 0; s < 86400; ++s, clk.advance(1)) {
+    if (clk.ms >= wakeAt) {
+      auto t0 = std::chrono::steady_clock::now();
+      core.cycle();
+      r.cpuMs += std::chrono::duration<double, std::milli>(
+                     std::chrono::steady_clock::now() - t0)
+                     .count();
+      ++r.wakes;
+      wakeAt = clk.ms + (fixedMs ? fixedMs : core.cycleDelayMs());
+    }
+    float az, alt;
+    ideal.position(cfg, clk.now(), az, alt);
+    if (core.isNight || az < 91 || az > 269 || alt < cfg.verMin + 1 ||
+        alt > cfg.verMax - 1)
+      continue; // цель упирается в пределы
+    errSum += fabsf(core.currentHor / (float)ANGLE_SCALE - (az - 90)) +
+              fabsf(core.currentVer / (float)ANGLE_SCALE - alt);
+    errN += 2;
+  }
+  r.meanErr = errSum / errN;
+  return r;
+}
+
+void test_scheduler_day_against_fixed_loop(void) {
+  DayRun fixed = runDay(false, 2000);
+  DayRun sched = runDay(false, 0);
+  DayRun ahead = runDay(true, 0);
+  DayRun fine = runDay(true, 0, ANGLE_SCALE / 10);
+  char msg[128];
+  const DayRun *runs[] = {&fixed, &sched, &ahead, &fine};
+  const char *names[] = {"fixed 2 s", "scheduled", "scheduled+aim",
+                         "aim, 0.1 deg"};
+  for (int i = 0; i < 4; ++i) {
+    snprintf(msg, sizeof(msg), "%-13s: %6ld wakeups/day, %.2f ms CPU/day, "
+             "mean error %.3f deg",
+             names[i], runs[i]->wakes, runs[i]->cpuMs, runs[i]->meanErr);
+    TEST_MESSAGE(msg);
+  }
+  TEST_ASSERT_EQUAL(43200, fixed.wakes);
+  TEST_ASSERT_TRUE(sched.wakes * 10 < fixed.wakes);
+  TEST_ASSERT_TRUE(sched.meanErr < fixed.meanErr + 0.05);
+  TEST_ASSERT_TRUE(ahead.meanErr < 0.35);
+  // Шаг 0.1°: ошибка цели на порядок меньше, пробуждений больше
+  TEST_ASSERT_TRUE(fine.meanErr < 0.05);
+  TEST_ASSERT_TRUE(fine.wakes > ahead.wakes && fine.wakes < fixed.wakes);
+}
+
+// Стоимость одного цикла (виртуальные задержки не учитываются)
+static double benchCycles(TrackerCore &core, int n, uint32_t stepS) {
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < n; i++) {
+    core.cycle();
+    clk.advance(stepS);
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+}
+
+void test_bench_cycle_cost(void) {
+  TrackerCore core(cfg, clk, adc, servos, sun);
+  const int N = 200000;
+  char msg[96];
+
+  double autoNs = benchCycles(core, N, 2);
+  snprintf(msg, sizeof(msg), "auto cycle: %.1f ns/cycle (%ld sun calls)",
+           autoNs, sun.calls);
+  TEST_MESSAGE(msg);
+
+  core.mode = MODE_DEMO;
+  core.startDemo();
+  double demoNs = benchCycles(core, N, 0);
+  snprintf(msg, sizeof(msg), "demo cycle: %.1f ns/cycle", demoNs);
+  TEST_MESSAGE(msg);
+
+  TEST_ASSERT_GREATER_THAN(0, autoNs);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_azimuth_mapping);
+  RUN_TEST(test_voltage_from_pipeline);
+  RUN_TEST(test_auto_tracks_sun);
+  RUN_TEST(test_night_detach_and_smooth_wake);
+  RUN_TEST(test_live_config_change);
+  RUN_TEST(test_no_tracking_without_time);
+  RUN_TEST(test_demo_sweep_bounces);
+  RUN_TEST(test_next_step_prediction);
+  RUN_TEST(test_scheduler_day_against_fixed_loop);
+  RUN_TEST(test_bench_cycle_cost);
+  return UNITY_END();
+}
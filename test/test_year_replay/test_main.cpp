@@ -0,0 +1,107 @@
+// Прогон года на виртуальных часах — регрессионный бенчмарк точности
+// наведения и износа серво: pio test -e native -f test_year_replay
+// Другое место: REPLAY_LAT=43.25 REPLAY_LON=76.9 pio test -e native ...
+#include <unity.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "YearReplay.h"
+
+static const time_t YEAR_2026 = 1767225600; // 2026-01-01 00:00 UTC
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static void report(const char *name, const ReplayReport &r) {
+  const ReplayStats &s = r.total;
+  char msg[200];
+  snprintf(msg, sizeof(msg),
+           "%s: %d days in %.0f ms on %d threads; error mean %.3f max %.2f "
+           "deg (all daylight %.2f)",
+           name, r.days, r.wallMs, r.threads, s.meanErr(), s.errMax,
+           s.meanErrAll());
+  TEST_MESSAGE(msg);
+  snprintf(msg, sizeof(msg),
+           "%s: daylight %.0f h, out of range %.0f h, clamped %.0f h; "
+           "travel %.0f deg, %ld writes, %ld attaches, %ld wakeups",
+           name, s.daylightS / 3600.0, s.outOfRangeS / 3600.0,
+           s.clampedS / 3600.0, s.travelDeg, s.writes, s.attaches,
+           s.wakeups);
+  TEST_MESSAGE(msg);
+}
+
+// Результат не зависит от числа потоков
+void test_reproducible_across_threads(void) {
+  Config cfg = defaultConfig();
+  ReplayReport one = replayYear(cfg, YEAR_2026 + 150 * 86400, 8, 1);
+  ReplayReport many = replayYear(cfg, YEAR_2026 + 150 * 86400, 8, 4);
+  TEST_ASSERT_EQUAL(one.total.writes, many.total.writes);
+  TEST_ASSERT_EQUAL(one.total.wakeups, many.total.wakeups);
+  TEST_ASSERT_TRUE(one.total.travelDeg == many.total.travelDeg);
+  TEST_ASSERT_TRUE(one.total.errSum == many.total.errSum);
+}
+
+// Астана: год — эталон для сравнения изменений отображения и пределов
+void test_year_astana(void) {
+  Config cfg = defaultConfig();
+  ReplayReport r = replayYear(cfg, YEAR_2026);
+  report("Astana", r);
+  const ReplayStats &s = r.total;
+  TEST_ASSERT_EQUAL(365, r.days);
+  TEST_ASSERT_TRUE(s.daylightS > 4300 * 3600 && s.daylightS < 4500 * 3600);
+  TEST_ASSERT_TRUE(s.meanErr() < 0.4);
+  TEST_ASSERT_TRUE(s.errMax < 1.5);
+  TEST_ASSERT_EQUAL(365, s.attaches); // одно утреннее включение в сутки
+  TEST_ASSERT_TRUE(s.outOfRangeS > 0); // летом восход на северо-востоке
+  // Записей в ШИМ — не больше, чем при целых градусах (128 566)
+  TEST_ASSERT_LESS_OR_EQUAL(128566, s.writes);
+}
+
+// Шаг цели 0.1° и узкая зона серво: точнее, ценой пробуждений и записей
+void test_fine_quantum_trades_writes(void) {
+  Config cfg = defaultConfig();
+  ReplayReport base = replayYear(cfg, YEAR_2026 + 160 * 86400, 30);
+  ReplayTuning fine;
+  fine.quantum = ANGLE_SCALE / 10;
+  fine.deadBandUs = 2;
+  ReplayReport r = replayYear(cfg, YEAR_2026 + 160 * 86400, 30, 0, fine);
+  report("1 deg, 11 us", base);
+  report("0.1 deg, 2 us", r);
+  TEST_ASSERT_TRUE(r.total.meanErr() < base.total.meanErr() / 2);
+  TEST_ASSERT_TRUE(r.total.writes > base.total.writes);
+  TEST_ASSERT_TRUE(r.total.wakeups > base.total.wakeups);
+}
+
+// Заниженный verMax: время в упоре растёт, ошибка по всему дню — тоже
+void test_clamp_change_is_visible(void) {
+  Config cfg = defaultConfig();
+  ReplayReport base = replayYear(cfg, YEAR_2026 + 160 * 86400, 10);
+  cfg.verMax = 50;
+  ReplayReport low = replayYear(cfg, YEAR_2026 + 160 * 86400, 10);
+  TEST_ASSERT_TRUE(low.total.clampedS > base.total.clampedS + 10 * 3600);
+  TEST_ASSERT_TRUE(low.total.meanErrAll() > base.total.meanErrAll());
+}
+
+// Место из окружения (REPLAY_LAT, REPLAY_LON) — только отчёт
+void test_year_custom_site(void) {
+  const char *lat = getenv("REPLAY_LAT");
+  const char *lon = getenv("REPLAY_LON");
+  if (!lat || !lon)
+    TEST_IGNORE_MESSAGE("REPLAY_LAT/REPLAY_LON not set");
+  Config cfg = defaultConfig();
+  cfg.lat = atof(lat);
+  cfg.lon = atof(lon);
+  report("custom", replayYear(cfg, YEAR_2026));
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_reproducible_across_threads);
+  RUN_TEST(test_year_astana);
+  RUN_TEST(test_fine_quantum_trades_writes);
+  RUN_TEST(test_clamp_change_is_visible);
+  RUN_TEST(test_year_custom_site);
+  return UNITY_END();
+}
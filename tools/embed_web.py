@@ -0,0 +1,70 @@
+# Сборка веб-интерфейса: web/index.html -> минификация -> gzip -> массив байт
+# в include/index_html.h вместе с ETag (хеш сжатого содержимого).
+#
+# PlatformIO запускает скрипт перед сборкой (extra_scripts = pre:...),
+# вручную: python3 tools/embed_web.py
+import gzip
+import hashlib
+import os
+import re
+
+try:
+    Import("env")  # noqa: F821 — есть только внутри PlatformIO
+    ROOT = env.subst("$PROJECT_DIR")  # noqa: F821
+except NameError:
+    ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+SRC = os.path.join(ROOT, "web", "index.html")
+DST = os.path.join(ROOT, "include", "index_html.h")
+
+
+def minify(html):
+    # Консервативно: переводы строк остаются (JS без точек с запятой),
+    # убираются отступы, пустые строки и комментарии на отдельной строке
+    html = re.sub(r"<!--.*?-->", "", html, flags=re.S)
+    html = re.sub(r"/\*.*?\*/", "", html, flags=re.S)
+    lines = []
+    for line in html.splitlines():
+        line = line.strip()
+        if not line or line.startswith("//"):
+            continue
+        lines.append(line)
+    return "\n".join(lines)
+
+
+def main():
+    with open(SRC, encoding="utf-8") as f:
+        raw = f.read().encode("utf-8")
+    mini = minify(raw.decode("utf-8")).encode("utf-8")
+    # mtime=0 — одинаковый вход даёт одинаковые байты и ETag
+    gz = gzip.compress(mini, compresslevel=9, mtime=0)
+    etag = hashlib.sha1(gz).hexdigest()[:16]
+
+    rows = []
+    for i in range(0, len(gz), 16):
+        rows.append("  " + ", ".join("0x%02x" % b for b in gz[i:i + 16]) + ",")
+    out = (
+        "// Сгенерировано tools/embed_web.py из web/index.html — не править\n"
+        "// исходник %d Б, минифицирован %d Б, gzip %d Б\n"
+        "#pragma once\n"
+        "#include <Arduino.h>\n"
+        "\n"
+        "const char INDEX_HTML_ETAG[] = \"\\\"%s\\\"\";\n"
+        "const size_t INDEX_HTML_GZ_LEN = %d;\n"
+        "const uint8_t INDEX_HTML_GZ[] PROGMEM = {\n"
+        "%s\n"
+        "};\n" % (len(raw), len(mini), len(gz), etag, len(gz), "\n".join(rows))
+    )
+
+    old = None
+    if os.path.exists(DST):
+        with open(DST, encoding="utf-8") as f:
+            old = f.read()
+    if out != old:  # не трогаем файл без изменений — нет лишней пересборки
+        with open(DST, "w", encoding="utf-8") as f:
+            f.write(out)
+    print("index.html: %d -> %d (min) -> %d (gzip) bytes, ETag %s"
+          % (len(raw), len(mini), len(gz), etag))
+
+
+main()
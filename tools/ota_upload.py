@@ -0,0 +1,52 @@
+# Обновление прошивки по сети: POST /api/ota с SHA-256 образа и подписью
+# HMAC-SHA256(ключ, SHA-256) — тот же ключ, что OTA_KEY в сборке.
+#
+# python3 tools/ota_upload.py 192.168.1.50 .pio/build/esp32doit-devkit-v1/firmware.bin
+# ключ — в переменной OTA_KEY или --key
+import argparse
+import hashlib
+import hmac
+import os
+import sys
+import time
+import urllib.error
+import urllib.request
+
+
+def main():
+    ap = argparse.ArgumentParser(description="OTA upload to the tracker")
+    ap.add_argument("host", help="IP or host[:port] of the tracker")
+    ap.add_argument("image", help="firmware.bin")
+    ap.add_argument("--key", default=os.environ.get("OTA_KEY", ""))
+    args = ap.parse_args()
+    if not args.key:
+        sys.exit("нужен ключ: --key или OTA_KEY")
+
+    with open(args.image, "rb") as f:
+        image = f.read()
+    digest = hashlib.sha256(image).digest()
+    signature = hmac.new(args.key.encode(), digest, hashlib.sha256)
+
+    req = urllib.request.Request(
+        "http://%s/api/ota" % args.host,
+        data=image,
+        method="POST",
+        headers={
+            "Content-Type": "application/octet-stream",
+            "X-Firmware-SHA256": digest.hex(),
+            "X-Firmware-Signature": signature.hexdigest(),
+        },
+    )
+    t0 = time.time()
+    try:
+        with urllib.request.urlopen(req, timeout=120) as res:
+            reply = res.read().decode()
+    except urllib.error.HTTPError as e:
+        sys.exit("%d %s" % (e.code, e.read().decode()))
+    dt = time.time() - t0
+    print("%s (%d байт за %.1f с, %.0f КБ/с)" %
+          (reply, len(image), dt, len(image) / 1024 / dt))
+
+
+if __name__ == "__main__":
+    main()